@@ -25,12 +25,14 @@
 #include <flutter/standard_method_codec.h>
 #include <system_info.h>
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <string>
 #include <unordered_set>
 
 #include "common/conversion.h"
+#include "common/metrics.h"
 #include "common/to_string.h"
 #include "common/trace.h"
 #include "common/utils.h"
@@ -198,6 +200,8 @@ class CloudFunctionsPlugin : public flutter::Plugin {
           : result(std::move(_result)), post_task(std::move(_post_task)) {}
       std::unique_ptr<MethodResult<EncodableValue>> result;
       std::function<void()> post_task;
+      std::chrono::steady_clock::time_point start{
+          std::chrono::steady_clock::now()};
     };
 
     TRACE(FUNCTION, "reference.Call");
@@ -217,6 +221,14 @@ class CloudFunctionsPlugin : public flutter::Plugin {
         .OnCompletion(
             [](const Future<HttpsCallableResult>& future, void* data) {
               PointerScope<Param> param(data);
+              Metrics::instance().record(
+                  "functions.call_us",
+                  std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::steady_clock::now() - param->start)
+                      .count());
+              if (future.error() != Error::kErrorNone) {
+                Metrics::instance().increment("functions.call_errors");
+              }
               if (future.status() == FutureStatus::kFutureStatusComplete) {
                 TRACE(FUNCTION, "FutureStatus::kFutureStatusComplete");
                 if (future.error() == Error::kErrorNone) {
@@ -0,0 +1,44 @@
+#!/bin/bash
+set -e
+
+USAGE=$(cat << EOF
+Usage: $(basename "$0") <BUILD_ARCH> [CONFIGURATION]
+
+Description:
+A script to build the firebase_tizen_common library, the runtime shared by all
+FlutterFire plugins (logger, trace, conversion, payload, metrics and app
+events), and to install it into '\$FLUTTER_BUILD_DIR/.firebaseSDK' so that the
+other plugins can link against it. The library is also copied to './lib' to be bundled with the app.
+
+Arguments:
+  BUILD_ARCH     The target architecture. ('armel' or 'i586')
+  CONFIGURATION  The build configuration. (default: Release)
+
+Example:
+  $(basename "$0") armel Debug
+EOF
+)
+
+if [ -z "$1" ] || [ "$1" = "-h" ]; then
+  echo "$USAGE"
+  exit 1
+fi
+
+BUILD_ARCH=$1
+CONFIGURATION=${2:-Release}
+SDK_DIR=${FLUTTER_BUILD_DIR}/.firebaseSDK
+COMMON_DIR=./common
+LIB_NAME=libfirebase_tizen_common.so
+
+case "$BUILD_ARCH" in
+  armel) TIZEN_ARCH=arm ;;
+  i586) TIZEN_ARCH=x86 ;;
+  *) echo "Unsupported architecture: $BUILD_ARCH"; exit 1 ;;
+esac
+
+tizen build-native -a "$TIZEN_ARCH" -C "$CONFIGURATION" -- "$COMMON_DIR"
+
+mkdir -p "${SDK_DIR}"/inc "${SDK_DIR}"/lib/${BUILD_ARCH} ./lib/${BUILD_ARCH}
+cp -vr "${COMMON_DIR}"/include/common "${SDK_DIR}"/inc/
+cp -v "${COMMON_DIR}"/${CONFIGURATION}/${LIB_NAME} "${SDK_DIR}"/lib/${BUILD_ARCH}/
+cp -v "${COMMON_DIR}"/${CONFIGURATION}/${LIB_NAME} ./lib/${BUILD_ARCH}/
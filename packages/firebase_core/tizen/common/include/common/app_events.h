@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2023-present Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBASE_TIZEN_COMMON_APP_EVENTS_H_
+#define FIREBASE_TIZEN_COMMON_APP_EVENTS_H_
+
+#include <firebase/app.h>
+
+#include <functional>
+
+// Lets plugins drop what they hold for an app, such as instances the SDK
+// deletes along with it, before the app is deleted. The SDK itself does not
+// tell other libraries, so firebase_core reports the apps it deletes.
+using AppDeletedListener = std::function<void(firebase::App* app)>;
+
+// |listener| is called on the thread deleting the app, and is never removed.
+void AddAppDeletedListener(AppDeletedListener listener);
+
+// Called by firebase_core right before it deletes |app|.
+void NotifyAppDeleted(firebase::App* app);
+
+#endif  // FIREBASE_TIZEN_COMMON_APP_EVENTS_H_
@@ -14,8 +14,8 @@
  * limitations under the License.
  */
 
-#ifndef FIREBASE_TIZEN_DEP_COMMON_CONVERSION_H_
-#define FIREBASE_TIZEN_DEP_COMMON_CONVERSION_H_
+#ifndef FIREBASE_TIZEN_COMMON_CONVERSION_H_
+#define FIREBASE_TIZEN_COMMON_CONVERSION_H_
 
 #include <firebase/variant.h>
 #include <flutter/encodable_value.h>
@@ -30,4 +30,4 @@ class Conversion {
   static flutter::EncodableValue ToEncodableValue(const firebase::Variant& v);
 };
 
-#endif  // FIREBASE_TIZEN_DEP_COMMON_CONVERSION_H_
+#endif  // FIREBASE_TIZEN_COMMON_CONVERSION_H_
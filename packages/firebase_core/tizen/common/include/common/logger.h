@@ -14,23 +14,54 @@
  * limitations under the License.
  */
 
-#ifndef FIREBASE_TIZEN_DEP_COMMON_LOGGER_H_
-#define FIREBASE_TIZEN_DEP_COMMON_LOGGER_H_
+#ifndef FIREBASE_TIZEN_COMMON_LOGGER_H_
+#define FIREBASE_TIZEN_COMMON_LOGGER_H_
 
+#include <atomic>
 #include <cassert>
-#include <functional>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <sstream>
 #include <string>
 
+// List of log categories. A category passed to the TRACE macros is interned
+// into a bit index at compile time, so checking it costs a single atomic load.
+#define LOG_CATEGORIES(V) \
+  V(GENERAL)              \
+  V(DATABASE)             \
+  V(FB_LISTEN)            \
+  V(FT_STREAM)            \
+  V(FUNCTION)
+
+enum class LogCategory : uint8_t {
+#define V(name) name,
+  LOG_CATEGORIES(V)
+#undef V
+};
+
 class LogOption {
  public:
-  static bool isEnabled(const std::string& pattern = "");
-  static void setExternalIsEnabled(std::function<bool(const std::string&)>);
+  static bool isEnabled(LogCategory category = LogCategory::GENERAL) {
+    return enabledMask_.load(std::memory_order_relaxed) & bit(category);
+  }
+
+  static void setEnabled(LogCategory category, bool enabled);
+  static void setEnabledMask(uint32_t mask);
+  static uint32_t enabledMask();
+
+  // Enables the categories given as a comma-separated list of names (e.g.
+  // "DATABASE,FB_LISTEN") and disables the others. "*" enables all.
+  static void setEnabledCategories(const std::string& names);
+
+  static const char* name(LogCategory category);
 
  private:
-  static std::function<bool(const std::string&)> externalIsEnabled;
+  static constexpr uint32_t bit(LogCategory category) {
+    return 1u << static_cast<uint32_t>(category);
+  }
+
+  static std::atomic<uint32_t> enabledMask_;
 };
 
 class Logger {
@@ -50,9 +81,12 @@ class Logger {
     virtual void flush(std::stringstream& ss) = 0;
   };
 
-  Logger(std::shared_ptr<Output> out = nullptr);
-  Logger(const std::string& header, std::shared_ptr<Output> out = nullptr);
-  Logger(Header&& header, std::shared_ptr<Output> out = nullptr);
+  Logger(std::shared_ptr<Output> out = nullptr,
+         LogCategory category = LogCategory::GENERAL);
+  Logger(const std::string& header, std::shared_ptr<Output> out = nullptr,
+         LogCategory category = LogCategory::GENERAL);
+  Logger(Header&& header, std::shared_ptr<Output> out = nullptr,
+         LogCategory category = LogCategory::GENERAL);
   virtual ~Logger();
 
   template <class T>
@@ -115,12 +149,11 @@ class Logger {
 
   Logger& print(const char* string_without_format_specifiers = "");
   Logger& flush();
-  bool isEnabled(const std::string& pattern = "") {
-    return LogOption::isEnabled(pattern);
-  }
+  bool isEnabled() const { return LogOption::isEnabled(category_); }
 
  protected:
   std::stringstream stream_;
+  LogCategory category_;
   void initialize(std::shared_ptr<Output> out = nullptr);
 
  private:
@@ -159,14 +192,14 @@ void writeThreadIdentifier(std::ostream& ss);
 
 class IndentCounter {
  public:
-  IndentCounter(std::string id);
+  IndentCounter(LogCategory id);
   ~IndentCounter();
-  static std::string getString(std::string id = "");
-  static void indent(std::string id);
-  static void unIndent(std::string id);
+  static std::string getString();
+  static void indent(LogCategory id);
+  static void unIndent(LogCategory id);
 
  private:
-  std::string id_;
+  LogCategory id_;
 };
 
-#endif  // FIREBASE_TIZEN_DEP_COMMON_LOGGER_H_
+#endif  // FIREBASE_TIZEN_COMMON_LOGGER_H_
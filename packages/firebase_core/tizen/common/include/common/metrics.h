@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2023-present Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBASE_TIZEN_COMMON_METRICS_H_
+#define FIREBASE_TIZEN_COMMON_METRICS_H_
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+// A process-wide registry of named counters and value statistics. It lives in
+// the shared runtime library, so every plugin reports into the same instance.
+class Metrics {
+ public:
+  struct Stat {
+    int64_t count{0};
+    int64_t sum{0};
+    int64_t min{0};
+    int64_t max{0};
+  };
+
+  static Metrics& instance();
+
+  // Adds |delta| to the counter |name|.
+  void increment(const std::string& name, int64_t delta = 1);
+
+  // Records one sample of |name|, e.g. a duration or a payload size.
+  void record(const std::string& name, int64_t value);
+
+  Stat get(const std::string& name);
+  std::map<std::string, Stat> snapshot();
+  void reset();
+
+ private:
+  Metrics() = default;
+  Metrics(const Metrics&) = delete;
+  Metrics& operator=(const Metrics&) = delete;
+
+  std::mutex mutex_;
+  std::map<std::string, Stat> stats_;
+};
+
+// Records the lifetime of the scope in microseconds under |name|.
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(const char* name)
+      : name_(name), start_(std::chrono::steady_clock::now()) {}
+  ~ScopedTimer() {
+    Metrics::instance().record(
+        name_, std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now() - start_)
+                   .count());
+  }
+
+ private:
+  const char* name_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+#endif  // FIREBASE_TIZEN_COMMON_METRICS_H_
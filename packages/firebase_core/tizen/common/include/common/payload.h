@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2023-present Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBASE_TIZEN_COMMON_PAYLOAD_H_
+#define FIREBASE_TIZEN_COMMON_PAYLOAD_H_
+
+#include <firebase/variant.h>
+#include <flutter/byte_streams.h>
+#include <flutter/encodable_value.h>
+#include <flutter/standard_codec_serializer.h>
+#include <flutter/standard_method_codec.h>
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+// Writes values in the standard message codec format straight into the
+// stream of the message being encoded, so that hot payloads skip building an
+// intermediate EncodableValue tree. Maps and lists are written as a header
+// with the number of entries followed by the entries themselves.
+class PayloadWriter {
+ public:
+  explicit PayloadWriter(flutter::ByteStreamWriter* stream);
+
+  void WriteNull();
+  void WriteBool(bool value);
+  void WriteInt32(int32_t value);
+  void WriteInt64(int64_t value);
+  void WriteDouble(double value);
+  void WriteString(std::string_view value);
+  void WriteUint8List(const uint8_t* data, size_t size);
+  void WriteList(size_t size);
+  void WriteMap(size_t size);
+  void WriteValue(const flutter::EncodableValue& value);
+
+  // Writes |value| the way Conversion::ToEncodableValue converts it.
+  void WriteVariant(const firebase::Variant& value);
+
+  // Writes a map key followed by the value.
+  template <typename T>
+  void WriteEntry(std::string_view key, const T& value) {
+    WriteString(key);
+    Write(value);
+  }
+
+ private:
+  void WriteSize(size_t size);
+
+  void Write(bool value) { WriteBool(value); }
+  void Write(int32_t value) { WriteInt32(value); }
+  void Write(int64_t value) { WriteInt64(value); }
+  void Write(double value) { WriteDouble(value); }
+  void Write(std::string_view value) { WriteString(value); }
+  void Write(const std::string& value) { WriteString(value); }
+  void Write(const char* value) { WriteString(value); }
+  void Write(const flutter::EncodableValue& value) { WriteValue(value); }
+  void Write(const firebase::Variant& value) { WriteVariant(value); }
+
+  flutter::ByteStreamWriter* stream_;
+};
+
+using PayloadWriteFunction = std::function<void(PayloadWriter& writer)>;
+
+// Returns a value that is serialized by calling |write| when it is encoded by
+// a channel using GetPayloadMethodCodec(). |write| must write exactly one
+// value. Channels encode synchronously, so |write| may refer to data that
+// outlives the call sending the value, e.g. a listener argument.
+flutter::EncodableValue MakePayload(PayloadWriteFunction write);
+
+// A serializer that writes payloads made by MakePayload() and otherwise
+// behaves like the standard one.
+class PayloadCodecSerializer : public flutter::StandardCodecSerializer {
+ public:
+  static const PayloadCodecSerializer& GetInstance();
+
+  void WriteValue(const flutter::EncodableValue& value,
+                  flutter::ByteStreamWriter* stream) const override;
+
+ private:
+  PayloadCodecSerializer() = default;
+};
+
+// The standard method codec with PayloadCodecSerializer. Its messages are
+// identical to the standard codec's, so the Dart side needs no changes.
+const flutter::StandardMethodCodec& GetPayloadMethodCodec();
+
+#endif  // FIREBASE_TIZEN_COMMON_PAYLOAD_H_
@@ -14,12 +14,13 @@
  * limitations under the License.
  */
 
-#ifndef FIREBASE_TIZEN_DEP_COMMON_TO_STRING_H_
-#define FIREBASE_TIZEN_DEP_COMMON_TO_STRING_H_
+#ifndef FIREBASE_TIZEN_COMMON_TO_STRING_H_
+#define FIREBASE_TIZEN_COMMON_TO_STRING_H_
 
 #include <firebase/variant.h>
 #include <flutter/encodable_value.h>
 
+#include <limits>
 #include <sstream>
 
 std::ostream& operator<<(std::ostream& os, const firebase::Variant& v);
@@ -29,6 +30,7 @@ std::ostream& operator<<(std::ostream& os, const flutter::EncodableValue& v);
 #include <firebase/database/data_snapshot.h>
 #include <firebase/database/mutable_data.h>
 
+// Defined in the firebase_database plugin, which is the only user of them.
 std::ostream& operator<<(std::ostream& os,
                          const firebase::database::DataSnapshot& d);
 std::ostream& operator<<(std::ostream& os,
@@ -72,4 +74,4 @@ std::string ToString(const T& value) {
   return ss.str();
 }
 
-#endif  // FIREBASE_TIZEN_DEP_COMMON_TO_STRING_H_
+#endif  // FIREBASE_TIZEN_COMMON_TO_STRING_H_
@@ -14,21 +14,21 @@
  * limitations under the License.
  */
 
-#ifndef FIREBASE_TIZEN_DEP_COMMON_TRACE_H_
-#define FIREBASE_TIZEN_DEP_COMMON_TRACE_H_
+#ifndef FIREBASE_TIZEN_COMMON_TRACE_H_
+#define FIREBASE_TIZEN_COMMON_TRACE_H_
 
 #include "logger.h"
 
 class Trace : public Logger {
  public:
-  Trace(std::string id);
-  Trace(std::string id, const char* functionName, const char* filename,
+  Trace(LogCategory id);
+  Trace(LogCategory id, const char* functionName, const char* filename,
         const int line);
   template <typename T, typename... TArgs>
-  Trace(std::string id, const char* functionName, const char* filename,
+  Trace(LogCategory id, const char* functionName, const char* filename,
         const int line, const T& v, TArgs... args)
       : Trace(id, functionName, filename, line) {
-    if (!isEnabled(id)) {
+    if (!isEnabled()) {
       return;
     }
     stream_ << v << " ";
@@ -56,25 +56,27 @@ class Trace : public Logger {
 
 #else
 
-#define TRACE(id, ...) \
-  Trace(#id, __PRETTY_FUNCTION__, __FILE_NAME__, __LINE__).log(__VA_ARGS__)
+#define TRACE(id, ...)                                                 \
+  Trace(LogCategory::id, __PRETTY_FUNCTION__, __FILE_NAME__, __LINE__) \
+      .log(__VA_ARGS__)
 
-#define TRACE0(id, ...) Trace(#id).log(__VA_ARGS__)
+#define TRACE0(id, ...) Trace(LogCategory::id).log(__VA_ARGS__)
 
-#define TRACEF(id, ...) \
-  Trace(#id, __PRETTY_FUNCTION__, __FILE_NAME__, __LINE__).print(__VA_ARGS__)
+#define TRACEF(id, ...)                                                \
+  Trace(LogCategory::id, __PRETTY_FUNCTION__, __FILE_NAME__, __LINE__) \
+      .print(__VA_ARGS__)
 
-#define TRACEF0(id, ...) Trace(#id).print(__VA_ARGS__)
+#define TRACEF0(id, ...) Trace(LogCategory::id).print(__VA_ARGS__)
 
-#define TRACE_SCOPE(id, ...)    \
-  IndentCounter __counter(#id); \
+#define TRACE_SCOPE(id, ...)                \
+  IndentCounter __counter(LogCategory::id); \
   TRACE(id, __VA_ARGS__)
 
-#define TRACE_SCOPE0(id, ...)                                       \
-  IndentCounter __counter(#id);                                     \
-  TRACE(id, __VA_ARGS__);                                           \
-  Trace __outter(#id, __PRETTY_FUNCTION__, __FILE_NAME__, __LINE__, \
-                 "/" __VA_ARGS__)
+#define TRACE_SCOPE0(id, ...)                                         \
+  IndentCounter __counter(LogCategory::id);                           \
+  TRACE(id, __VA_ARGS__);                                             \
+  Trace __outter(LogCategory::id, __PRETTY_FUNCTION__, __FILE_NAME__, \
+                 __LINE__, "/" __VA_ARGS__)
 
 #endif
 
@@ -103,4 +105,4 @@ void Trace_Fatal(const char* functionName, const char* filename, const int line,
 #define CHECK_NOT_NULL(val) CHECK((val) != nullptr)
 #define UNIMPLEMENTED(...) CHECK_WITH_MSG(false, "[UNIMPLEMENTED] " __VA_ARGS__)
 
-#endif  // FIREBASE_TIZEN_DEP_COMMON_TRACE_H_
+#endif  // FIREBASE_TIZEN_COMMON_TRACE_H_
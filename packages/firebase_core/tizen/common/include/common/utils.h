@@ -14,8 +14,8 @@
  * limitations under the License.
  */
 
-#ifndef FIREBASE_TIZEN_DEP_COMMON_UTILS_H_
-#define FIREBASE_TIZEN_DEP_COMMON_UTILS_H_
+#ifndef FIREBASE_TIZEN_COMMON_UTILS_H_
+#define FIREBASE_TIZEN_COMMON_UTILS_H_
 
 #include <flutter/encodable_value.h>
 
@@ -73,4 +73,4 @@ Optional<T> GetOptionalValue(const flutter::EncodableMap* map,
 flutter::EncodableValue GetEncodableValue(const flutter::EncodableMap* map,
                                           const char* key);
 
-#endif  // FIREBASE_TIZEN_DEP_COMMON_UTILS_H_
+#endif  // FIREBASE_TIZEN_COMMON_UTILS_H_
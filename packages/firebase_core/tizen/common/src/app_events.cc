@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2023-present Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/app_events.h"
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct AppDeletedListeners {
+  std::mutex mutex;
+  std::vector<AppDeletedListener> listeners;
+};
+
+AppDeletedListeners& GetAppDeletedListeners() {
+  static AppDeletedListeners instance;
+  return instance;
+}
+
+}  // namespace
+
+void AddAppDeletedListener(AppDeletedListener listener) {
+  auto& instance = GetAppDeletedListeners();
+  std::lock_guard<std::mutex> lock(instance.mutex);
+  instance.listeners.push_back(std::move(listener));
+}
+
+void NotifyAppDeleted(firebase::App* app) {
+  auto& instance = GetAppDeletedListeners();
+  std::vector<AppDeletedListener> listeners;
+  {
+    std::lock_guard<std::mutex> lock(instance.mutex);
+    listeners = instance.listeners;
+  }
+  // Unlocked, so that listeners may take locks of their own.
+  for (const auto& listener : listeners) {
+    listener(app);
+  }
+}
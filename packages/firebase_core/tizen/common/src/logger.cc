@@ -13,7 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include "include/common/logger.h"
+#include "common/logger.h"
 
 #include <map>
 #include <regex>
@@ -64,20 +64,58 @@ void writeThreadIdentifier(std::ostream& os) {
   os << "[" << thisThreadId << "] ";
 }
 
-std::function<bool(const std::string&)> LogOption::externalIsEnabled;
+// --- LogOption ---
+
+std::atomic<uint32_t> LogOption::enabledMask_{0};
 
-void LogOption::setExternalIsEnabled(
-    std::function<bool(const std::string&)> func) {
-  externalIsEnabled = func;
+void LogOption::setEnabled(LogCategory category, bool enabled) {
+  if (enabled) {
+    enabledMask_.fetch_or(bit(category), std::memory_order_relaxed);
+  } else {
+    enabledMask_.fetch_and(~bit(category), std::memory_order_relaxed);
+  }
 }
 
-// --- LogOption ---
+void LogOption::setEnabledMask(uint32_t mask) {
+  enabledMask_.store(mask, std::memory_order_relaxed);
+}
+
+uint32_t LogOption::enabledMask() {
+  return enabledMask_.load(std::memory_order_relaxed);
+}
+
+void LogOption::setEnabledCategories(const std::string& names) {
+  static const std::map<std::string, LogCategory> categories = {
+#define V(name) {#name, LogCategory::name},
+      LOG_CATEGORIES(V)
+#undef V
+  };
 
-bool LogOption::isEnabled(const std::string& pattern) {
-  if (externalIsEnabled == nullptr) {
-    return false;
+  uint32_t mask = 0;
+  std::stringstream ss(names);
+  std::string name;
+  while (std::getline(ss, name, ',')) {
+    if (name == "*") {
+      mask = ~0u;
+      break;
+    }
+    const auto& it = categories.find(name);
+    if (it != categories.end()) {
+      mask |= bit(it->second);
+    }
+  }
+  setEnabledMask(mask);
+}
+
+const char* LogOption::name(LogCategory category) {
+  switch (category) {
+#define V(name)            \
+  case LogCategory::name: \
+    return #name;
+    LOG_CATEGORIES(V)
+#undef V
   }
-  return externalIsEnabled(pattern);
+  return "";
 }
 
 // --- Logger::Header ---
@@ -89,15 +127,21 @@ void Logger::Header::write(std::stringstream& stream) {
 
 // --- Logger ---
 
-Logger::Logger(std::shared_ptr<Output> out) { initialize(out); }
+Logger::Logger(std::shared_ptr<Output> out, LogCategory category)
+    : category_(category) {
+  initialize(out);
+}
 
-Logger::Logger(const std::string& header, std::shared_ptr<Output> out)
-    : output_(out) {
+Logger::Logger(const std::string& header, std::shared_ptr<Output> out,
+               LogCategory category)
+    : category_(category), output_(out) {
   initialize(output_);
   stream_ << header;
 }
 
-Logger::Logger(Header&& header, std::shared_ptr<Output> out) : output_(out) {
+Logger::Logger(Header&& header, std::shared_ptr<Output> out,
+               LogCategory category)
+    : category_(category), output_(out) {
   initialize(output_);
   header.write(stream_);
 }
@@ -125,7 +169,7 @@ void Logger::initialize(std::shared_ptr<Output> out) {
 }
 
 Logger& Logger::print(const char* string_without_format_specifiers) {
-  if (output_ == nullptr) {
+  if (!isEnabled() || output_ == nullptr) {
     return *this;
   }
 
@@ -155,23 +199,21 @@ void StdOut::flush(std::stringstream& stream) { std::cout << stream.str(); }
 thread_local int indentCount = 0;
 thread_local int deltaCount = 0;
 
-void IndentCounter::indent(std::string id) {
+void IndentCounter::indent(LogCategory id) {
   if (!LogOption::isEnabled(id)) {
     return;
   }
   deltaCount++;
 }
 
-void IndentCounter::unIndent(std::string id) {
+void IndentCounter::unIndent(LogCategory id) {
   if (!LogOption::isEnabled(id)) {
     return;
   }
   deltaCount--;
 }
 
-IndentCounter::IndentCounter(std::string id) {
-  id_ = id;
-
+IndentCounter::IndentCounter(LogCategory id) : id_(id) {
   if (!LogOption::isEnabled(id)) {
     return;
   }
@@ -185,7 +227,7 @@ IndentCounter::~IndentCounter() {
   indentCount--;
 }
 
-std::string IndentCounter::getString(std::string id) {
+std::string IndentCounter::getString() {
   assert(indentCount >= 0);
 
   std::ostringstream oss;
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2023-present Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/metrics.h"
+
+#include <algorithm>
+
+Metrics& Metrics::instance() {
+  static Metrics metrics;
+  return metrics;
+}
+
+void Metrics::increment(const std::string& name, int64_t delta) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Stat& stat = stats_[name];
+  stat.count++;
+  stat.sum += delta;
+}
+
+void Metrics::record(const std::string& name, int64_t value) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Stat& stat = stats_[name];
+  stat.min = stat.count == 0 ? value : std::min(stat.min, value);
+  stat.max = stat.count == 0 ? value : std::max(stat.max, value);
+  stat.count++;
+  stat.sum += value;
+}
+
+Metrics::Stat Metrics::get(const std::string& name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto& it = stats_.find(name);
+  if (it == stats_.end()) {
+    return Stat();
+  }
+  return it->second;
+}
+
+std::map<std::string, Metrics::Stat> Metrics::snapshot() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void Metrics::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.clear();
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2023-present Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/payload.h"
+
+#include <any>
+#include <typeinfo>
+#include <utility>
+
+#include "common/trace.h"  // for FATAL
+
+using firebase::Variant;
+using flutter::ByteStreamWriter;
+using flutter::CustomEncodableValue;
+using flutter::EncodableValue;
+
+namespace {
+
+// The type tags of the standard message codec.
+enum class EncodedType : uint8_t {
+  kNull = 0,
+  kTrue = 1,
+  kFalse = 2,
+  kInt32 = 3,
+  kInt64 = 4,
+  kFloat64 = 6,
+  kString = 7,
+  kUInt8List = 8,
+  kList = 12,
+  kMap = 13,
+};
+
+struct Payload {
+  PayloadWriteFunction write;
+};
+
+}  // namespace
+
+PayloadWriter::PayloadWriter(ByteStreamWriter* stream) : stream_(stream) {}
+
+void PayloadWriter::WriteNull() {
+  stream_->WriteByte(static_cast<uint8_t>(EncodedType::kNull));
+}
+
+void PayloadWriter::WriteBool(bool value) {
+  stream_->WriteByte(static_cast<uint8_t>(value ? EncodedType::kTrue
+                                                : EncodedType::kFalse));
+}
+
+void PayloadWriter::WriteInt32(int32_t value) {
+  stream_->WriteByte(static_cast<uint8_t>(EncodedType::kInt32));
+  stream_->WriteInt32(value);
+}
+
+void PayloadWriter::WriteInt64(int64_t value) {
+  stream_->WriteByte(static_cast<uint8_t>(EncodedType::kInt64));
+  stream_->WriteInt64(value);
+}
+
+void PayloadWriter::WriteDouble(double value) {
+  stream_->WriteByte(static_cast<uint8_t>(EncodedType::kFloat64));
+  stream_->WriteAlignment(8);
+  stream_->WriteDouble(value);
+}
+
+void PayloadWriter::WriteString(std::string_view value) {
+  stream_->WriteByte(static_cast<uint8_t>(EncodedType::kString));
+  WriteSize(value.size());
+  if (!value.empty()) {
+    stream_->WriteBytes(reinterpret_cast<const uint8_t*>(value.data()),
+                        value.size());
+  }
+}
+
+void PayloadWriter::WriteUint8List(const uint8_t* data, size_t size) {
+  stream_->WriteByte(static_cast<uint8_t>(EncodedType::kUInt8List));
+  WriteSize(size);
+  if (size) {
+    stream_->WriteBytes(data, size);
+  }
+}
+
+void PayloadWriter::WriteList(size_t size) {
+  stream_->WriteByte(static_cast<uint8_t>(EncodedType::kList));
+  WriteSize(size);
+}
+
+void PayloadWriter::WriteMap(size_t size) {
+  stream_->WriteByte(static_cast<uint8_t>(EncodedType::kMap));
+  WriteSize(size);
+}
+
+void PayloadWriter::WriteValue(const EncodableValue& value) {
+  PayloadCodecSerializer::GetInstance().WriteValue(value, stream_);
+}
+
+void PayloadWriter::WriteVariant(const Variant& value) {
+  switch (value.type()) {
+    case Variant::kTypeNull:
+      WriteNull();
+      break;
+    case Variant::kTypeInt64:
+      WriteInt64(value.int64_value());
+      break;
+    case Variant::kTypeDouble:
+      WriteDouble(value.double_value());
+      break;
+    case Variant::kTypeBool:
+      WriteBool(value.bool_value());
+      break;
+    case Variant::kTypeStaticString:
+      WriteString(value.string_value());
+      break;
+    case Variant::kTypeMutableString:
+      WriteString(value.mutable_string());
+      break;
+    case Variant::kTypeVector:
+      WriteList(value.vector().size());
+      for (const auto& element : value.vector()) {
+        WriteVariant(element);
+      }
+      break;
+    case Variant::kTypeMap:
+      WriteMap(value.map().size());
+      for (const auto& [key, element] : value.map()) {
+        WriteVariant(key);
+        WriteVariant(element);
+      }
+      break;
+    default:
+      FATAL("Unsupported Variant type");
+  }
+}
+
+// Same as StandardCodecSerializer::WriteSize, which is not accessible here.
+void PayloadWriter::WriteSize(size_t size) {
+  if (size < 254) {
+    stream_->WriteByte(static_cast<uint8_t>(size));
+  } else if (size <= 0xffff) {
+    stream_->WriteByte(254);
+    uint16_t value = static_cast<uint16_t>(size);
+    stream_->WriteBytes(reinterpret_cast<const uint8_t*>(&value), 2);
+  } else {
+    stream_->WriteByte(255);
+    uint32_t value = static_cast<uint32_t>(size);
+    stream_->WriteBytes(reinterpret_cast<const uint8_t*>(&value), 4);
+  }
+}
+
+EncodableValue MakePayload(PayloadWriteFunction write) {
+  return EncodableValue(CustomEncodableValue(Payload{std::move(write)}));
+}
+
+const PayloadCodecSerializer& PayloadCodecSerializer::GetInstance() {
+  static PayloadCodecSerializer instance;
+  return instance;
+}
+
+void PayloadCodecSerializer::WriteValue(const EncodableValue& value,
+                                        ByteStreamWriter* stream) const {
+  if (const auto* custom = std::get_if<CustomEncodableValue>(&value)) {
+    if (custom->type() == typeid(Payload)) {
+      PayloadWriter writer(stream);
+      std::any_cast<const Payload&>(*custom).write(writer);
+      return;
+    }
+  }
+  StandardCodecSerializer::WriteValue(value, stream);
+}
+
+const flutter::StandardMethodCodec& GetPayloadMethodCodec() {
+  return flutter::StandardMethodCodec::GetInstance(
+      &PayloadCodecSerializer::GetInstance());
+}
@@ -14,7 +14,7 @@
  * limitations under the License.
  */
 
-#include "include/common/to_string.h"
+#include "common/to_string.h"
 
 using firebase::Variant;
 using flutter::EncodableList;
@@ -106,54 +106,3 @@ std::ostream& operator<<(std::ostream& os, const EncodableValue& v) {
   }
   return os;
 }
-
-#ifdef FIREBASE_DATABASE
-
-using firebase::database::DataSnapshot;
-using firebase::database::MutableData;
-
-std::ostream& operator<<(std::ostream& os, const DataSnapshot& snapshot) {
-  static thread_local std::string indent;
-
-  os << indent << "{\n";
-  indent += "  ";
-
-  os << indent << "key: " << snapshot.key_string() << ", \n"
-     << indent << "value: " << snapshot.value() << ", \n"
-     << indent << "priority: " << snapshot.priority() << ", \n"
-     << indent << "children_count: " << snapshot.children_count() << ", \n";
-
-  for (const auto& s : snapshot.children()) {
-    os << s;
-  }
-
-  indent = indent.substr(0, indent.length() - 2);
-  os << indent << "},\n";
-  return os;
-}
-
-std::ostream& operator<<(std::ostream& os, const MutableData& data) {
-  static thread_local std::string indent;
-
-  os << indent << "{\n";
-  indent += "  ";
-
-  // Functions like children_count() or priority() is not marked as const. This
-  // seems to be a firebase mistake. So we convert it to a const reference.
-  MutableData& mutable_data = const_cast<MutableData&>(data);
-
-  os << indent << "key: " << mutable_data.key_string() << ", \n"
-     << indent << "value: " << mutable_data.value() << ", \n"
-     << indent << "priority: " << mutable_data.priority() << ", \n"
-     << indent << "children_count: " << mutable_data.children_count() << ", \n";
-
-  for (auto& d : mutable_data.children()) {
-    os << d;
-  }
-
-  indent = indent.substr(0, indent.length() - 2);
-  os << indent << "},\n";
-  return os;
-}
-
-#endif  // FIREBASE_DATABASE
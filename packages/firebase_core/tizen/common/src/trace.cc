@@ -90,29 +90,30 @@ class CustomOutput : public StdOut::Output {
 #endif
 
 static void writeHeader(std::ostream& ss, const std::string& tag,
-                        const std::string& id) {
+                        LogCategory id) {
   ss << COLOR_DIM;
   ss << std::left << std::setfill(' ') << "("
      << std::setw(TRACE_ID_LENGTH_LIMIT)
-     << std::string(id).substr(0, TRACE_ID_LENGTH_LIMIT) << ") ";
+     << std::string(LogOption::name(id)).substr(0, TRACE_ID_LENGTH_LIMIT)
+     << ") ";
 }
 
-Trace::Trace(std::string id, const char* functionName, const char* filename,
+Trace::Trace(LogCategory id, const char* functionName, const char* filename,
              const int line)
-    : Logger(CustomOutput::instance()) {
-  if (!isEnabled(id)) {
+    : Logger(CustomOutput::instance(), id) {
+  if (!isEnabled()) {
     return;
   }
 
   writeHeader(stream_, Option::tag(), id);
-  stream_ << IndentCounter::getString(id)
+  stream_ << IndentCounter::getString()
           << createCodeLocation(functionName, filename, line,
                                 LOG_PREFIX_PATTERN)
           << " " << COLOR_RESET;
 }
 
-Trace::Trace(std::string id) : Logger(CustomOutput::instance()) {
-  if (!isEnabled(id)) {
+Trace::Trace(LogCategory id) : Logger(CustomOutput::instance(), id) {
+  if (!isEnabled()) {
     return;
   }
 
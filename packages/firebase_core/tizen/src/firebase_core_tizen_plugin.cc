@@ -8,11 +8,13 @@
 #include <firebase/log.h>
 #include <flutter/plugin_registrar.h>
 
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <string>
 
+#include "common/app_events.h"
 #include "log.h"
 #include "messages.g.h"
 
@@ -180,6 +182,7 @@ void FirebaseCoreTizenPlugin::Delete(
     std::function<void(std::optional<FlutterError> reply)> result) {
   firebase::App* app = firebase::App::GetInstance(app_name.c_str());
   if (app) {
+    NotifyAppDeleted(app);
     delete app;
   }
 
@@ -2,6 +2,7 @@
 #define __LOG_H__
 
 #include <dlog.h>
+#include <string.h>
 
 #ifdef LOG_TAG
 #undef LOG_TAG
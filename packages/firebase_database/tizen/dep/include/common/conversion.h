@@ -1,33 +0,0 @@
-/*
- * Copyright (c) 2023-present Samsung Electronics Co., Ltd
- *
- * Licensed under the Apache License, Version 2.0 (the "License");
- * you may not use this file except in compliance with the License.
- * You may obtain a copy of the License at
- *
- *     http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
-
-#ifndef FIREBASE_TIZEN_DEP_COMMON_CONVERSION_H_
-#define FIREBASE_TIZEN_DEP_COMMON_CONVERSION_H_
-
-#include <firebase/variant.h>
-#include <flutter/encodable_value.h>
-
-class Conversion {
- public:
-  static firebase::Variant ToFirebaseVariant(const flutter::EncodableValue& v);
-  static firebase::Variant ToFirebaseVariant(const flutter::EncodableList& l);
-  static firebase::Variant ToFirebaseVariant(const flutter::EncodableMap& m);
-  static firebase::Variant ToFirebaseVariant(const flutter::EncodableMap* m,
-                                             const char* key);
-  static flutter::EncodableValue ToEncodableValue(const firebase::Variant& v);
-};
-
-#endif  // FIREBASE_TIZEN_DEP_COMMON_CONVERSION_H_
@@ -1,203 +0,0 @@
-/*
- * Copyright (c) 2023-present Samsung Electronics Co., Ltd
- *
- * Licensed under the Apache License, Version 2.0 (the "License");
- * you may not use this file except in compliance with the License.
- * You may obtain a copy of the License at
- *
- *     http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
-#include "include/common/logger.h"
-
-#include <map>
-#include <regex>
-#include <set>
-#include <thread>
-
-// --- Formatter ---
-
-std::string getPrettyFunctionName(const std::string& fullname,
-                                  std::string prefixPattern) {
-  std::stringstream ss;
-  if (!prefixPattern.empty()) {
-    ss << "(?:" << prefixPattern << ")|";
-  }
-  ss << R"((?::\()|([\w:~]+)\()";
-
-  try {
-    std::smatch match;
-    const std::regex re(ss.str());
-
-    std::stringstream result;
-    std::string suffix = fullname;
-    while (std::regex_search(suffix, match, re)) {
-      result << match[1];
-      suffix = match.suffix();
-    }
-    return result.str();
-  } catch (std::regex_error& e) {
-    return "";
-  }
-}
-
-std::string createCodeLocation(const char* functionName, const char* filename,
-                               const int line, std::string prefixPattern) {
-  std::ostringstream oss;
-  oss << getPrettyFunctionName(functionName, prefixPattern) << " (" << filename
-      << ":" << line << ")";
-  return oss.str();
-}
-
-void writeThreadIdentifier(std::ostream& os) {
-  static int id = 0;
-  static thread_local int thisThreadId = 0;
-
-  if (thisThreadId == 0) {
-    thisThreadId = ++id;
-  }
-  os << "[" << thisThreadId << "] ";
-}
-
-std::function<bool(const std::string&)> LogOption::externalIsEnabled;
-
-void LogOption::setExternalIsEnabled(
-    std::function<bool(const std::string&)> func) {
-  externalIsEnabled = func;
-}
-
-// --- LogOption ---
-
-bool LogOption::isEnabled(const std::string& pattern) {
-  if (externalIsEnabled == nullptr) {
-    return false;
-  }
-  return externalIsEnabled(pattern);
-}
-
-// --- Logger::Header ---
-
-void Logger::Header::write(std::stringstream& stream) {
-  writeThreadIdentifier(stream);
-  writeHeader(stream);
-}
-
-// --- Logger ---
-
-Logger::Logger(std::shared_ptr<Output> out) { initialize(out); }
-
-Logger::Logger(const std::string& header, std::shared_ptr<Output> out)
-    : output_(out) {
-  initialize(output_);
-  stream_ << header;
-}
-
-Logger::Logger(Header&& header, std::shared_ptr<Output> out) : output_(out) {
-  initialize(output_);
-  header.write(stream_);
-}
-
-Logger::~Logger() {
-  if (!isEnabled() || output_ == nullptr) {
-    return;
-  }
-  // stream ends with both reset-styles and endl characters.
-  stream_ << "\033[0m" << std::endl;
-  output_->flush(stream_);
-}
-
-void Logger::initialize(std::shared_ptr<Output> out) {
-  static thread_local std::shared_ptr<StdOut> loggerOutput;
-
-  if (out == nullptr) {
-    if (loggerOutput == nullptr) {
-      loggerOutput = std::make_shared<StdOut>();
-    }
-    output_ = loggerOutput;
-  } else {
-    output_ = out;
-  }
-}
-
-Logger& Logger::print(const char* string_without_format_specifiers) {
-  if (output_ == nullptr) {
-    return *this;
-  }
-
-  while (*string_without_format_specifiers) {
-    if (*string_without_format_specifiers == '%' &&
-        *(++string_without_format_specifiers) != '%') {
-      assert(((void)"runtime error: invalid format-string", false));
-    }
-    stream_ << *string_without_format_specifiers++;
-  }
-  return *this;
-}
-
-Logger& Logger::flush() {
-  if (isEnabled() && output_) {
-    output_->flush(stream_);
-  }
-  stream_.str("");
-  return *this;
-}
-// --- Output ---
-
-void StdOut::flush(std::stringstream& stream) { std::cout << stream.str(); }
-
-// --- Utils ---
-
-thread_local int indentCount = 0;
-thread_local int deltaCount = 0;
-
-void IndentCounter::indent(std::string id) {
-  if (!LogOption::isEnabled(id)) {
-    return;
-  }
-  deltaCount++;
-}
-
-void IndentCounter::unIndent(std::string id) {
-  if (!LogOption::isEnabled(id)) {
-    return;
-  }
-  deltaCount--;
-}
-
-IndentCounter::IndentCounter(std::string id) {
-  id_ = id;
-
-  if (!LogOption::isEnabled(id)) {
-    return;
-  }
-  indentCount++;
-}
-
-IndentCounter::~IndentCounter() {
-  if (!LogOption::isEnabled(id_)) {
-    return;
-  }
-  indentCount--;
-}
-
-std::string IndentCounter::getString(std::string id) {
-  assert(indentCount >= 0);
-
-  std::ostringstream oss;
-  int count = indentCount + deltaCount;
-
-  if (deltaCount > 0) {
-    oss << deltaCount << " ";
-  }
-
-  for (int i = 1; i < std::min(30, count); ++i) {
-    oss << "  ";
-  }
-
-  return oss.str();
-}
@@ -1,29 +0,0 @@
-/*
- * Copyright (c) 2023-present Samsung Electronics Co., Ltd
- *
- * Licensed under the Apache License, Version 2.0 (the "License");
- * you may not use this file except in compliance with the License.
- * You may obtain a copy of the License at
- *
- *     http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
-
-#include "common/utils.h"
-
-using flutter::EncodableMap;
-using flutter::EncodableValue;
-
-EncodableValue GetEncodableValue(const EncodableMap* map, const char* key) {
-  const auto& iter = map->find(EncodableValue(key));
-  if (iter != map->end()) {
-    return iter->second;
-  }
-  // EncodableMap has no key.
-  return EncodableValue();
-}
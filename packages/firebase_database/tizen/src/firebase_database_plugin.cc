@@ -35,6 +35,7 @@
 #include <variant>
 
 #include "common/conversion.h"
+#include "common/payload.h"
 #include "common/to_string.h"
 #include "common/trace.h"
 #include "common/utils.h"
@@ -75,8 +76,7 @@ class FirebaseDatabaseTizenPlugin : public flutter::Plugin {
     auto plugin = std::make_unique<FirebaseDatabaseTizenPlugin>();
 
     plugin->channel_ = std::make_unique<MethodChannel<EncodableValue>>(
-        registrar->messenger(), kMethodChannelName,
-        &flutter::StandardMethodCodec::GetInstance());
+        registrar->messenger(), kMethodChannelName, &GetPayloadMethodCodec());
 
     plugin->binary_messenger_ = registrar->messenger();
 
@@ -153,8 +153,7 @@ class FirebaseDatabaseTizenPlugin : public flutter::Plugin {
                             future.error_message());
       } else if constexpr (std::is_same_v<T, DataSnapshot>) {
         future.error() == Error::kErrorNone
-            ? result->Success(
-                  EncodableValue(CreateDataSnapshotPayload(future.result())))
+            ? result->Success(MakeDataSnapshotPayload(future.result()))
             : result->Error(std::to_string(future.error()),
                             future.error_message());
       }
@@ -624,8 +623,7 @@ class FirebaseDatabaseTizenPlugin : public flutter::Plugin {
           valueListener_->SetHandler(
               [this](const DataSnapshot& snapshot) {
                 TRACE_SCOPE(FT_STREAM);
-                events_->Success(
-                    EncodableValue(CreateDataSnapshotPayload(&snapshot)));
+                events_->Success(MakeDataSnapshotPayload(&snapshot));
               },
               [this](const Error& error, const char* error_message) {
                 TRACE_SCOPE(FT_STREAM, "error_message", error_message);
@@ -642,28 +640,19 @@ class FirebaseDatabaseTizenPlugin : public flutter::Plugin {
                      const DataSnapshot& snapshot,
                      const char* previous_sibling_key) {
                 CHECK_NOT_NULL(previous_sibling_key);
-                bool has_previous_sibling_key = previous_sibling_key[0] != '\0';
 
-                TRACE_SCOPE(
-                    FT_STREAM, "type:", event_type_, "previous_sibling_key:",
-                    has_previous_sibling_key ? previous_sibling_key : "{}");
+                TRACE_SCOPE(FT_STREAM, "type:", event_type_,
+                            "previous_sibling_key:",
+                            previous_sibling_key[0] != '\0'
+                                ? previous_sibling_key
+                                : "{}");
 
                 if (event_type_ == event_type) {
-                  EncodableMap payload = CreateDataSnapshotPayload(&snapshot);
-                  payload.insert(
-                      EncodableValuePair(Constants::kEventType, event_type));
-
                   // Note: if the previous_sibling_key is an empty string, it
-                  // should be represented as a null EncodableValue. This
-                  // situation commonly occurs when the cloud backend does not
-                  // have any entity.
-                  payload.insert(EncodableValuePair(
-                      Constants::kPreviousChildKey,
-                      has_previous_sibling_key
-                          ? EncodableValue(previous_sibling_key)
-                          : EncodableValue()));
-
-                  events_->Success(EncodableValue(payload));
+                  // is sent as null. This situation commonly occurs when the
+                  // cloud backend does not have any entity.
+                  events_->Success(MakeChildEventPayload(
+                      &snapshot, event_type, previous_sibling_key));
                 }
               },
               [this](const Error& error, const char* error_message) {
@@ -726,8 +715,7 @@ class FirebaseDatabaseTizenPlugin : public flutter::Plugin {
 
     // Create an event channel
     auto channel = std::make_shared<EventChannel<EncodableValue>>(
-        binary_messenger_, event_channel_name,
-        &flutter::StandardMethodCodec::GetInstance());
+        binary_messenger_, event_channel_name, &GetPayloadMethodCodec());
 
     // Create a stream handler
     auto stream_handler = std::make_unique<FlutterStreamHandler>(
@@ -22,6 +22,7 @@
 #include <unordered_map>
 
 #include "common/conversion.h"
+#include "common/payload.h"
 #include "common/to_string.h"
 #include "common/trace.h"
 #include "common/utils.h"
@@ -220,6 +221,60 @@ EncodableMap CreateDataSnapshotPayload(const DataSnapshot* snapshot) {
       {EncodableValue(Constants::kSnapshot), EncodableValue(map)}};
 }
 
+static void WriteDataSnapshot(PayloadWriter& writer,
+                              const DataSnapshot* snapshot) {
+  const bool has_children = snapshot->has_children();
+  writer.WriteMap(has_children ? 4 : 3);
+  writer.WriteEntry(Constants::kKey, snapshot->key_string());
+  writer.WriteEntry(Constants::kValue, snapshot->value());
+  writer.WriteEntry(Constants::kPriority, snapshot->priority());
+  if (has_children) {
+    const std::vector<DataSnapshot> children = snapshot->children();
+    writer.WriteString(Constants::kChildKeys);
+    writer.WriteList(children.size());
+    for (const auto& child : children) {
+      writer.WriteString(child.key_string());
+    }
+  }
+}
+
+EncodableValue MakeDataSnapshotPayload(const DataSnapshot* snapshot) {
+  CHECK_NOT_NULL(snapshot);
+
+  // Only the key: events are hot, and the arguments are rendered even when
+  // the category is disabled.
+  TRACE_SCOPE(DATABASE, snapshot->key_string());
+
+  return MakePayload([snapshot](PayloadWriter& writer) {
+    writer.WriteMap(1);
+    writer.WriteString(Constants::kSnapshot);
+    WriteDataSnapshot(writer, snapshot);
+  });
+}
+
+EncodableValue MakeChildEventPayload(const DataSnapshot* snapshot,
+                                     const std::string& event_type,
+                                     const char* previous_child_key) {
+  CHECK_NOT_NULL(snapshot);
+  CHECK_NOT_NULL(previous_child_key);
+
+  TRACE_SCOPE(DATABASE, snapshot->key_string());
+
+  return MakePayload(
+      [snapshot, &event_type, previous_child_key](PayloadWriter& writer) {
+        writer.WriteMap(3);
+        writer.WriteString(Constants::kSnapshot);
+        WriteDataSnapshot(writer, snapshot);
+        writer.WriteEntry(Constants::kEventType, event_type);
+        writer.WriteString(Constants::kPreviousChildKey);
+        if (previous_child_key[0] != '\0') {
+          writer.WriteString(previous_child_key);
+        } else {
+          writer.WriteNull();
+        }
+      });
+}
+
 EncodableMap CreateMutableDataSnapshotPayload(MutableData* snapshot) {
   CHECK_NOT_NULL(snapshot);
 
@@ -245,3 +300,47 @@ EncodableMap CreateMutableDataSnapshotPayload(MutableData* snapshot) {
   return EncodableMap{
       {EncodableValue(Constants::kSnapshot), EncodableValue(map)}};
 }
+
+std::ostream& operator<<(std::ostream& os, const DataSnapshot& snapshot) {
+  static thread_local std::string indent;
+
+  os << indent << "{\n";
+  indent += "  ";
+
+  os << indent << "key: " << snapshot.key_string() << ", \n"
+     << indent << "value: " << snapshot.value() << ", \n"
+     << indent << "priority: " << snapshot.priority() << ", \n"
+     << indent << "children_count: " << snapshot.children_count() << ", \n";
+
+  for (const auto& s : snapshot.children()) {
+    os << s;
+  }
+
+  indent = indent.substr(0, indent.length() - 2);
+  os << indent << "},\n";
+  return os;
+}
+
+std::ostream& operator<<(std::ostream& os, const MutableData& data) {
+  static thread_local std::string indent;
+
+  os << indent << "{\n";
+  indent += "  ";
+
+  // Functions like children_count() or priority() is not marked as const. This
+  // seems to be a firebase mistake. So we convert it to a const reference.
+  MutableData& mutable_data = const_cast<MutableData&>(data);
+
+  os << indent << "key: " << mutable_data.key_string() << ", \n"
+     << indent << "value: " << mutable_data.value() << ", \n"
+     << indent << "priority: " << mutable_data.priority() << ", \n"
+     << indent << "children_count: " << mutable_data.children_count() << ", \n";
+
+  for (auto& d : mutable_data.children()) {
+    os << d;
+  }
+
+  indent = indent.substr(0, indent.length() - 2);
+  os << indent << "},\n";
+  return os;
+}
@@ -19,6 +19,8 @@
 #include <firebase/database.h>
 #include <flutter/encodable_value.h>
 
+#include <string>
+
 // Database
 
 firebase::database::Database* GetDatabaseFromArguments(
@@ -35,6 +37,18 @@ firebase::database::Query GetDatabaseQueryFromArguments(
 flutter::EncodableMap CreateDataSnapshotPayload(
     const firebase::database::DataSnapshot* snapshot);
 
+// Same as CreateDataSnapshotPayload(), but written straight into the message
+// when sent over a channel using GetPayloadMethodCodec(). |snapshot| must
+// outlive the call sending the value.
+flutter::EncodableValue MakeDataSnapshotPayload(
+    const firebase::database::DataSnapshot* snapshot);
+
+// A payload of a child event, i.e. the snapshot payload with the event type
+// and the key of the previous sibling (null if empty).
+flutter::EncodableValue MakeChildEventPayload(
+    const firebase::database::DataSnapshot* snapshot,
+    const std::string& event_type, const char* previous_child_key);
+
 flutter::EncodableMap CreateMutableDataSnapshotPayload(
     firebase::database::MutableData* snapshot);
 
@@ -0,0 +1,160 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "firebase_storage_base64.h"
+
+#include <algorithm>
+#include <array>
+
+namespace base64 {
+
+namespace {
+
+// Set in the table entries of characters outside the alphabet. The decoded
+// bits only take the lower 24 bits.
+constexpr uint32_t kInvalid = 0x01000000;
+
+// The characters decoded per block between validity checks.
+constexpr size_t kBlockSize = 64;
+
+using DecodeTable = std::array<std::array<uint32_t, 256>, 4>;
+
+constexpr int GetValue(unsigned char c, Alphabet alphabet) {
+  if (c >= 'A' && c <= 'Z') {
+    return c - 'A';
+  }
+  if (c >= 'a' && c <= 'z') {
+    return c - 'a' + 26;
+  }
+  if (c >= '0' && c <= '9') {
+    return c - '0' + 52;
+  }
+  if (alphabet == Alphabet::kStandard) {
+    return c == '+' ? 62 : c == '/' ? 63 : -1;
+  }
+  return c == '-' ? 62 : c == '_' ? 63 : -1;
+}
+
+// Entry [i][c] holds the bits of character c at position i of a group of
+// four, already shifted to where they land in the three decoded bytes, with
+// the first byte in the lowest 8 bits.
+constexpr DecodeTable MakeDecodeTable(Alphabet alphabet) {
+  DecodeTable table{};
+  for (int c = 0; c < 256; ++c) {
+    int value = GetValue(static_cast<unsigned char>(c), alphabet);
+    if (value < 0) {
+      for (auto& position : table) {
+        position[c] = kInvalid;
+      }
+      continue;
+    }
+    uint32_t v = static_cast<uint32_t>(value);
+    table[0][c] = v << 2;
+    table[1][c] = (v >> 4) | ((v & 0x0f) << 12);
+    table[2][c] = ((v >> 2) << 8) | ((v & 0x03) << 22);
+    table[3][c] = v << 16;
+  }
+  return table;
+}
+
+constexpr DecodeTable kStandardTable = MakeDecodeTable(Alphabet::kStandard);
+constexpr DecodeTable kUrlTable = MakeDecodeTable(Alphabet::kUrl);
+
+inline uint32_t DecodeGroup(const DecodeTable& table, const unsigned char* in) {
+  return table[0][in[0]] | table[1][in[1]] | table[2][in[2]] |
+         table[3][in[3]];
+}
+
+inline void WriteGroup(uint32_t bits, uint8_t* out) {
+  out[0] = static_cast<uint8_t>(bits);
+  out[1] = static_cast<uint8_t>(bits >> 8);
+  out[2] = static_cast<uint8_t>(bits >> 16);
+}
+
+std::string_view StripPadding(std::string_view input) {
+  for (int i = 0; i < 2 && !input.empty() && input.back() == '='; ++i) {
+    input.remove_suffix(1);
+  }
+  return input;
+}
+
+}  // namespace
+
+size_t GetDecodedSize(std::string_view input) {
+  input = StripPadding(input);
+  size_t rest = input.size() % 4;
+  return input.size() / 4 * 3 + (rest == 0 ? 0 : rest - 1);
+}
+
+bool Decode(std::string_view input, Alphabet alphabet, uint8_t* output) {
+  input = StripPadding(input);
+  if (input.size() % 4 == 1) {
+    return false;
+  }
+
+  const DecodeTable& table =
+      alphabet == Alphabet::kStandard ? kStandardTable : kUrlTable;
+  auto in = reinterpret_cast<const unsigned char*>(input.data());
+  const unsigned char* groups_end = in + input.size() / 4 * 4;
+
+  while (in != groups_end) {
+    size_t block = std::min<size_t>(groups_end - in, kBlockSize);
+    const unsigned char* block_end = in + block;
+    uint32_t invalid = 0;
+    for (; in != block_end; in += 4, output += 3) {
+      uint32_t bits = DecodeGroup(table, in);
+      invalid |= bits;
+      WriteGroup(bits, output);
+    }
+    if (invalid & kInvalid) {
+      return false;
+    }
+  }
+
+  // The last two or three characters, if the length is not a multiple of 4.
+  size_t rest = input.size() % 4;
+  if (rest > 0) {
+    unsigned char group[4] = {'A', 'A', 'A', 'A'};
+    for (size_t i = 0; i < rest; ++i) {
+      group[i] = in[i];
+    }
+    uint32_t bits = DecodeGroup(table, group);
+    if (bits & kInvalid) {
+      return false;
+    }
+    output[0] = static_cast<uint8_t>(bits);
+    if (rest == 3) {
+      output[1] = static_cast<uint8_t>(bits >> 8);
+    }
+  }
+  return true;
+}
+
+bool ParseDataUrl(std::string_view input, std::string_view* media_type,
+                  bool* is_base64, std::string_view* data) {
+  constexpr std::string_view kScheme = "data:";
+  constexpr std::string_view kBase64Suffix = ";base64";
+  if (input.substr(0, kScheme.size()) != kScheme) {
+    return false;
+  }
+  size_t comma = input.find(',');
+  if (comma == std::string_view::npos) {
+    return false;
+  }
+
+  std::string_view header =
+      input.substr(kScheme.size(), comma - kScheme.size());
+  *is_base64 = header.size() >= kBase64Suffix.size() &&
+               header.substr(header.size() - kBase64Suffix.size()) ==
+                   kBase64Suffix;
+  if (*is_base64) {
+    header.remove_suffix(kBase64Suffix.size());
+  }
+  // Parameters such as ";charset=..." belong to the media type.
+  *media_type = header;
+  *data = input.substr(comma + 1);
+  return true;
+}
+
+}  // namespace base64
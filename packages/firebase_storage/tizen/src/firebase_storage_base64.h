@@ -0,0 +1,41 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_PLUGIN_FIREBASE_STORAGE_BASE64_H_
+#define FLUTTER_PLUGIN_FIREBASE_STORAGE_BASE64_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace base64 {
+
+enum class Alphabet {
+  // RFC 4648 section 4, with '+' and '/'.
+  kStandard,
+  // RFC 4648 section 5, with '-' and '_'.
+  kUrl,
+};
+
+// Returns the number of bytes |input| decodes to, assuming it is valid.
+size_t GetDecodedSize(std::string_view input);
+
+// Decodes |input| into |output|, which must have room for
+// GetDecodedSize(input) bytes. Padding is optional. Returns false if |input|
+// is not valid, in which case |output| holds garbage.
+//
+// Four characters are decoded at a time through lookup tables that place
+// each one's bits straight at their position in the three output bytes, and
+// validity is checked once per block rather than once per character.
+bool Decode(std::string_view input, Alphabet alphabet, uint8_t* output);
+
+// Splits a data URL (RFC 2397) into the media type and the data, the latter
+// still encoded. Returns false if |input| is not a data URL.
+bool ParseDataUrl(std::string_view input, std::string_view* media_type,
+                  bool* is_base64, std::string_view* data);
+
+}  // namespace base64
+
+#endif  // FLUTTER_PLUGIN_FIREBASE_STORAGE_BASE64_H_
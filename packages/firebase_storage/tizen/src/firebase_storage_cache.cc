@@ -0,0 +1,355 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "firebase_storage_cache.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <utility>
+
+#include "firebase_storage_utils.h"
+#include "log.h"
+
+namespace {
+
+constexpr char kDataExtension[] = ".data";
+constexpr char kMetaExtension[] = ".meta";
+
+bool EndsWith(const std::string& value, const std::string& suffix) {
+  return value.size() >= suffix.size() &&
+         value.compare(value.size() - suffix.size(), suffix.size(), suffix) ==
+             0;
+}
+
+// Returns a file name in |directory| no other writer uses.
+std::string GetTemporaryFilePath(const std::string& directory) {
+  static std::atomic<uint64_t> counter{0};
+  std::ostringstream path;
+  path << directory << "/" << getpid() << "-" << counter++ << ".tmp";
+  return path.str();
+}
+
+bool CopyFile(const std::string& from, const std::string& to) {
+  std::ifstream in(from, std::ios::binary);
+  std::ofstream out(to, std::ios::binary | std::ios::trunc);
+  if (!in || !out) {
+    return false;
+  }
+  out << in.rdbuf();
+  return static_cast<bool>(out);
+}
+
+}  // namespace
+
+StorageDownloadCache& StorageDownloadCache::GetInstance() {
+  static StorageDownloadCache instance;
+  return instance;
+}
+
+void StorageDownloadCache::SetOptions(const Options& options) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  options_ = options;
+  if (loaded_) {
+    Evict();
+  }
+}
+
+StorageDownloadCache::Options StorageDownloadCache::GetOptions() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return options_;
+}
+
+std::string StorageDownloadCache::GetValidator(
+    const firebase::storage::Metadata& metadata) {
+  // A new generation is created whenever an object is overwritten. The hash
+  // is only there for servers that do not report generations. Composed
+  // objects have none.
+  const char* md5_hash = metadata.md5_hash();
+  std::ostringstream validator;
+  validator << metadata.generation() << "-" << (md5_hash ? md5_hash : "");
+  return validator.str();
+}
+
+bool StorageDownloadCache::Read(const std::string& bucket,
+                                const std::string& path,
+                                const std::string& validator,
+                                std::vector<uint8_t>* data) {
+  std::string data_path;
+  int64_t size;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry* entry = Find(bucket, path, validator);
+    if (!entry) {
+      return false;
+    }
+    data_path = GetFilePath(GetKey(bucket, path), kDataExtension);
+    size = entry->size;
+  }
+
+  // Read without holding |mutex_|. If the entry is evicted meanwhile, the
+  // open file stays readable.
+  int fd = open(data_path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  data->resize(static_cast<size_t>(size));
+  size_t offset = 0;
+  while (offset < data->size()) {
+    ssize_t read_bytes =
+        pread(fd, data->data() + offset, data->size() - offset, offset);
+    if (read_bytes <= 0) {
+      break;
+    }
+    offset += static_cast<size_t>(read_bytes);
+  }
+  close(fd);
+  return offset == data->size();
+}
+
+bool StorageDownloadCache::CopyToFile(const std::string& bucket,
+                                      const std::string& path,
+                                      const std::string& validator,
+                                      const std::string& file_path,
+                                      int64_t* size) {
+  std::string data_path;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry* entry = Find(bucket, path, validator);
+    if (!entry) {
+      return false;
+    }
+    data_path = GetFilePath(GetKey(bucket, path), kDataExtension);
+    *size = entry->size;
+  }
+  return CopyFile(data_path, file_path);
+}
+
+void StorageDownloadCache::Write(const std::string& bucket,
+                                 const std::string& path,
+                                 const std::string& validator,
+                                 const uint8_t* data, size_t size) {
+  std::string directory;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!options_.enabled || static_cast<int64_t>(size) > options_.max_size ||
+        !EnsureLoaded()) {
+      return;
+    }
+    directory = directory_;
+  }
+
+  std::string temporary_path = GetTemporaryFilePath(directory);
+  std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char*>(data), size);
+  file.close();
+  if (!file) {
+    LOG_ERROR("Failed to write %s", temporary_path.c_str());
+    std::remove(temporary_path.c_str());
+    return;
+  }
+
+  Insert(bucket, path, validator, temporary_path, static_cast<int64_t>(size));
+}
+
+void StorageDownloadCache::WriteFromFile(const std::string& bucket,
+                                         const std::string& path,
+                                         const std::string& validator,
+                                         const std::string& file_path) {
+  struct stat file_stat;
+  if (stat(file_path.c_str(), &file_stat) != 0) {
+    return;
+  }
+
+  std::string directory;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!options_.enabled || file_stat.st_size > options_.max_size ||
+        !EnsureLoaded()) {
+      return;
+    }
+    directory = directory_;
+  }
+
+  std::string temporary_path = GetTemporaryFilePath(directory);
+  if (!CopyFile(file_path, temporary_path)) {
+    LOG_ERROR("Failed to write %s", temporary_path.c_str());
+    std::remove(temporary_path.c_str());
+    return;
+  }
+
+  Insert(bucket, path, validator, temporary_path, file_stat.st_size);
+}
+
+void StorageDownloadCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!EnsureLoaded()) {
+    return;
+  }
+  while (!lru_.empty()) {
+    Remove(lru_.back());
+  }
+}
+
+bool StorageDownloadCache::EnsureLoaded() {
+  if (loaded_) {
+    return !directory_.empty();
+  }
+  loaded_ = true;
+  directory_ = utils::GetDownloadCacheDirectory();
+  if (directory_.empty()) {
+    return false;
+  }
+
+  DIR* dir = opendir(directory_.c_str());
+  if (!dir) {
+    directory_.clear();
+    return false;
+  }
+
+  // Sorted by the last use, the oldest first.
+  std::multimap<int64_t, std::string> keys;
+  std::vector<std::string> stale_files;
+  while (dirent* file = readdir(dir)) {
+    std::string name = file->d_name;
+    if (EndsWith(name, kMetaExtension)) {
+      struct stat meta_stat;
+      if (stat((directory_ + "/" + name).c_str(), &meta_stat) == 0) {
+        keys.emplace(meta_stat.st_mtime,
+                     name.substr(0, name.size() - strlen(kMetaExtension)));
+      }
+    } else if (EndsWith(name, ".tmp")) {
+      // Left behind by a write that was interrupted.
+      stale_files.push_back(name);
+    }
+  }
+  closedir(dir);
+  for (const auto& name : stale_files) {
+    std::remove((directory_ + "/" + name).c_str());
+  }
+
+  for (const auto& [time, key] : keys) {
+    std::ifstream file(GetFilePath(key, kMetaExtension));
+    std::map<std::string, std::string> values;
+    std::string line;
+    while (std::getline(file, line)) {
+      size_t separator = line.find('=');
+      if (separator != std::string::npos) {
+        values[line.substr(0, separator)] = line.substr(separator + 1);
+      }
+    }
+
+    struct stat data_stat;
+    if (stat(GetFilePath(key, kDataExtension).c_str(), &data_stat) != 0 ||
+        values["size"] != std::to_string(data_stat.st_size) ||
+        GetKey(values["bucket"], values["path"]) != key) {
+      std::remove(GetFilePath(key, kMetaExtension).c_str());
+      std::remove(GetFilePath(key, kDataExtension).c_str());
+      continue;
+    }
+
+    lru_.push_front(key);
+    entries_[key] = Entry{values["bucket"], values["path"], values["validator"],
+                          data_stat.st_size, lru_.begin()};
+    total_size_ += data_stat.st_size;
+  }
+  Evict();
+  return true;
+}
+
+std::string StorageDownloadCache::GetKey(const std::string& bucket,
+                                         const std::string& path) {
+  std::ostringstream key;
+  key << std::hex << std::hash<std::string>()(bucket + '\n' + path);
+  return key.str();
+}
+
+std::string StorageDownloadCache::GetFilePath(const std::string& key,
+                                              const char* extension) {
+  return directory_ + "/" + key + extension;
+}
+
+StorageDownloadCache::Entry* StorageDownloadCache::Find(
+    const std::string& bucket, const std::string& path,
+    const std::string& validator) {
+  if (!options_.enabled || !EnsureLoaded()) {
+    return nullptr;
+  }
+
+  std::string key = GetKey(bucket, path);
+  auto it = entries_.find(key);
+  if (it == entries_.end() || it->second.bucket != bucket ||
+      it->second.path != path) {
+    return nullptr;
+  }
+  if (!validator.empty() && it->second.validator != validator) {
+    // The object has changed since it was cached.
+    Remove(key);
+    return nullptr;
+  }
+
+  lru_.splice(lru_.begin(), lru_, it->second.lru_position);
+  utimensat(AT_FDCWD, GetFilePath(key, kMetaExtension).c_str(), nullptr, 0);
+  return &it->second;
+}
+
+void StorageDownloadCache::Insert(const std::string& bucket,
+                                  const std::string& path,
+                                  const std::string& validator,
+                                  const std::string& data_path, int64_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::string key = GetKey(bucket, path);
+  Remove(key);
+  if (std::rename(data_path.c_str(),
+                  GetFilePath(key, kDataExtension).c_str()) != 0) {
+    std::remove(data_path.c_str());
+    return;
+  }
+
+  Entry entry{bucket, path, validator, size, {}};
+  std::ofstream file(GetFilePath(key, kMetaExtension), std::ios::trunc);
+  file << "bucket=" << entry.bucket << "\n"
+       << "path=" << entry.path << "\n"
+       << "validator=" << entry.validator << "\n"
+       << "size=" << entry.size << "\n";
+  file.close();
+  if (!file) {
+    LOG_ERROR("Failed to write %s", GetFilePath(key, kMetaExtension).c_str());
+    std::remove(GetFilePath(key, kMetaExtension).c_str());
+    std::remove(GetFilePath(key, kDataExtension).c_str());
+    return;
+  }
+
+  lru_.push_front(key);
+  entry.lru_position = lru_.begin();
+  total_size_ += entry.size;
+  entries_[key] = std::move(entry);
+  Evict();
+}
+
+void StorageDownloadCache::Remove(const std::string& key) {
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return;
+  }
+  std::remove(GetFilePath(key, kMetaExtension).c_str());
+  std::remove(GetFilePath(key, kDataExtension).c_str());
+  total_size_ -= it->second.size;
+  lru_.erase(it->second.lru_position);
+  entries_.erase(it);
+}
+
+void StorageDownloadCache::Evict() {
+  while (total_size_ > options_.max_size && !lru_.empty()) {
+    Remove(lru_.back());
+  }
+}
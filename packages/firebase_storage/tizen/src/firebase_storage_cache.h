@@ -0,0 +1,101 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_PLUGIN_FIREBASE_STORAGE_CACHE_H_
+#define FLUTTER_PLUGIN_FIREBASE_STORAGE_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "firebase/storage.h"
+
+// An on-disk cache of downloaded objects, keyed by bucket and path. Each
+// object is stored with a validator derived from its metadata, and a cached
+// copy is only used while the validator matches. The least recently used
+// objects are evicted once the cache outgrows its size limit.
+//
+// Every object takes two files in the cache directory: "<key>.data" holding
+// the content, and "<key>.meta" describing it, whose modification time
+// records the last use.
+class StorageDownloadCache {
+ public:
+  struct Options {
+    bool enabled = false;
+    int64_t max_size = 64 * 1024 * 1024;
+    // Whether the metadata is fetched on every read to check that the cached
+    // copy is current. Otherwise cached copies are used as long as they are
+    // cached, which suits objects that are never overwritten.
+    bool validate = true;
+  };
+
+  static StorageDownloadCache& GetInstance();
+
+  void SetOptions(const Options& options);
+  Options GetOptions();
+
+  // Identifies the content an object had when |metadata| was read.
+  static std::string GetValidator(const firebase::storage::Metadata& metadata);
+
+  // Read the cached copy of an object if it has |validator|, or any cached
+  // copy if |validator| is empty. Return false on a miss.
+  bool Read(const std::string& bucket, const std::string& path,
+            const std::string& validator, std::vector<uint8_t>* data);
+  bool CopyToFile(const std::string& bucket, const std::string& path,
+                  const std::string& validator, const std::string& file_path,
+                  int64_t* size);
+
+  // Cache the content of an object, replacing any older copy.
+  void Write(const std::string& bucket, const std::string& path,
+             const std::string& validator, const uint8_t* data, size_t size);
+  void WriteFromFile(const std::string& bucket, const std::string& path,
+                     const std::string& validator,
+                     const std::string& file_path);
+
+  void Clear();
+
+ private:
+  struct Entry {
+    std::string bucket;
+    std::string path;
+    std::string validator;
+    int64_t size;
+    std::list<std::string>::iterator lru_position;
+  };
+
+  StorageDownloadCache() = default;
+  StorageDownloadCache(const StorageDownloadCache&) = delete;
+  void operator=(const StorageDownloadCache&) = delete;
+
+  // Moves |data_path| into the cache as the content of an object, and makes
+  // room for it.
+  void Insert(const std::string& bucket, const std::string& path,
+              const std::string& validator, const std::string& data_path,
+              int64_t size);
+
+  // The following must be called with |mutex_| held.
+  bool EnsureLoaded();
+  std::string GetKey(const std::string& bucket, const std::string& path);
+  std::string GetFilePath(const std::string& key, const char* extension);
+  // Returns the entry of an object if it can be used for |validator|, and
+  // marks it as the most recently used.
+  Entry* Find(const std::string& bucket, const std::string& path,
+              const std::string& validator);
+  void Remove(const std::string& key);
+  void Evict();
+
+  std::mutex mutex_;
+  Options options_;
+  std::string directory_;
+  bool loaded_{false};
+  int64_t total_size_{0};
+  std::unordered_map<std::string, Entry> entries_;
+  // The keys of |entries_|, the most recently used first.
+  std::list<std::string> lru_;
+};
+
+#endif  // FLUTTER_PLUGIN_FIREBASE_STORAGE_CACHE_H_
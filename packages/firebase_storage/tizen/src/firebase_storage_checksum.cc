@@ -0,0 +1,231 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "firebase_storage_checksum.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "firebase_storage_base64.h"
+
+namespace {
+
+constexpr size_t kReadSize = 64 * 1024;
+
+constexpr uint32_t kK[64] = {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a,
+    0xa8304613, 0xfd469501, 0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
+    0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821, 0xf61e2562, 0xc040b340,
+    0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8,
+    0x676f02d9, 0x8d2a4c8a, 0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c,
+    0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70, 0x289b7ec6, 0xeaa127fa,
+    0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92,
+    0xffeff47d, 0x85845dd1, 0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1,
+    0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391};
+
+constexpr int kShift[64] = {
+    7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+    5, 9,  14, 20, 5, 9,  14, 20, 5, 9,  14, 20, 5, 9,  14, 20,
+    4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+    6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21};
+
+inline uint32_t Rotate(uint32_t x, int c) {
+  return (x << c) | (x >> (32 - c));
+}
+
+// Whether |digest| is |expected_md5|, which is base64 encoded like
+// Metadata::md5_hash().
+bool Matches(const Md5::Digest& digest, const std::string& expected_md5) {
+  Md5::Digest expected;
+  if (base64::GetDecodedSize(expected_md5) != expected.size() ||
+      !base64::Decode(expected_md5, base64::Alphabet::kStandard,
+                      expected.data())) {
+    return false;
+  }
+  return digest == expected;
+}
+
+}  // namespace
+
+void Md5::Update(const uint8_t* data, size_t size) {
+  length_ += size;
+  if (buffer_size_ > 0) {
+    size_t count = std::min(size, sizeof(buffer_) - buffer_size_);
+    memcpy(buffer_ + buffer_size_, data, count);
+    buffer_size_ += count;
+    data += count;
+    size -= count;
+    if (buffer_size_ < sizeof(buffer_)) {
+      return;
+    }
+    Transform(buffer_);
+    buffer_size_ = 0;
+  }
+  // Whole blocks are hashed in place.
+  while (size >= sizeof(buffer_)) {
+    Transform(data);
+    data += sizeof(buffer_);
+    size -= sizeof(buffer_);
+  }
+  memcpy(buffer_, data, size);
+  buffer_size_ = size;
+}
+
+Md5::Digest Md5::Finish() {
+  uint64_t bit_length = length_ * 8;
+  uint8_t padding[72] = {0x80};
+  size_t padding_size =
+      (buffer_size_ < 56 ? 56 : 120) - static_cast<size_t>(buffer_size_);
+  for (int i = 0; i < 8; ++i) {
+    padding[padding_size + i] = static_cast<uint8_t>(bit_length >> (8 * i));
+  }
+  Update(padding, padding_size + 8);
+
+  Digest digest;
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      digest[i * 4 + j] = static_cast<uint8_t>(state_[i] >> (8 * j));
+    }
+  }
+  return digest;
+}
+
+void Md5::Transform(const uint8_t* block) {
+  uint32_t m[16];
+  for (int i = 0; i < 16; ++i) {
+    m[i] = block[i * 4] | (block[i * 4 + 1] << 8) | (block[i * 4 + 2] << 16) |
+           (static_cast<uint32_t>(block[i * 4 + 3]) << 24);
+  }
+  uint32_t a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+  for (int i = 0; i < 64; ++i) {
+    uint32_t f;
+    int g;
+    if (i < 16) {
+      f = (b & c) | (~b & d);
+      g = i;
+    } else if (i < 32) {
+      f = (d & b) | (~d & c);
+      g = (5 * i + 1) % 16;
+    } else if (i < 48) {
+      f = b ^ c ^ d;
+      g = (3 * i + 5) % 16;
+    } else {
+      f = c ^ (b | ~d);
+      g = (7 * i) % 16;
+    }
+    uint32_t next = d;
+    d = c;
+    c = b;
+    b = b + Rotate(a + f + kK[i] + m[g], kShift[i]);
+    a = next;
+  }
+  state_[0] += a;
+  state_[1] += b;
+  state_[2] += c;
+  state_[3] += d;
+}
+
+FileChecksum::FileChecksum(std::string file_path)
+    : file_path_(std::move(file_path)) {}
+
+FileChecksum::~FileChecksum() {
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
+
+void FileChecksum::Update(int64_t bytes_written) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!Open()) {
+    return;
+  }
+  if (bytes_written < hashed_) {
+    // The download went back, and rewrites the file from there.
+    Reset();
+  }
+  HashWritten();
+}
+
+bool FileChecksum::Verify(const std::string& expected_md5) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // The file may have been replaced rather than written in place, in which
+  // case what was hashed so far is of no use.
+  struct stat open_stat, path_stat;
+  if (fd_ >= 0 && (fstat(fd_, &open_stat) != 0 ||
+                   stat(file_path_.c_str(), &path_stat) != 0 ||
+                   open_stat.st_ino != path_stat.st_ino ||
+                   open_stat.st_dev != path_stat.st_dev)) {
+    close(fd_);
+    fd_ = -1;
+    Reset();
+  }
+  if (!Open()) {
+    return false;
+  }
+  HashWritten();
+  return Matches(md5_.Finish(), expected_md5);
+}
+
+bool FileChecksum::Open() {
+  if (fd_ < 0) {
+    fd_ = open(file_path_.c_str(), O_RDONLY | O_CLOEXEC);
+  }
+  return fd_ >= 0;
+}
+
+void FileChecksum::Reset() {
+  md5_ = Md5();
+  hashed_ = 0;
+}
+
+void FileChecksum::HashWritten() {
+  struct stat file_stat;
+  if (fstat(fd_, &file_stat) == 0 && file_stat.st_size < hashed_) {
+    // Truncated to be written again.
+    Reset();
+  }
+
+  std::vector<uint8_t> buffer(kReadSize);
+  while (true) {
+    ssize_t size = pread(fd_, buffer.data(), buffer.size(), hashed_);
+    if (size < 0 && errno == EINTR) {
+      continue;
+    }
+    if (size <= 0) {
+      return;
+    }
+    md5_.Update(buffer.data(), static_cast<size_t>(size));
+    hashed_ += size;
+  }
+}
+
+MappedFileChecksum::MappedFileChecksum(std::shared_ptr<const MappedFile> file)
+    : file_(std::move(file)) {}
+
+void MappedFileChecksum::Update(int64_t offset) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  HashTo(std::min<int64_t>(offset, file_->size()));
+}
+
+bool MappedFileChecksum::Verify(const std::string& expected_md5) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  HashTo(file_->size());
+  return Matches(md5_.Finish(), expected_md5);
+}
+
+void MappedFileChecksum::HashTo(int64_t offset) {
+  if (offset > hashed_) {
+    md5_.Update(file_->data() + hashed_, static_cast<size_t>(offset - hashed_));
+    hashed_ = offset;
+  }
+}
@@ -0,0 +1,90 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_PLUGIN_FIREBASE_STORAGE_CHECKSUM_H_
+#define FLUTTER_PLUGIN_FIREBASE_STORAGE_CHECKSUM_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "firebase_storage_mapped_file.h"
+
+// RFC 1321 MD5, the hash Cloud Storage reports in Metadata::md5_hash().
+class Md5 {
+ public:
+  using Digest = std::array<uint8_t, 16>;
+
+  void Update(const uint8_t* data, size_t size);
+  Digest Finish();
+
+ private:
+  void Transform(const uint8_t* block);
+
+  uint32_t state_[4] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+  uint8_t buffer_[64];
+  size_t buffer_size_{0};
+  uint64_t length_{0};
+};
+
+// Hashes a file while a download writes it. Each Update() hashes what has
+// been written since the previous one, while it is still in the page cache,
+// so checking the file once the download completes only reads what was
+// written after the last progress report. The hash starts over if the
+// download rewrites what was already hashed, e.g. when it is restarted.
+class FileChecksum {
+ public:
+  explicit FileChecksum(std::string file_path);
+  ~FileChecksum();
+
+  // |bytes_written| is what the download reports to have written so far.
+  void Update(int64_t bytes_written);
+
+  // Hashes the rest of the file and compares the hash with |expected_md5|,
+  // which is base64 encoded like Metadata::md5_hash().
+  bool Verify(const std::string& expected_md5);
+
+ private:
+  // The following must be called with |mutex_| held.
+  bool Open();
+  void Reset();
+  // Starts over if the file is shorter than what was hashed.
+  void HashWritten();
+
+  std::mutex mutex_;
+  std::string file_path_;
+  int fd_{-1};
+  int64_t hashed_{0};
+  Md5 md5_;
+};
+
+// Hashes a mapped file while an upload sends it. Each Update() hashes what
+// has been sent since the previous one, so checking the upload once it
+// completes only hashes what was sent after the last progress report.
+class MappedFileChecksum {
+ public:
+  explicit MappedFileChecksum(std::shared_ptr<const MappedFile> file);
+
+  // Hashes the file up to |offset|. What is sent again after a retry is not
+  // hashed again.
+  void Update(int64_t offset);
+
+  // Hashes the rest of the file and compares the hash with |expected_md5|,
+  // which is base64 encoded like Metadata::md5_hash().
+  bool Verify(const std::string& expected_md5);
+
+ private:
+  // Must be called with |mutex_| held.
+  void HashTo(int64_t offset);
+
+  std::mutex mutex_;
+  std::shared_ptr<const MappedFile> file_;
+  int64_t hashed_{0};
+  Md5 md5_;
+};
+
+#endif  // FLUTTER_PLUGIN_FIREBASE_STORAGE_CHECKSUM_H_
@@ -38,6 +38,8 @@ std::string FirebaseStorageError::GetCodeString() const {
       return "system-error";
     case Code::KTaskNotFound:
       return "task-not-found";
+    case Code::kUnimplemented:
+      return "unimplemented";
     case Code::kUnknown:
     default:
       return "unknown";
@@ -71,6 +73,8 @@ std::string FirebaseStorageError::GetErrorString() const {
       return "A system error occurred.";
     case Code::KTaskNotFound:
       return "A task does not exist.";
+    case Code::kUnimplemented:
+      return "The operation is not implemented.";
     default:
       return "An unknown error occurred.";
   }
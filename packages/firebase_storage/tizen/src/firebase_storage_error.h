@@ -31,6 +31,7 @@ class FirebaseStorageError {
     kInvalidString,
     kSystemError,
     KTaskNotFound,
+    kUnimplemented,
   };
 
   FirebaseStorageError(Code code, const std::string& message)
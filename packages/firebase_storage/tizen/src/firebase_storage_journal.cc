@@ -0,0 +1,223 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "firebase_storage_journal.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <utility>
+
+#include "common/payload.h"
+#include "firebase_storage_utils.h"
+#include "log.h"
+
+namespace {
+
+constexpr char kExtension[] = ".transfer";
+
+// The progress is persisted at most once per this many bytes.
+constexpr int64_t kSaveInterval = 1024 * 1024;
+
+bool EndsWith(const std::string& value, const std::string& suffix) {
+  return value.size() >= suffix.size() &&
+         value.compare(value.size() - suffix.size(), suffix.size(), suffix) ==
+             0;
+}
+
+bool FileExists(const std::string& path) {
+  struct stat file_stat;
+  return !path.empty() && stat(path.c_str(), &file_stat) == 0;
+}
+
+}  // namespace
+
+StorageTransferJournal& StorageTransferJournal::GetInstance() {
+  static StorageTransferJournal instance;
+  return instance;
+}
+
+StorageTransferJournal::StorageTransferJournal()
+    : run_id_(std::to_string(
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::system_clock::now().time_since_epoch())
+              .count())) {}
+
+void StorageTransferJournal::Load() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (loaded_ || !EnsureDirectory()) {
+    return;
+  }
+  loaded_ = true;
+
+  DIR* dir = opendir(directory_.c_str());
+  if (!dir) {
+    return;
+  }
+  std::vector<std::string> names;
+  while (dirent* file = readdir(dir)) {
+    std::string name = file->d_name;
+    if (EndsWith(name, kExtension) && name.rfind(run_id_ + "-", 0) != 0) {
+      names.push_back(name);
+    } else if (EndsWith(name, ".tmp")) {
+      // Left behind by a save that was interrupted.
+      std::remove((directory_ + "/" + name).c_str());
+    }
+  }
+  closedir(dir);
+
+  for (const auto& name : names) {
+    Record record;
+    record.file = directory_ + "/" + name;
+    std::ifstream file(record.file);
+    std::map<std::string, std::string> values;
+    std::string line;
+    while (std::getline(file, line)) {
+      size_t separator = line.find('=');
+      if (separator != std::string::npos) {
+        values[line.substr(0, separator)] = line.substr(separator + 1);
+      }
+    }
+
+    Entry& entry = record.entry;
+    entry.type = values["type"];
+    entry.app_name = values["app"];
+    entry.bucket = values["bucket"];
+    entry.path = values["path"];
+    entry.file_path = values["file"];
+    entry.session_file = values["session"];
+    entry.handle = std::atoi(values["handle"].c_str());
+    entry.bytes_transferred = std::atoll(values["bytes"].c_str());
+    entry.total_bytes = std::atoll(values["total"].c_str());
+    if (entry.type.empty() || entry.path.empty()) {
+      std::remove(record.file.c_str());
+      continue;
+    }
+    record.saved_bytes = entry.bytes_transferred;
+    interrupted_.push_back(std::move(record));
+  }
+}
+
+void StorageTransferJournal::Add(const Entry& entry) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!EnsureDirectory()) {
+    return;
+  }
+  Record& record = records_[entry.handle];
+  record.entry = entry;
+  record.file = directory_ + "/" + run_id_ + "-" +
+                std::to_string(entry.handle) + kExtension;
+  Save(record);
+}
+
+void StorageTransferJournal::SetSessionFile(int handle,
+                                            const std::string& session_file) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = records_.find(handle);
+  if (it != records_.end()) {
+    it->second.entry.session_file = session_file;
+    Save(it->second);
+  }
+}
+
+void StorageTransferJournal::UpdateProgress(int handle,
+                                            int64_t bytes_transferred,
+                                            int64_t total_bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = records_.find(handle);
+  if (it == records_.end()) {
+    return;
+  }
+  Record& record = it->second;
+  record.entry.bytes_transferred = bytes_transferred;
+  record.entry.total_bytes = total_bytes;
+  if (bytes_transferred - record.saved_bytes >= kSaveInterval) {
+    Save(record);
+  }
+}
+
+void StorageTransferJournal::Remove(int handle) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = records_.find(handle);
+  if (it == records_.end()) {
+    return;
+  }
+  std::remove(it->second.file.c_str());
+  records_.erase(it);
+}
+
+std::vector<StorageTransferJournal::Entry>
+StorageTransferJournal::GetInterrupted() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<Entry> entries;
+  entries.reserve(interrupted_.size());
+  for (const auto& record : interrupted_) {
+    entries.push_back(record.entry);
+  }
+  return entries;
+}
+
+void StorageTransferJournal::ClearInterrupted() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& record : interrupted_) {
+    std::remove(record.file.c_str());
+  }
+  interrupted_.clear();
+}
+
+flutter::EncodableValue StorageTransferJournal::GetEntriesPayload(
+    const std::vector<Entry>& entries) {
+  return MakePayload([&entries](PayloadWriter& writer) {
+    writer.WriteList(entries.size());
+    for (const auto& entry : entries) {
+      writer.WriteMap(9);
+      writer.WriteEntry("handle", entry.handle);
+      writer.WriteEntry("type", entry.type);
+      writer.WriteEntry("appName", entry.app_name);
+      writer.WriteEntry("bucket", entry.bucket);
+      writer.WriteEntry("path", entry.path);
+      writer.WriteEntry("filePath", entry.file_path);
+      writer.WriteEntry("bytesTransferred", entry.bytes_transferred);
+      writer.WriteEntry("totalBytes", entry.total_bytes);
+      // The session expires on the server after a week, which is only found
+      // out once the upload is started again.
+      writer.WriteEntry("resumable", FileExists(entry.session_file));
+    }
+  });
+}
+
+bool StorageTransferJournal::EnsureDirectory() {
+  if (directory_.empty()) {
+    directory_ = utils::GetTransferJournalDirectory();
+  }
+  return !directory_.empty();
+}
+
+void StorageTransferJournal::Save(Record& record) {
+  // Written aside and renamed, so that a crash never leaves a partial entry.
+  std::string temp_file = record.file + ".tmp";
+  const Entry& entry = record.entry;
+  std::ofstream file(temp_file, std::ios::trunc);
+  file << "handle=" << entry.handle << "\n"
+       << "type=" << entry.type << "\n"
+       << "app=" << entry.app_name << "\n"
+       << "bucket=" << entry.bucket << "\n"
+       << "path=" << entry.path << "\n"
+       << "file=" << entry.file_path << "\n"
+       << "session=" << entry.session_file << "\n"
+       << "bytes=" << entry.bytes_transferred << "\n"
+       << "total=" << entry.total_bytes << "\n";
+  file.close();
+  if (!file || std::rename(temp_file.c_str(), record.file.c_str()) != 0) {
+    LOG_ERROR("Failed to write %s", record.file.c_str());
+    std::remove(temp_file.c_str());
+    return;
+  }
+  record.saved_bytes = entry.bytes_transferred;
+}
@@ -0,0 +1,85 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_PLUGIN_FIREBASE_STORAGE_JOURNAL_H_
+#define FLUTTER_PLUGIN_FIREBASE_STORAGE_JOURNAL_H_
+
+#include <flutter/encodable_value.h>
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Records the file transfers in flight on disk, so that the ones an app
+// restart interrupts are known to the next run. A file upload started again
+// with the same bucket, path and file continues from its persisted
+// ResumableUpload session instead of sending the whole file again.
+//
+// Every transfer takes a file "<run>-<handle>.transfer" in the journal
+// directory, which is removed once the transfer completes.
+class StorageTransferJournal {
+ public:
+  struct Entry {
+    int handle = 0;
+    // "putFile" or "writeToFile", after the methods that started it.
+    std::string type;
+    std::string app_name;
+    std::string bucket;
+    std::string path;
+    std::string file_path;
+    // The file the ResumableUpload session is persisted in, if any.
+    std::string session_file;
+    int64_t bytes_transferred = 0;
+    int64_t total_bytes = 0;
+  };
+
+  static StorageTransferJournal& GetInstance();
+
+  // Reads the transfers left by previous runs. Only the first call does so.
+  void Load();
+
+  void Add(const Entry& entry);
+  void SetSessionFile(int handle, const std::string& session_file);
+  // Persists the progress once it has advanced enough since the last time.
+  void UpdateProgress(int handle, int64_t bytes_transferred,
+                      int64_t total_bytes);
+  void Remove(int handle);
+
+  // The transfers previous runs left unfinished.
+  std::vector<Entry> GetInterrupted();
+  void ClearInterrupted();
+
+  // A value with one map per entry, also telling whether an upload can be
+  // resumed. Written straight into the reply, so |entries| must outlive the
+  // call sending it.
+  static flutter::EncodableValue GetEntriesPayload(
+      const std::vector<Entry>& entries);
+
+ private:
+  struct Record {
+    Entry entry;
+    std::string file;
+    int64_t saved_bytes;
+  };
+
+  StorageTransferJournal();
+  StorageTransferJournal(const StorageTransferJournal&) = delete;
+  void operator=(const StorageTransferJournal&) = delete;
+
+  // The following must be called with |mutex_| held.
+  bool EnsureDirectory();
+  void Save(Record& record);
+
+  std::mutex mutex_;
+  // Tells the entries of this run from those of previous ones.
+  std::string run_id_;
+  std::string directory_;
+  bool loaded_{false};
+  std::unordered_map<int, Record> records_;
+  std::vector<Record> interrupted_;
+};
+
+#endif  // FLUTTER_PLUGIN_FIREBASE_STORAGE_JOURNAL_H_
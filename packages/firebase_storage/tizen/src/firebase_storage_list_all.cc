@@ -0,0 +1,111 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "firebase_storage_list_all.h"
+
+#include <vector>
+
+std::shared_ptr<StorageListAllOperation> StorageListAllOperation::Create(
+    firebase::storage::StorageReference reference, Options options,
+    BatchCallback on_batch, CompletionCallback on_complete) {
+  return std::shared_ptr<StorageListAllOperation>(new StorageListAllOperation(
+      std::move(reference), std::move(options), std::move(on_batch),
+      std::move(on_complete)));
+}
+
+StorageListAllOperation::StorageListAllOperation(
+    firebase::storage::StorageReference reference, Options options,
+    BatchCallback on_batch, CompletionCallback on_complete)
+    : root_(std::move(reference)),
+      options_(std::move(options)),
+      on_batch_(std::move(on_batch)),
+      on_complete_(std::move(on_complete)) {
+  if (options_.max_concurrency == 0) {
+    options_.max_concurrency = 1;
+  }
+}
+
+void StorageListAllOperation::Start() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.push_back(Page{root_, ""});
+  }
+  RequestPages();
+}
+
+void StorageListAllOperation::RequestPages() {
+  std::vector<Page> pages;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (!failed_ && !pending_.empty() &&
+           in_flight_ < options_.max_concurrency) {
+      pages.push_back(std::move(pending_.front()));
+      pending_.pop_front();
+      in_flight_++;
+    }
+  }
+
+  // The futures may complete synchronously, so |mutex_| must not be held.
+  auto self = shared_from_this();
+  for (auto& page : pages) {
+    auto reference = page.reference;
+    page.reference.List(options_.page_size, page.page_token)
+        .OnCompletion(
+            [self, reference](
+                const firebase::Future<firebase::storage::ListResult>&
+                    result) { self->OnPage(reference, result); });
+  }
+}
+
+void StorageListAllOperation::OnPage(
+    const firebase::storage::StorageReference& reference,
+    const firebase::Future<firebase::storage::ListResult>& result) {
+  // The callbacks are called with |mutex_| held, so that no batch can be
+  // delivered after the completion.
+  std::unique_lock<std::mutex> lock(mutex_);
+  in_flight_--;
+  if (failed_) {
+    return;
+  }
+  if (result.error() != firebase::storage::Error::kErrorNone) {
+    failed_ = true;
+    pending_.clear();
+    on_complete_(result.error(), flutter::EncodableList(),
+                 flutter::EncodableList());
+    return;
+  }
+
+  const auto& list_result = *result.result();
+  for (const auto& item : list_result.GetItems()) {
+    items_.emplace_back(item.full_path());
+  }
+  for (const auto& prefix : list_result.GetPrefixes()) {
+    prefixes_.emplace_back(prefix.full_path());
+    if (options_.recursive) {
+      pending_.push_back(Page{prefix, ""});
+    }
+  }
+  // The next page of a reference goes first, so that its listing is
+  // finished before the ones it led to are started.
+  if (!list_result.GetPageToken().empty()) {
+    pending_.push_front(Page{reference, list_result.GetPageToken()});
+  }
+
+  if (pending_.empty() && in_flight_ == 0) {
+    on_complete_(firebase::storage::Error::kErrorNone, std::move(items_),
+                 std::move(prefixes_));
+    return;
+  }
+  if (options_.batch_size > 0 &&
+      items_.size() + prefixes_.size() >= options_.batch_size) {
+    flutter::EncodableList items;
+    flutter::EncodableList prefixes;
+    items.swap(items_);
+    prefixes.swap(prefixes_);
+    on_batch_(std::move(items), std::move(prefixes));
+  }
+  lock.unlock();
+
+  RequestPages();
+}
@@ -0,0 +1,79 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_PLUGIN_FIREBASE_STORAGE_LIST_ALL_H_
+#define FLUTTER_PLUGIN_FIREBASE_STORAGE_LIST_ALL_H_
+
+#include <flutter/encodable_value.h>
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "firebase/storage.h"
+
+// Lists everything under a reference by paging through
+// StorageReference::List, optionally descending into the prefixes it finds.
+// Up to |max_concurrency| pages are requested at once.
+class StorageListAllOperation
+    : public std::enable_shared_from_this<StorageListAllOperation> {
+ public:
+  struct Options {
+    bool recursive = false;
+    size_t max_concurrency = 4;
+    int32_t page_size = 1000;
+    // If non-zero, the results are handed to the batch callback whenever
+    // this many have been collected, instead of all at once on completion.
+    size_t batch_size = 0;
+  };
+
+  // Called with the full paths of the items and prefixes listed since the
+  // last call.
+  using BatchCallback = std::function<void(flutter::EncodableList&& items,
+                                           flutter::EncodableList&& prefixes)>;
+  // Called once with one of firebase::storage::Error, and on success with
+  // the results not handed to the batch callback.
+  using CompletionCallback = std::function<void(
+      int error, flutter::EncodableList&& items,
+      flutter::EncodableList&& prefixes)>;
+
+  static std::shared_ptr<StorageListAllOperation> Create(
+      firebase::storage::StorageReference reference, Options options,
+      BatchCallback on_batch, CompletionCallback on_complete);
+
+  void Start();
+
+ private:
+  struct Page {
+    firebase::storage::StorageReference reference;
+    std::string page_token;
+  };
+
+  StorageListAllOperation(firebase::storage::StorageReference reference,
+                          Options options, BatchCallback on_batch,
+                          CompletionCallback on_complete);
+
+  // Requests pages while fewer than |max_concurrency| are in flight.
+  void RequestPages();
+  void OnPage(const firebase::storage::StorageReference& reference,
+              const firebase::Future<firebase::storage::ListResult>& result);
+
+  firebase::storage::StorageReference root_;
+  Options options_;
+  BatchCallback on_batch_;
+  CompletionCallback on_complete_;
+
+  std::mutex mutex_;
+  std::deque<Page> pending_;
+  size_t in_flight_{0};
+  bool failed_{false};
+  flutter::EncodableList items_;
+  flutter::EncodableList prefixes_;
+};
+
+#endif  // FLUTTER_PLUGIN_FIREBASE_STORAGE_LIST_ALL_H_
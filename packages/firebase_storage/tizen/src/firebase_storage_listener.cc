@@ -7,23 +7,177 @@
 #include <flutter/method_channel.h>
 
 #include <memory>
+#include <vector>
+
+#include "firebase_storage_journal.h"
+#include "firebase_storage_stats.h"
+#include "firebase_storage_task.h"
 
 StorageListener::StorageListener(const utils::StorageTaskData& task_data,
                                  const std::shared_ptr<FlMethodChannel> channel)
-    : task_data_(task_data), channel_(std::move(channel)) {}
+    : task_data_(task_data),
+      channel_(std::move(channel)),
+      rate_limiter_(task_data.app_name) {}
 
 void StorageListener::OnPaused(firebase::storage::Controller* controller) {
-  channel_->InvokeMethod(
-      "Task#onPaused",
-      std::make_unique<flutter::EncodableValue>(
-          utils::GetTaskEventValue(task_data_, controller->bytes_transferred(),
-                                   controller->total_byte_count())));
+  SendPaused(controller->bytes_transferred(), controller->total_byte_count());
 }
 
 void StorageListener::OnProgress(firebase::storage::Controller* controller) {
-  channel_->InvokeMethod(
-      "Task#onProgress",
-      std::make_unique<flutter::EncodableValue>(
-          utils::GetTaskEventValue(task_data_, controller->bytes_transferred(),
-                                   controller->total_byte_count())));
+  // The SDK gives no other hook into the transfer, so the limit is only
+  // approximate. See TransferRateLimiter.
+  rate_limiter_.Throttle(controller->bytes_transferred());
+  SendProgress(controller->bytes_transferred(),
+               controller->total_byte_count());
+}
+
+void StorageListener::SendPaused(int64_t bytes_transferred,
+                                 int64_t total_bytes) {
+  TransferStats::GetInstance().OnPaused(task_data_.handle);
+  DiscardProgress();
+  channel_->InvokeMethod("Task#onPaused",
+                         std::make_unique<flutter::EncodableValue>(
+                             utils::GetTaskEventPayload(
+                                 task_data_, bytes_transferred, total_bytes)));
+}
+
+void StorageListener::SendProgress(int64_t bytes_transferred,
+                                   int64_t total_bytes) {
+  TransferStats::GetInstance().OnProgress(task_data_.handle,
+                                          bytes_transferred, total_bytes);
+  if (journaled_) {
+    StorageTransferJournal::GetInstance().UpdateProgress(
+        task_data_.handle, bytes_transferred, total_bytes);
+  }
+  if (!ShouldSendProgress(bytes_transferred, total_bytes) ||
+      ProgressAggregator::GetInstance().Add(task_data_, bytes_transferred,
+                                            total_bytes)) {
+    return;
+  }
+  channel_->InvokeMethod("Task#onProgress",
+                         std::make_unique<flutter::EncodableValue>(
+                             utils::GetTaskEventPayload(
+                                 task_data_, bytes_transferred, total_bytes)));
+}
+
+void StorageListener::SetProgressThrottle(std::chrono::milliseconds interval,
+                                          int64_t min_bytes) {
+  std::lock_guard<std::mutex> lock(progress_mutex_);
+  progress_interval_ = interval;
+  progress_min_bytes_ = min_bytes;
+}
+
+void StorageListener::DiscardProgress() {
+  ProgressAggregator::GetInstance().Remove(task_data_.handle);
+}
+
+bool StorageListener::ShouldSendProgress(int64_t bytes_transferred,
+                                         int64_t total_bytes) {
+  std::lock_guard<std::mutex> lock(progress_mutex_);
+  auto now = std::chrono::steady_clock::now();
+  bool is_first = last_progress_bytes_ < 0;
+  bool is_last = total_bytes > 0 && bytes_transferred >= total_bytes;
+  if (!is_first && !is_last &&
+      (now - last_progress_time_ < progress_interval_ ||
+       bytes_transferred - last_progress_bytes_ < progress_min_bytes_)) {
+    return false;
+  }
+  last_progress_time_ = now;
+  last_progress_bytes_ = bytes_transferred;
+  return true;
+}
+
+ProgressAggregator& ProgressAggregator::GetInstance() {
+  static ProgressAggregator instance;
+  return instance;
+}
+
+ProgressAggregator::~ProgressAggregator() { Disable(); }
+
+void ProgressAggregator::Enable(std::shared_ptr<FlMethodChannel> channel,
+                                std::chrono::milliseconds interval) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  channel_ = std::move(channel);
+  interval_ = interval;
+  if (!enabled_) {
+    enabled_ = true;
+    thread_ = std::thread(&ProgressAggregator::Run, this);
+  }
+  cv_.notify_all();
+}
+
+void ProgressAggregator::Disable() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!enabled_) {
+      return;
+    }
+    enabled_ = false;
+    cv_.notify_all();
+  }
+  thread_.join();
+}
+
+bool ProgressAggregator::Add(const utils::StorageTaskData& task_data,
+                             int64_t bytes_transferred, int64_t total_bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!enabled_) {
+    return false;
+  }
+  pending_[task_data.handle] =
+      utils::TaskProgress{task_data, bytes_transferred, total_bytes};
+  return true;
+}
+
+void ProgressAggregator::Remove(int handle) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  pending_.erase(handle);
+  // The batch being sent may contain the task.
+  sent_cv_.wait(lock, [this] { return !sending_; });
+}
+
+void ProgressAggregator::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    bool stopping =
+        cv_.wait_for(lock, interval_, [this] { return !enabled_; });
+    if (!pending_.empty()) {
+      std::vector<utils::TaskProgress> progress;
+      progress.reserve(pending_.size());
+      for (auto& entry : pending_) {
+        progress.push_back(std::move(entry.second));
+      }
+      pending_.clear();
+      auto channel = channel_;
+
+      // Sent without |mutex_|, so that the tasks can queue more progress
+      // meanwhile.
+      sending_ = true;
+      lock.unlock();
+      channel->InvokeMethod("Task#onProgressBatch",
+                            std::make_unique<flutter::EncodableValue>(
+                                utils::GetTaskProgressBatchPayload(progress)));
+      lock.lock();
+      sending_ = false;
+      sent_cv_.notify_all();
+    }
+    if (stopping) {
+      break;
+    }
+  }
+}
+
+void StorageStreamListener::OnProgress(
+    firebase::storage::Controller* controller) {
+  GetRateLimiter()->Throttle(controller->bytes_transferred());
+  TransferStats::GetInstance().OnProgress(GetStorageTaskData().handle,
+                                          controller->bytes_transferred(),
+                                          controller->total_byte_count());
+  task_->OnDataAvailable(controller->bytes_transferred());
+}
+
+void StorageChecksumListener::OnProgress(
+    firebase::storage::Controller* controller) {
+  on_transferred_(controller->bytes_transferred());
+  StorageListener::OnProgress(controller);
 }
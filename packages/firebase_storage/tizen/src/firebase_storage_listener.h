@@ -5,7 +5,18 @@
 #ifndef FLUTTER_PLUGIN_FIREBASE_STORAGE_LISTENER_H_
 #define FLUTTER_PLUGIN_FIREBASE_STORAGE_LISTENER_H_
 
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
 #include "firebase/storage.h"
+#include "firebase_storage_rate_limit.h"
 #include "firebase_storage_utils.h"
 #include "flutter_types.hpp"
 
@@ -17,11 +28,118 @@ class StorageListener : public firebase::storage::Listener {
   void OnPaused(firebase::storage::Controller* controller) override;
   void OnProgress(firebase::storage::Controller* controller) override;
 
+  // Same as above, for transfers that do not run through the SDK.
+  void SendPaused(int64_t bytes_transferred, int64_t total_bytes);
+  void SendProgress(int64_t bytes_transferred, int64_t total_bytes);
+
   const utils::StorageTaskData& GetStorageTaskData() { return task_data_; }
 
+  // Applied to the transfers reporting through OnProgress().
+  TransferRateLimiter* GetRateLimiter() { return &rate_limiter_; }
+
+  // Drops progress events sent less than |interval| or |min_bytes| after the
+  // last one. The first event and the one completing the transfer are always
+  // sent. Nothing is dropped unless this is called.
+  void SetProgressThrottle(std::chrono::milliseconds interval,
+                           int64_t min_bytes);
+
+  // Whether the progress is also recorded in the StorageTransferJournal.
+  void SetJournaled(bool journaled) { journaled_ = journaled; }
+
+  // Drops the progress not yet sent by the ProgressAggregator. Must be called
+  // before the task reports its outcome, which no progress may follow.
+  void DiscardProgress();
+
  private:
+  bool ShouldSendProgress(int64_t bytes_transferred, int64_t total_bytes);
+
   utils::StorageTaskData task_data_;
   std::shared_ptr<FlMethodChannel> channel_;
+  bool journaled_{false};
+  TransferRateLimiter rate_limiter_;
+
+  std::mutex progress_mutex_;
+  std::chrono::milliseconds progress_interval_{0};
+  int64_t progress_min_bytes_{0};
+  std::chrono::steady_clock::time_point last_progress_time_;
+  int64_t last_progress_bytes_{-1};
+};
+
+// Coalesces the progress of all tasks into a single Task#onProgressBatch
+// event per interval, carrying the latest progress of each task that made
+// any since the last batch. Disabled by default.
+class ProgressAggregator {
+ public:
+  static ProgressAggregator& GetInstance();
+
+  ~ProgressAggregator();
+
+  void Enable(std::shared_ptr<FlMethodChannel> channel,
+              std::chrono::milliseconds interval);
+  void Disable();
+
+  // Queues the progress of a task for the next batch. Returns false if
+  // disabled, in which case the caller sends the event itself.
+  bool Add(const utils::StorageTaskData& task_data, int64_t bytes_transferred,
+           int64_t total_bytes);
+
+  // Drops the queued progress of |handle|. Once this returns, no batch
+  // containing it will be sent. Waits for the batch being sent, if any.
+  void Remove(int handle);
+
+ private:
+  ProgressAggregator() = default;
+  ProgressAggregator(const ProgressAggregator&) = delete;
+  void operator=(const ProgressAggregator&) = delete;
+
+  void Run();
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::thread thread_;
+  bool enabled_{false};
+  // Set while a batch is sent, which happens without |mutex_| held.
+  bool sending_{false};
+  std::condition_variable sent_cv_;
+  std::shared_ptr<FlMethodChannel> channel_;
+  std::chrono::milliseconds interval_;
+  std::map<int, utils::TaskProgress> pending_;
+};
+
+class StorageStreamDataTask;
+
+// Hands the download progress over to a StorageStreamDataTask instead of
+// reporting it to Dart, which only sees the chunks.
+class StorageStreamListener : public StorageListener {
+ public:
+  StorageStreamListener(const utils::StorageTaskData& task_data,
+                        const std::shared_ptr<FlMethodChannel> channel,
+                        StorageStreamDataTask* task)
+      : StorageListener(task_data, channel), task_(task) {}
+
+  void OnPaused(firebase::storage::Controller* /*controller*/) override {}
+  void OnProgress(firebase::storage::Controller* controller) override;
+
+ private:
+  StorageStreamDataTask* task_;
+};
+
+// Lets a task checksum what has been transferred so far before reporting the
+// progress.
+class StorageChecksumListener : public StorageListener {
+ public:
+  using TransferredCallback = std::function<void(int64_t bytes_transferred)>;
+
+  StorageChecksumListener(const utils::StorageTaskData& task_data,
+                          const std::shared_ptr<FlMethodChannel> channel,
+                          TransferredCallback on_transferred)
+      : StorageListener(task_data, channel),
+        on_transferred_(std::move(on_transferred)) {}
+
+  void OnProgress(firebase::storage::Controller* controller) override;
+
+ private:
+  TransferredCallback on_transferred_;
 };
 
 #endif
@@ -0,0 +1,71 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "firebase_storage_mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "log.h"
+
+namespace {
+
+size_t GetPageSize() {
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return page_size;
+}
+
+}  // namespace
+
+std::shared_ptr<MappedFile> MappedFile::Open(const std::string& file_path) {
+  int fd = open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return nullptr;
+  }
+
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode)) {
+    close(fd);
+    return nullptr;
+  }
+
+  void* data = nullptr;
+  size_t size = static_cast<size_t>(file_stat.st_size);
+  if (size > 0) {
+    data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  // The mapping outlives the descriptor.
+  close(fd);
+  if (data == MAP_FAILED) {
+    LOG_ERROR("Failed to map %s", file_path.c_str());
+    return nullptr;
+  }
+  if (data) {
+    // Uploads read the file once, from start to end.
+    madvise(data, size, MADV_SEQUENTIAL);
+  }
+
+  return std::shared_ptr<MappedFile>(new MappedFile(
+      static_cast<const uint8_t*>(data), size, file_stat.st_mtime));
+}
+
+MappedFile::~MappedFile() {
+  if (data_) {
+    munmap(const_cast<uint8_t*>(data_), size_);
+  }
+}
+
+void MappedFile::Prefetch(int64_t offset, size_t size) const {
+  if (!data_ || offset < 0 || static_cast<size_t>(offset) >= size_) {
+    return;
+  }
+  // madvise() takes a page aligned address.
+  size_t begin = static_cast<size_t>(offset) & ~(GetPageSize() - 1);
+  size_t end = std::min(size_, static_cast<size_t>(offset) + size);
+  madvise(const_cast<uint8_t*>(data_) + begin, end - begin, MADV_WILLNEED);
+}
@@ -0,0 +1,44 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_PLUGIN_FIREBASE_STORAGE_MAPPED_FILE_H_
+#define FLUTTER_PLUGIN_FIREBASE_STORAGE_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// A file mapped read-only into memory, so that an upload can hash and send
+// it without copying it. The file must not be truncated while it is mapped:
+// reading the pages it lost raises SIGBUS.
+class MappedFile {
+ public:
+  // Returns nullptr if the file cannot be opened or mapped.
+  static std::shared_ptr<MappedFile> Open(const std::string& file_path);
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  // nullptr if the file is empty.
+  const uint8_t* data() const { return data_; }
+  size_t size() const { return size_; }
+  int64_t mtime() const { return mtime_; }
+
+  // Asks the kernel to read [offset, offset + size) in the background, ahead
+  // of its use.
+  void Prefetch(int64_t offset, size_t size) const;
+
+ private:
+  MappedFile(const uint8_t* data, size_t size, int64_t mtime)
+      : data_(data), size_(size), mtime_(mtime) {}
+
+  const uint8_t* data_;
+  size_t size_;
+  int64_t mtime_;
+};
+
+#endif  // FLUTTER_PLUGIN_FIREBASE_STORAGE_MAPPED_FILE_H_
@@ -0,0 +1,106 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "firebase_storage_metadata_batch.h"
+
+#include <utility>
+
+#include "common/payload.h"
+#include "firebase_storage_error.h"
+#include "firebase_storage_utils.h"
+
+std::shared_ptr<StorageMetadataBatchOperation>
+StorageMetadataBatchOperation::Create(firebase::storage::Storage* storage,
+                                      std::vector<Item> items,
+                                      size_t max_concurrency,
+                                      CompletionCallback on_complete) {
+  return std::shared_ptr<StorageMetadataBatchOperation>(
+      new StorageMetadataBatchOperation(storage, std::move(items),
+                                        max_concurrency,
+                                        std::move(on_complete)));
+}
+
+StorageMetadataBatchOperation::StorageMetadataBatchOperation(
+    firebase::storage::Storage* storage, std::vector<Item> items,
+    size_t max_concurrency, CompletionCallback on_complete)
+    : storage_(storage),
+      items_(std::move(items)),
+      max_concurrency_(max_concurrency > 0 ? max_concurrency : 1),
+      on_complete_(std::move(on_complete)) {}
+
+void StorageMetadataBatchOperation::Start() {
+  if (items_.empty()) {
+    on_complete_(items_);
+    return;
+  }
+  SendRequests();
+}
+
+flutter::EncodableValue StorageMetadataBatchOperation::GetResultPayload(
+    const std::vector<Item>& items) {
+  return MakePayload([&items](PayloadWriter& writer) {
+    writer.WriteList(items.size());
+    for (const auto& item : items) {
+      writer.WriteMap(2);
+      writer.WriteEntry("path", item.path);
+      if (item.result.has_value()) {
+        writer.WriteString("metadata");
+        utils::WriteMetadata(writer, &item.result.value());
+      } else {
+        FirebaseStorageError error(item.error);
+        writer.WriteString("error");
+        writer.WriteMap(2);
+        writer.WriteEntry("code", error.GetCodeString());
+        writer.WriteEntry("message", error.GetMessage());
+      }
+    }
+  });
+}
+
+void StorageMetadataBatchOperation::SendRequests() {
+  std::vector<size_t> indices;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (next_ < items_.size() && in_flight_ < max_concurrency_) {
+      indices.push_back(next_++);
+      in_flight_++;
+    }
+  }
+
+  // The futures may complete synchronously, so |mutex_| must not be held.
+  auto self = shared_from_this();
+  for (size_t index : indices) {
+    Item& item = items_[index];
+    auto reference = storage_->GetReference(item.path.c_str());
+    auto future = item.update.has_value()
+                      ? reference.UpdateMetadata(item.update.value())
+                      : reference.GetMetadata();
+    future.OnCompletion(
+        [self, index](
+            const firebase::Future<firebase::storage::Metadata>& result) {
+          self->OnResult(index, result);
+        });
+  }
+}
+
+void StorageMetadataBatchOperation::OnResult(
+    size_t index, const firebase::Future<firebase::storage::Metadata>& result) {
+  bool finished;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Item& item = items_[index];
+    item.error = result.error();
+    if (item.error == firebase::storage::Error::kErrorNone) {
+      item.result = *result.result();
+    }
+    in_flight_--;
+    finished = ++completed_ == items_.size();
+  }
+
+  if (finished) {
+    on_complete_(items_);
+  } else {
+    SendRequests();
+  }
+}
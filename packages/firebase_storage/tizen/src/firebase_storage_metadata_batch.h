@@ -0,0 +1,71 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_PLUGIN_FIREBASE_STORAGE_METADATA_BATCH_H_
+#define FLUTTER_PLUGIN_FIREBASE_STORAGE_METADATA_BATCH_H_
+
+#include <flutter/encodable_value.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "firebase/storage.h"
+
+// Gets or updates the metadata of many objects of a bucket, with up to
+// |max_concurrency| requests in flight, and reports all outcomes at once.
+class StorageMetadataBatchOperation
+    : public std::enable_shared_from_this<StorageMetadataBatchOperation> {
+ public:
+  struct Item {
+    std::string path;
+    // The metadata to update the object with, or none to only get it.
+    std::optional<firebase::storage::Metadata> update;
+
+    // Set once the request has completed.
+    int error = 0;
+    std::optional<firebase::storage::Metadata> result;
+  };
+
+  // Called once all requests have completed, in the order of the items.
+  using CompletionCallback = std::function<void(const std::vector<Item>&)>;
+
+  static std::shared_ptr<StorageMetadataBatchOperation> Create(
+      firebase::storage::Storage* storage, std::vector<Item> items,
+      size_t max_concurrency, CompletionCallback on_complete);
+
+  void Start();
+
+  // A value with one map per item: {path, metadata} on success, and
+  // {path, error: {code, message}} on failure. Written straight into the
+  // reply, so |items| must outlive the call sending it.
+  static flutter::EncodableValue GetResultPayload(
+      const std::vector<Item>& items);
+
+ private:
+  StorageMetadataBatchOperation(firebase::storage::Storage* storage,
+                                std::vector<Item> items,
+                                size_t max_concurrency,
+                                CompletionCallback on_complete);
+
+  // Sends requests while fewer than |max_concurrency_| are in flight.
+  void SendRequests();
+  void OnResult(size_t index,
+                const firebase::Future<firebase::storage::Metadata>& result);
+
+  firebase::storage::Storage* storage_;
+  std::vector<Item> items_;
+  size_t max_concurrency_;
+  CompletionCallback on_complete_;
+
+  std::mutex mutex_;
+  size_t next_{0};
+  size_t in_flight_{0};
+  size_t completed_{0};
+};
+
+#endif  // FLUTTER_PLUGIN_FIREBASE_STORAGE_METADATA_BATCH_H_
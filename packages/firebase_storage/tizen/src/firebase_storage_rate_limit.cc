@@ -0,0 +1,75 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "firebase_storage_rate_limit.h"
+
+#include <algorithm>
+#include <thread>
+#include <unordered_map>
+
+std::shared_ptr<TokenBucket> TokenBucket::ForApp(const std::string& app_name) {
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::shared_ptr<TokenBucket>> buckets;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& bucket = buckets[app_name];
+  if (!bucket) {
+    bucket = std::make_shared<TokenBucket>();
+  }
+  return bucket;
+}
+
+void TokenBucket::SetRate(int64_t bytes_per_second) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (rate_ == 0) {
+    // Starts with a full bucket.
+    tokens_ = static_cast<double>(bytes_per_second);
+    last_time_ = std::chrono::steady_clock::now();
+  }
+  rate_ = bytes_per_second;
+  tokens_ = std::min(tokens_, static_cast<double>(rate_));
+}
+
+std::chrono::nanoseconds TokenBucket::Take(int64_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (rate_ <= 0) {
+    return std::chrono::nanoseconds(0);
+  }
+
+  auto now = std::chrono::steady_clock::now();
+  std::chrono::duration<double> elapsed = now - last_time_;
+  last_time_ = now;
+  tokens_ = std::min(tokens_ + elapsed.count() * rate_,
+                     static_cast<double>(rate_));
+  tokens_ -= static_cast<double>(bytes);
+  if (tokens_ >= 0) {
+    return std::chrono::nanoseconds(0);
+  }
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double>(-tokens_ / rate_));
+}
+
+TransferRateLimiter::TransferRateLimiter(const std::string& app_name)
+    : app_bucket_(TokenBucket::ForApp(app_name)) {}
+
+void TransferRateLimiter::SetRate(int64_t bytes_per_second) {
+  task_bucket_.SetRate(bytes_per_second);
+}
+
+void TransferRateLimiter::Throttle(int64_t bytes_transferred) {
+  int64_t bytes;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bytes = std::max<int64_t>(bytes_transferred - last_bytes_, 0);
+    last_bytes_ = bytes_transferred;
+  }
+  if (bytes == 0) {
+    return;
+  }
+
+  auto wait = std::max(task_bucket_.Take(bytes), app_bucket_->Take(bytes));
+  if (wait.count() > 0) {
+    std::this_thread::sleep_for(wait);
+  }
+}
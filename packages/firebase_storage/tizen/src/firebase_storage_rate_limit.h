@@ -0,0 +1,63 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_PLUGIN_FIREBASE_STORAGE_RATE_LIMIT_H_
+#define FLUTTER_PLUGIN_FIREBASE_STORAGE_RATE_LIMIT_H_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Limits a byte rate, allowing bursts of up to one second worth of bytes.
+// Bytes taken beyond the budget are owed, so concurrent takers share the
+// rate.
+class TokenBucket {
+ public:
+  // The bucket of all transfers of the app |app_name|.
+  static std::shared_ptr<TokenBucket> ForApp(const std::string& app_name);
+
+  // |bytes_per_second| of 0 removes the limit.
+  void SetRate(int64_t bytes_per_second);
+
+  // Takes |bytes| and returns how long the taker has to wait for them to be
+  // within the rate.
+  std::chrono::nanoseconds Take(int64_t bytes);
+
+ private:
+  std::mutex mutex_;
+  int64_t rate_{0};
+  double tokens_{0};
+  std::chrono::steady_clock::time_point last_time_;
+};
+
+// Slows a transfer down to the rate limits of its task and of its app, by
+// blocking the calling thread until the bytes transferred are within both.
+//
+// Resumable uploads call Throttle() before sending each chunk, so their rate
+// is held to the limit. Transfers made by the SDK can only be held back in
+// their progress callbacks, which the SDK makes at its own pace while it
+// keeps transferring, so their limit is approximate: it caps the average
+// rate over the transfer rather than the rate at any moment.
+class TransferRateLimiter {
+ public:
+  explicit TransferRateLimiter(const std::string& app_name);
+
+  // Limits the task alone. Its app is limited with TokenBucket::ForApp().
+  void SetRate(int64_t bytes_per_second);
+
+  // |bytes_transferred| is the total so far. A total lower than the last one
+  // means that the transfer started over, e.g. to retry a chunk.
+  void Throttle(int64_t bytes_transferred);
+
+ private:
+  std::shared_ptr<TokenBucket> app_bucket_;
+  TokenBucket task_bucket_;
+
+  std::mutex mutex_;
+  int64_t last_bytes_{0};
+};
+
+#endif  // FLUTTER_PLUGIN_FIREBASE_STORAGE_RATE_LIMIT_H_
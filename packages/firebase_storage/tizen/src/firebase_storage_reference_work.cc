@@ -0,0 +1,124 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "firebase_storage_reference_work.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "firebase_storage_stats.h"
+#include "firebase_storage_utils.h"
+
+namespace {
+
+// The works that identical calls attach to, by key.
+struct InFlightWorks {
+  std::mutex mutex;
+  std::unordered_map<std::string, std::weak_ptr<StorageReferenceWork>> works;
+};
+
+InFlightWorks& GetInFlightWorks() {
+  static InFlightWorks instance;
+  return instance;
+}
+
+}  // namespace
+
+std::shared_ptr<StorageReferenceWork> StorageReferenceWork::Create(
+    const char* method_name,
+    std::unique_ptr<MethodCallArguments>&& args,
+    std::unique_ptr<FlMethodResult>&& result) {
+  auto reference = utils::GetStorageReference(args.get());
+  return std::make_shared<StorageReferenceWork>(
+      method_name, std::move(reference), std::move(args), std::move(result));
+}
+
+StorageReferenceWork::StorageReferenceWork(
+    const char* method_name,
+    firebase::storage::StorageReference&& reference,
+    std::unique_ptr<MethodCallArguments>&& args,
+    std::unique_ptr<FlMethodResult>&& result)
+    : method_name_(method_name),
+      reference_(std::move(reference)),
+      method_call_args_(std::move(args)),
+      method_result_(std::move(result)),
+      start_(std::chrono::steady_clock::now()) {}
+
+bool StorageReferenceWork::JoinInFlight(const std::string& key) {
+  auto& in_flight = GetInFlightWorks();
+  std::lock_guard<std::mutex> lock(in_flight.mutex);
+  auto& entry = in_flight.works[key];
+  if (auto work = entry.lock()) {
+    work->attached_.push_back(shared_from_this());
+    // The reply is now up to |work|.
+    replied_ = true;
+    return true;
+  }
+  entry = weak_from_this();
+  in_flight_key_ = key;
+  return false;
+}
+
+void StorageReferenceWork::Success(const flutter::EncodableValue& result) {
+  // Encoding does not copy |result|, so the attached calls share it.
+  ReplyAll(true, [&result](FlMethodResult* method_result) {
+    method_result->Success(result);
+  });
+}
+
+void StorageReferenceWork::Success() {
+  ReplyAll(true,
+           [](FlMethodResult* method_result) { method_result->Success(); });
+}
+
+void StorageReferenceWork::Fail(int error_code) {
+  Fail(FirebaseStorageError(error_code));
+}
+
+void StorageReferenceWork::Fail(const FirebaseStorageError& error) {
+  auto code = error.GetCodeString();
+  auto message = error.GetMessage();
+
+  flutter::EncodableValue details(flutter::EncodableMap{
+      {flutter::EncodableValue("code"), flutter::EncodableValue(code)},
+      {flutter::EncodableValue("message"), flutter::EncodableValue(message)}});
+
+  ReplyAll(false, [&](FlMethodResult* method_result) {
+    method_result->Error(code, message, details);
+  });
+}
+
+void StorageReferenceWork::ReplyAll(
+    bool succeeded,
+    const std::function<void(FlMethodResult*)>& reply) {
+  if (replied_.exchange(true)) {
+    return;
+  }
+
+  // Stops identical calls from attaching.
+  std::vector<std::shared_ptr<StorageReferenceWork>> attached;
+  if (!in_flight_key_.empty()) {
+    auto& in_flight = GetInFlightWorks();
+    std::lock_guard<std::mutex> lock(in_flight.mutex);
+    in_flight.works.erase(in_flight_key_);
+    attached.swap(attached_);
+  }
+
+  auto now = std::chrono::steady_clock::now();
+  reply(method_result_.get());
+  TransferStats::GetInstance().OnOperation(
+      method_name_,
+      std::chrono::duration_cast<std::chrono::microseconds>(now - start_),
+      succeeded);
+  for (const auto& work : attached) {
+    reply(work->method_result_.get());
+    TransferStats::GetInstance().OnOperation(
+        work->method_name_,
+        std::chrono::duration_cast<std::chrono::microseconds>(now -
+                                                              work->start_),
+        succeeded);
+  }
+}
@@ -0,0 +1,93 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_PLUGIN_FIREBASE_STORAGE_REFERENCE_WORK_H_
+#define FLUTTER_PLUGIN_FIREBASE_STORAGE_REFERENCE_WORK_H_
+
+#include <flutter/encodable_value.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "firebase/future.h"
+#include "firebase/storage.h"
+#include "firebase_storage_error.h"
+#include "flutter_types.hpp"
+
+// A Reference#* call in flight: the reference it operates on, its arguments
+// and its result. The callbacks of the call share it, and it replies exactly
+// once, through Success() or Fail().
+class StorageReferenceWork
+    : public std::enable_shared_from_this<StorageReferenceWork> {
+ public:
+  // |method_name| must be a string literal; the work keeps the pointer.
+  // Throws like utils::GetStorageReference(), in which case |args| and
+  // |result| are left untouched.
+  static std::shared_ptr<StorageReferenceWork> Create(
+      const char* method_name,
+      std::unique_ptr<MethodCallArguments>&& args,
+      std::unique_ptr<FlMethodResult>&& result);
+
+  StorageReferenceWork(const char* method_name,
+                       firebase::storage::StorageReference&& reference,
+                       std::unique_ptr<MethodCallArguments>&& args,
+                       std::unique_ptr<FlMethodResult>&& result);
+
+  firebase::storage::StorageReference* GetStorageReference() {
+    return &reference_;
+  }
+
+  MethodCallArguments* GetMethodCallArguments() {
+    return method_call_args_.get();
+  }
+
+  // Attaches the work to an identical call in flight, as identified by
+  // |key|, and returns true if there is one. The work then gets the reply of
+  // that call, and replies of its own are ignored. Otherwise, identical calls
+  // attach to this work until it replies.
+  bool JoinInFlight(const std::string& key);
+
+  // Each of these also replies to the works attached to this one. Only the
+  // first reply of a work is sent.
+  void Success(const flutter::EncodableValue& result);
+  void Success();
+  void Fail(int error_code);
+  void Fail(const FirebaseStorageError& error);
+
+  // Replies with the outcome of |future|: calls |on_success| with the work
+  // and the future if it succeeded, and fails with its error otherwise.
+  template <typename T, typename OnSuccess>
+  void Complete(const firebase::Future<T>& future, OnSuccess on_success) {
+    future.OnCompletion([work = shared_from_this(), on_success](
+                            const firebase::Future<T>& completed) {
+      if (completed.error() == firebase::storage::Error::kErrorNone) {
+        on_success(work, completed);
+      } else {
+        work->Fail(completed.error());
+      }
+    });
+  }
+
+ private:
+  // Sends |reply| to the work and to the works attached to it, unless they
+  // have replied already, and records the latency of each call.
+  void ReplyAll(bool succeeded,
+                const std::function<void(FlMethodResult*)>& reply);
+
+  const char* method_name_;
+  firebase::storage::StorageReference reference_;
+  std::unique_ptr<MethodCallArguments> method_call_args_;
+  std::unique_ptr<FlMethodResult> method_result_;
+  std::chrono::steady_clock::time_point start_;
+  std::atomic<bool> replied_{false};
+  // Empty unless identical calls may attach to the work.
+  std::string in_flight_key_;
+  std::vector<std::shared_ptr<StorageReferenceWork>> attached_;
+};
+
+#endif  // FLUTTER_PLUGIN_FIREBASE_STORAGE_REFERENCE_WORK_H_
@@ -0,0 +1,337 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "firebase_storage_stats.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "common/payload.h"
+
+namespace {
+
+constexpr size_t kMaxCompletedTasks = 100;
+
+constexpr std::chrono::milliseconds kSampleInterval(250);
+
+const char* GetStatusString(TransferStats::Status status) {
+  switch (status) {
+    case TransferStats::kRunning:
+      return "running";
+    case TransferStats::kPaused:
+      return "paused";
+    case TransferStats::kSuccess:
+      return "success";
+    case TransferStats::kFailure:
+      return "failure";
+    case TransferStats::kCanceled:
+      return "canceled";
+  }
+  return "unknown";
+}
+
+// Bytes per second.
+double GetThroughput(int64_t bytes, std::chrono::milliseconds duration) {
+  return duration.count() > 0 ? bytes * 1000.0 / duration.count() : 0;
+}
+
+}  // namespace
+
+TransferStats& TransferStats::GetInstance() {
+  static TransferStats instance;
+  return instance;
+}
+
+void TransferStats::OnStart(const utils::StorageTaskData& task_data,
+                            const char* type) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Task& task = running_[task_data.handle];
+  task = Task();
+  task.task_data = task_data;
+  task.type = type;
+  task.start_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::system_clock::now().time_since_epoch())
+                        .count();
+  task.start = Clock::now();
+  task.sample_time = task.start;
+}
+
+void TransferStats::OnProgress(int handle, int64_t bytes_transferred,
+                               int64_t total_bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Task* task = Find(handle);
+  if (!task) {
+    return;
+  }
+
+  auto now = Clock::now();
+  if (task->first_byte_ms < 0 && bytes_transferred > 0) {
+    task->first_byte_ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - task->start)
+            .count();
+  }
+  if (task->status == kPaused) {
+    // The progress of a resumed transfer may come before OnResumed().
+    task->paused_duration +=
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            now - task->paused_since);
+    task->status = kRunning;
+    task->sample_time = now;
+    task->sample_bytes = bytes_transferred;
+  }
+  task->bytes_transferred = bytes_transferred;
+  task->total_bytes = total_bytes;
+
+  auto window = std::chrono::duration_cast<std::chrono::milliseconds>(
+      now - task->sample_time);
+  if (window >= kSampleInterval) {
+    task->peak_throughput =
+        std::max(task->peak_throughput,
+                 GetThroughput(bytes_transferred - task->sample_bytes, window));
+    task->sample_time = now;
+    task->sample_bytes = bytes_transferred;
+  }
+}
+
+void TransferStats::OnPaused(int handle) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Task* task = Find(handle);
+  if (task && task->status == kRunning) {
+    task->status = kPaused;
+    task->paused_since = Clock::now();
+  }
+}
+
+void TransferStats::OnResumed(int handle) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Task* task = Find(handle);
+  if (task && task->status == kPaused) {
+    auto now = Clock::now();
+    task->paused_duration +=
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            now - task->paused_since);
+    task->status = kRunning;
+    task->sample_time = now;
+    task->sample_bytes = task->bytes_transferred;
+  }
+}
+
+void TransferStats::OnRetry(int handle) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Task* task = Find(handle);
+  if (task) {
+    task->retries++;
+  }
+}
+
+void TransferStats::SetCanceling(int handle, bool canceling) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Task* task = Find(handle);
+  if (task) {
+    task->canceling = canceling;
+  }
+}
+
+void TransferStats::OnFinished(int handle, Status status) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = running_.find(handle);
+  if (it == running_.end()) {
+    return;
+  }
+
+  Task task = std::move(it->second);
+  running_.erase(it);
+  task.end = Clock::now();
+  if (task.status == kPaused) {
+    task.paused_duration +=
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            task.end - task.paused_since);
+  }
+  task.status = status == kFailure && task.canceling ? kCanceled : status;
+
+  AddToAggregate(task, aggregate_);
+  AddToAggregate(task, bucket_aggregates_[task.task_data.bucket]);
+  completed_.push_back(std::move(task));
+  if (completed_.size() > kMaxCompletedTasks) {
+    completed_.pop_front();
+  }
+}
+
+void TransferStats::OnOperation(std::string_view method_name,
+                                std::chrono::microseconds latency,
+                                bool succeeded) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = operations_.find(method_name);
+  if (iter == operations_.end()) {
+    iter = operations_.emplace(std::string(method_name), Operation()).first;
+  }
+  Operation& operation = iter->second;
+  operation.count++;
+  if (!succeeded) {
+    operation.failed++;
+  }
+  operation.total_latency += latency;
+  operation.max_latency = std::max(operation.max_latency, latency);
+}
+
+flutter::EncodableValue TransferStats::GetStatsValue() {
+  struct TaskSnapshot {
+    Task task;
+    std::chrono::milliseconds active_duration;
+  };
+
+  // The payload is written after this returns, so it gets a copy.
+  std::vector<TaskSnapshot> tasks;
+  Aggregate aggregate;
+  std::map<std::string, Aggregate> bucket_aggregates;
+  std::map<std::string, Operation, std::less<>> operations;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now = Clock::now();
+    tasks.reserve(completed_.size() + running_.size());
+    for (const auto& task : completed_) {
+      tasks.push_back(TaskSnapshot{task, GetActiveDuration(task, now)});
+    }
+    for (const auto& [handle, task] : running_) {
+      tasks.push_back(TaskSnapshot{task, GetActiveDuration(task, now)});
+    }
+    // Running tasks count as started in the aggregate.
+    aggregate = aggregate_;
+    aggregate.started += static_cast<int64_t>(running_.size());
+    bucket_aggregates = bucket_aggregates_;
+    operations = operations_;
+  }
+
+  return MakePayload([tasks = std::move(tasks), aggregate,
+                      bucket_aggregates = std::move(bucket_aggregates),
+                      operations = std::move(operations)](
+                         PayloadWriter& writer) {
+    auto write_aggregate = [&writer](const Aggregate& aggregate) {
+      writer.WriteMap(10);
+      writer.WriteEntry("started", aggregate.started);
+      writer.WriteEntry("succeeded", aggregate.succeeded);
+      writer.WriteEntry("failed", aggregate.failed);
+      writer.WriteEntry("canceled", aggregate.canceled);
+      writer.WriteEntry("bytesTransferred", aggregate.bytes_transferred);
+      writer.WriteEntry("retries", aggregate.retries);
+      writer.WriteEntry(
+          "activeDuration",
+          static_cast<int64_t>(aggregate.active_duration.count()));
+      writer.WriteEntry("averageThroughput",
+                        GetThroughput(aggregate.bytes_transferred,
+                                      aggregate.active_duration));
+      writer.WriteEntry("peakThroughput", aggregate.peak_throughput);
+      writer.WriteEntry(
+          "averageTimeToFirstByte",
+          aggregate.first_byte_count > 0
+              ? static_cast<double>(aggregate.first_byte_ms_sum) /
+                    aggregate.first_byte_count
+              : 0.0);
+    };
+
+    writer.WriteMap(4);
+    writer.WriteString("tasks");
+    writer.WriteList(tasks.size());
+    for (const auto& [task, active_duration] : tasks) {
+      writer.WriteMap(15);
+      writer.WriteEntry("handle", task.task_data.handle);
+      writer.WriteEntry("type", task.type);
+      writer.WriteEntry("appName", task.task_data.app_name);
+      writer.WriteEntry("bucket", task.task_data.bucket);
+      writer.WriteEntry("path", task.task_data.path);
+      writer.WriteEntry("status", GetStatusString(task.status));
+      writer.WriteEntry("startTime", task.start_time);
+      writer.WriteEntry("timeToFirstByte", task.first_byte_ms);
+      writer.WriteEntry("bytesTransferred", task.bytes_transferred);
+      writer.WriteEntry("totalBytes", task.total_bytes);
+      writer.WriteEntry("activeDuration",
+                        static_cast<int64_t>(active_duration.count()));
+      writer.WriteEntry("pausedDuration",
+                        static_cast<int64_t>(task.paused_duration.count()));
+      writer.WriteEntry("averageThroughput",
+                        GetThroughput(task.bytes_transferred, active_duration));
+      writer.WriteEntry("peakThroughput", task.peak_throughput);
+      writer.WriteEntry("retries", task.retries);
+    }
+
+    writer.WriteString("aggregate");
+    write_aggregate(aggregate);
+
+    writer.WriteString("buckets");
+    writer.WriteList(bucket_aggregates.size());
+    for (const auto& [bucket, bucket_aggregate] : bucket_aggregates) {
+      writer.WriteMap(2);
+      writer.WriteEntry("bucket", bucket);
+      writer.WriteString("stats");
+      write_aggregate(bucket_aggregate);
+    }
+
+    // Latencies are in milliseconds.
+    writer.WriteString("operations");
+    writer.WriteList(operations.size());
+    for (const auto& [method_name, operation] : operations) {
+      writer.WriteMap(5);
+      writer.WriteEntry("method", method_name);
+      writer.WriteEntry("count", operation.count);
+      writer.WriteEntry("failed", operation.failed);
+      writer.WriteEntry("averageLatency",
+                        operation.total_latency.count() / 1000.0 /
+                            operation.count);
+      writer.WriteEntry("maxLatency", operation.max_latency.count() / 1000.0);
+    }
+  });
+}
+
+void TransferStats::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  completed_.clear();
+  aggregate_ = Aggregate();
+  bucket_aggregates_.clear();
+  operations_.clear();
+}
+
+TransferStats::Task* TransferStats::Find(int handle) {
+  auto it = running_.find(handle);
+  return it == running_.end() ? nullptr : &it->second;
+}
+
+std::chrono::milliseconds TransferStats::GetActiveDuration(
+    const Task& task, Clock::time_point now) {
+  Clock::time_point end = task.status == kRunning || task.status == kPaused
+                              ? now
+                              : task.end;
+  auto paused = task.paused_duration;
+  if (task.status == kPaused) {
+    paused += std::chrono::duration_cast<std::chrono::milliseconds>(
+        now - task.paused_since);
+  }
+  return std::chrono::duration_cast<std::chrono::milliseconds>(end -
+                                                               task.start) -
+         paused;
+}
+
+void TransferStats::AddToAggregate(const Task& task, Aggregate& aggregate) {
+  aggregate.started++;
+  switch (task.status) {
+    case kSuccess:
+      aggregate.succeeded++;
+      break;
+    case kCanceled:
+      aggregate.canceled++;
+      break;
+    default:
+      aggregate.failed++;
+      break;
+  }
+  aggregate.bytes_transferred += task.bytes_transferred;
+  aggregate.retries += task.retries;
+  aggregate.active_duration += GetActiveDuration(task, task.end);
+  if (task.first_byte_ms >= 0) {
+    aggregate.first_byte_count++;
+    aggregate.first_byte_ms_sum += task.first_byte_ms;
+  }
+  aggregate.peak_throughput =
+      std::max(aggregate.peak_throughput, task.peak_throughput);
+}
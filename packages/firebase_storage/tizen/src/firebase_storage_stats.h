@@ -0,0 +1,122 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_PLUGIN_FIREBASE_STORAGE_STATS_H_
+#define FLUTTER_PLUGIN_FIREBASE_STORAGE_STATS_H_
+
+#include <flutter/encodable_value.h>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "firebase_storage_utils.h"
+
+// Collects the statistics of the transfers of all tasks: per task, those of
+// the running ones and of the last completed ones, and in aggregate, per
+// bucket and overall, those of all tasks since the last reset. Also collects
+// the latency of the other calls, per method.
+class TransferStats {
+ public:
+  enum Status {
+    kRunning,
+    kPaused,
+    kSuccess,
+    kFailure,
+    kCanceled,
+  };
+
+  static TransferStats& GetInstance();
+
+  void OnStart(const utils::StorageTaskData& task_data, const char* type);
+  void OnProgress(int handle, int64_t bytes_transferred, int64_t total_bytes);
+  void OnPaused(int handle);
+  void OnResumed(int handle);
+  void OnRetry(int handle);
+  // While a task is being canceled, its failure counts as a cancellation.
+  void SetCanceling(int handle, bool canceling);
+  // Only the first outcome reported counts, e.g. the cancellation of a task
+  // rather than the failure reported by the transfer it ended.
+  void OnFinished(int handle, Status status);
+
+  // Records a Reference#* call that replied after |latency|.
+  void OnOperation(std::string_view method_name,
+                   std::chrono::microseconds latency, bool succeeded);
+
+  // A map {tasks: [...], aggregate: {...}, buckets: [...], operations: [...]}.
+  flutter::EncodableValue GetStatsValue();
+  void Reset();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Task {
+    utils::StorageTaskData task_data;
+    std::string type;
+    Status status = kRunning;
+    bool canceling = false;
+    // Milliseconds since the epoch.
+    int64_t start_time = 0;
+    Clock::time_point start;
+    Clock::time_point end;
+    // -1 until the first byte is transferred.
+    int64_t first_byte_ms = -1;
+    int64_t bytes_transferred = 0;
+    int64_t total_bytes = 0;
+    std::chrono::milliseconds paused_duration{0};
+    Clock::time_point paused_since;
+    int retries = 0;
+    // The throughput is sampled over windows of at least kSampleInterval.
+    Clock::time_point sample_time;
+    int64_t sample_bytes = 0;
+    double peak_throughput = 0;
+  };
+
+  struct Aggregate {
+    int64_t started = 0;
+    int64_t succeeded = 0;
+    int64_t failed = 0;
+    int64_t canceled = 0;
+    int64_t bytes_transferred = 0;
+    int64_t retries = 0;
+    // Of the completed tasks, excluding the time they were paused.
+    std::chrono::milliseconds active_duration{0};
+    int64_t first_byte_count = 0;
+    int64_t first_byte_ms_sum = 0;
+    double peak_throughput = 0;
+  };
+
+  struct Operation {
+    int64_t count = 0;
+    int64_t failed = 0;
+    std::chrono::microseconds total_latency{0};
+    std::chrono::microseconds max_latency{0};
+  };
+
+  TransferStats() = default;
+  TransferStats(const TransferStats&) = delete;
+  void operator=(const TransferStats&) = delete;
+
+  // The following must be called with |mutex_| held.
+  Task* Find(int handle);
+  std::chrono::milliseconds GetActiveDuration(const Task& task,
+                                              Clock::time_point now);
+  void AddToAggregate(const Task& task, Aggregate& aggregate);
+
+  std::mutex mutex_;
+  std::unordered_map<int, Task> running_;
+  // The last completed tasks, the oldest first.
+  std::deque<Task> completed_;
+  Aggregate aggregate_;
+  std::map<std::string, Aggregate> bucket_aggregates_;
+  // Looked up without making a string of the method name.
+  std::map<std::string, Operation, std::less<>> operations_;
+};
+
+#endif  // FLUTTER_PLUGIN_FIREBASE_STORAGE_STATS_H_
@@ -4,40 +4,265 @@
 
 #include "firebase_storage_task.h"
 
+#include <fcntl.h>
 #include <flutter/method_channel.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
 #include <memory>
 #include <string>
 #include <thread>
 
+#include "common/payload.h"
 #include "firebase/app.h"
 #include "firebase/storage.h"
+#include "firebase_storage_cache.h"
 #include "firebase_storage_error.h"
+#include "firebase_storage_journal.h"
+#include "firebase_storage_stats.h"
 #include "log.h"
 
+namespace {
+
+constexpr char kStreamEventChannelNamePrefix[] =
+    "plugins.flutter.io/firebase_storage/taskStream/";
+
+constexpr int kDefaultChunkSize = 64 * 1024;
+constexpr int kDefaultPrefetchChunks = 4;
+
+// The download is paused once this many complete chunks are waiting for
+// credit, and resumed when half of them have been sent.
+constexpr size_t kMaxPendingChunks = 16;
+
+std::shared_ptr<StorageStreamDataTask> GetStreamDataTask(int handle) {
+  return std::dynamic_pointer_cast<StorageStreamDataTask>(
+      StorageTaskHandler::GetInstance().GetTask(handle));
+}
+
+}  // namespace
+
 StorageTaskHandler& StorageTaskHandler::GetInstance() {
   static StorageTaskHandler instance;
   return instance;
 }
 
 void StorageTaskHandler::AddTask(int handle,
-                                 std::unique_ptr<StorageTask> task) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  tasks_[handle] = std::move(task);
+                                 std::shared_ptr<StorageTask> task) {
+  Shard& shard = GetShard(handle);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  shard.tasks[handle] = std::move(task);
 }
 
-std::optional<StorageTask*> StorageTaskHandler::GetTask(int handle) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  auto it = tasks_.find(handle);
-  if (it == tasks_.end()) {
-    return std::nullopt;
+std::shared_ptr<StorageTask> StorageTaskHandler::GetTask(int handle) {
+  Shard& shard = GetShard(handle);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto it = shard.tasks.find(handle);
+  if (it == shard.tasks.end()) {
+    return nullptr;
   }
-  return (it->second).get();
+  return it->second;
 }
 
 void StorageTaskHandler::RemoveTask(int handle) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  tasks_.erase(handle);
+  std::shared_ptr<StorageTask> task;
+  Shard& shard = GetShard(handle);
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.tasks.find(handle);
+    if (it == shard.tasks.end()) {
+      return;
+    }
+    task = std::move(it->second);
+    shard.tasks.erase(it);
+  }
+  // The task may be destroyed here, outside of the lock.
+}
+
+StorageTaskHandler::Shard& StorageTaskHandler::GetShard(int handle) {
+  // Handles are sequential, so consecutive tasks land in different shards.
+  return shards_[static_cast<unsigned int>(handle) % kShardCount];
+}
+
+TransferScheduler& TransferScheduler::GetInstance() {
+  static TransferScheduler instance;
+  return instance;
+}
+
+TransferScheduler::TransferScheduler()
+    : max_transfers_(std::numeric_limits<size_t>::max()) {}
+
+void TransferScheduler::SetMaxConcurrentTransfers(size_t max_transfers) {
+  std::vector<StorageTask*> runnable;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_transfers_ = max_transfers > 0 ? max_transfers
+                                       : std::numeric_limits<size_t>::max();
+    runnable = TakeRunnable();
+  }
+  RunQueued(runnable);
+}
+
+void TransferScheduler::Submit(StorageTask* task, Priority priority) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Queued tasks are started whenever a slot frees up, so a free slot means
+    // that all of them are paused.
+    if (running_.size() >= max_transfers_) {
+      queues_[priority].push_back(QueuedTask{task, false});
+      return;
+    }
+    running_.insert(task);
+  }
+
+  try {
+    task->Start();
+  } catch (...) {
+    Remove(task);
+    throw;
+  }
+}
+
+void TransferScheduler::Remove(StorageTask* task) {
+  std::vector<StorageTask*> runnable;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_.erase(task) == 0) {
+      EraseQueued(task);
+      return;
+    }
+    runnable = TakeRunnable();
+  }
+  RunQueued(runnable);
+}
+
+// Tasks never return to a queue once started, so a task found in none is
+// controlled through the SDK. That happens without |mutex_|, as the SDK may
+// wait for its callbacks, which complete tasks and so take |mutex_| too.
+bool TransferScheduler::Pause(StorageTask* task) {
+  bool queued = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (QueuedTask* queued_task = FindQueued(task)) {
+      queued_task->paused = true;
+      queued = true;
+    }
+  }
+  if (!queued) {
+    return task->Pause();
+  }
+  task->GetListener()->SendPaused(0, 0);
+  return true;
+}
+
+bool TransferScheduler::Resume(StorageTask* task) {
+  bool queued = false;
+  std::vector<StorageTask*> runnable;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (QueuedTask* queued_task = FindQueued(task)) {
+      queued_task->paused = false;
+      queued = true;
+      runnable = TakeRunnable();
+    }
+  }
+  if (!queued) {
+    if (!task->Resume()) {
+      return false;
+    }
+    TransferStats::GetInstance().OnResumed(task->GetHandle());
+    return true;
+  }
+  RunQueued(runnable);
+  return true;
+}
+
+bool TransferScheduler::Cancel(StorageTask* task, bool* dequeued) {
+  {
+    // Dequeued in one go, so that the task cannot start in between.
+    std::lock_guard<std::mutex> lock(mutex_);
+    *dequeued = EraseQueued(task);
+  }
+  if (*dequeued) {
+    return true;
+  }
+
+  // The transfer may fail as canceled before Cancel() returns.
+  TransferStats::GetInstance().SetCanceling(task->GetHandle(), true);
+  if (!task->Cancel()) {
+    TransferStats::GetInstance().SetCanceling(task->GetHandle(), false);
+    return false;
+  }
+  return true;
+}
+
+TransferScheduler::QueuedTask* TransferScheduler::FindQueued(
+    StorageTask* task) {
+  for (auto& queue : queues_) {
+    for (auto& queued : queue) {
+      if (queued.task == task) {
+        return &queued;
+      }
+    }
+  }
+  return nullptr;
+}
+
+bool TransferScheduler::EraseQueued(StorageTask* task) {
+  for (auto& queue : queues_) {
+    for (auto it = queue.begin(); it != queue.end(); ++it) {
+      if (it->task == task) {
+        queue.erase(it);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+std::vector<StorageTask*> TransferScheduler::TakeRunnable() {
+  std::vector<StorageTask*> runnable;
+  for (auto& queue : queues_) {
+    for (auto it = queue.begin();
+         it != queue.end() && running_.size() < max_transfers_;) {
+      if (it->paused) {
+        ++it;
+        continue;
+      }
+      running_.insert(it->task);
+      runnable.push_back(it->task);
+      it = queue.erase(it);
+    }
+  }
+  return runnable;
+}
+
+void TransferScheduler::RunQueued(const std::vector<StorageTask*>& tasks) {
+  for (StorageTask* task : tasks) {
+    try {
+      task->Start();
+    } catch (const FirebaseStorageError& error) {
+      FailQueued(task, error);
+    } catch (const std::invalid_argument& error) {
+      FailQueued(task, FirebaseStorageError(
+                           FirebaseStorageError::Code::kInvalidArgument,
+                           error.what()));
+    }
+  }
+}
+
+// Reports what the plugin would have replied to the start call, had the task
+// run then.
+void TransferScheduler::FailQueued(StorageTask* task,
+                                   const FirebaseStorageError& error) {
+  auto message = error.GetMessage();
+  task->Fail(utils::GetTaskErrorEventValue(task->GetStorageTaskData(),
+                                           static_cast<int>(error.GetCode()),
+                                           message.c_str()),
+             message.c_str());
+  task->Complete();
 }
 
 StorageTask::StorageTask(Type type,
@@ -46,13 +271,46 @@ StorageTask::StorageTask(Type type,
     : type_(type), channel_(std::move(channel)), method_args_(std::move(args)) {
   auto path = method_args_->GetRequiredArg<std::string>("path");
 
+  // Files are put to the emulator without the SDK.
   storage_reference_ =
-      utils::GetStorage(method_args_.get())->GetReference(path);
+      (type == kPutFile ? utils::GetStorageIgnoringEmulator(method_args_.get())
+                        : utils::GetStorage(method_args_.get()))
+          ->GetReference(path);
   utils::StorageTaskData task_data{
       method_args_->GetRequiredArg<int>("handle"),
       method_args_->GetRequiredArg<std::string>("appName"), path,
       storage_reference_.bucket()};
-  listener_ = std::make_unique<StorageListener>(task_data, channel);
+  SetListener(std::make_unique<StorageListener>(task_data, channel));
+
+  int priority = method_args_->GetArg<int>("priority").value_or(
+      TransferScheduler::kNormal);
+  if (priority < 0 || priority >= TransferScheduler::kPriorityCount) {
+    throw std::invalid_argument("Invalid priority.");
+  }
+  priority_ = static_cast<TransferScheduler::Priority>(priority);
+}
+
+void StorageTask::SetListener(std::unique_ptr<StorageListener> listener) {
+  listener_ = std::move(listener);
+
+  auto progress_interval = method_args_->GetArg<int>("progressInterval");
+  auto progress_bytes = method_args_->GetArg<int>("progressBytes");
+  if (progress_interval.has_value() || progress_bytes.has_value()) {
+    if (progress_interval.value_or(0) < 0 || progress_bytes.value_or(0) < 0) {
+      throw std::invalid_argument("Invalid progressInterval or progressBytes.");
+    }
+    listener_->SetProgressThrottle(
+        std::chrono::milliseconds(progress_interval.value_or(0)),
+        progress_bytes.value_or(0));
+  }
+
+  auto rate_limit = method_args_->GetArg<int>("rateLimit");
+  if (rate_limit.has_value()) {
+    if (rate_limit.value() < 0) {
+      throw std::invalid_argument("rateLimit must not be negative.");
+    }
+    listener_->GetRateLimiter()->SetRate(rate_limit.value());
+  }
 }
 
 const char* StorageTask::GetTaskName() {
@@ -65,17 +323,49 @@ const char* StorageTask::GetTaskName() {
       return "Put-File";
     case kWriteToFile:
       return "Write-To-File";
+    case kStreamData:
+      return "Stream-Data";
     case kNone:
     default:
       return "None";
   }
 }
 
+void StorageTask::AddToJournal() {
+  StorageTransferJournal::Entry entry;
+  entry.handle = GetHandle();
+  entry.type = type_ == kPutFile ? "putFile" : "writeToFile";
+  entry.app_name = GetAppName();
+  entry.bucket = GetBucket();
+  entry.path = GetPath();
+  entry.file_path = method_args_->GetRequiredArg<std::string>("filePath");
+  StorageTransferJournal::GetInstance().Add(entry);
+  listener_->SetJournaled(true);
+}
+
+void StorageTask::Start() {
+  TransferStats::GetInstance().OnStart(GetStorageTaskData(), GetTaskName());
+  try {
+    Run();
+  } catch (...) {
+    TransferStats::GetInstance().OnFinished(GetHandle(),
+                                            TransferStats::kFailure);
+    throw;
+  }
+}
+
 void StorageTask::Complete() {
+  // Tasks that neither succeeded nor failed, e.g. streams canceled by Dart,
+  // end here.
+  TransferStats::GetInstance().OnFinished(GetHandle(), TransferStats::kFailure);
+  StorageTransferJournal::GetInstance().Remove(GetHandle());
+  TransferScheduler::GetInstance().Remove(this);
   StorageTaskHandler::GetInstance().RemoveTask(GetHandle());
 }
 
 void StorageTask::Success(const flutter::EncodableValue& result) {
+  TransferStats::GetInstance().OnFinished(GetHandle(), TransferStats::kSuccess);
+  listener_->DiscardProgress();
   channel_->InvokeMethod("Task#onSuccess",
                          std::make_unique<flutter::EncodableValue>(result));
 }
@@ -84,6 +374,8 @@ void StorageTask::Fail(const flutter::EncodableValue& result,
                        const char* error_message) {
   LOG_ERROR("Fail %s: %s", GetTaskName(), error_message);
 
+  TransferStats::GetInstance().OnFinished(GetHandle(), TransferStats::kFailure);
+  listener_->DiscardProgress();
   channel_->InvokeMethod("Task#onFailure",
                          std::make_unique<flutter::EncodableValue>(result));
 }
@@ -92,95 +384,705 @@ void StoragePutTask::Run() {
   RunTaskImpl().OnCompletion(
       [](const firebase::Future<firebase::storage::Metadata>& metadata,
          void* userdata) {
-        auto task = static_cast<StoragePutTask*>(userdata);
-        if (metadata.error() == firebase::storage::Error::kErrorNone) {
-          task->Success(utils::GetPutTaskSuccessEventValue(
-              task->GetStorageTaskData(), metadata.result()));
-        } else {
-          task->Fail(utils::GetTaskErrorEventValue(task->GetStorageTaskData(),
-                                                   metadata.error(),
-                                                   metadata.error_message()),
-                     metadata.error_message());
-        }
-
-        task->Complete();
+        static_cast<StoragePutTask*>(userdata)->OnUploaded(metadata);
       },
       this);
 }
 
+void StoragePutTask::OnUploaded(
+    const firebase::Future<firebase::storage::Metadata>& metadata) {
+  if (metadata.error() == firebase::storage::Error::kErrorNone) {
+    Success(utils::GetPutTaskSuccessEventValue(GetStorageTaskData(),
+                                               metadata.result()));
+  } else {
+    Fail(utils::GetTaskErrorEventValue(GetStorageTaskData(), metadata.error(),
+                                       metadata.error_message()),
+         metadata.error_message());
+  }
+
+  Complete();
+}
+
 firebase::Future<firebase::storage::Metadata>
 StoragePutDataTask::RunTaskImpl() {
-  buffer_ = method_args_->GetRequiredArg<std::vector<uint8_t>>("data");
+  // The task owns its arguments, so the bytes are uploaded in place.
+  const auto& data =
+      method_args_->GetRequiredArgRef<std::vector<uint8_t>>("data");
 
   auto metadata_value = method_args_->GetArg<flutter::EncodableMap>("metadata");
   if (metadata_value.has_value()) {
     return storage_reference_.PutBytes(
-        buffer_.data(), buffer_.size(),
-        utils::ParseMetadata(metadata_value.value()), GetListener(),
-        GetController());
+        data.data(), data.size(), utils::ParseMetadata(metadata_value.value()),
+        GetListener(), GetController());
   } else {
-    return storage_reference_.PutBytes(buffer_.data(), buffer_.size(),
-                                       GetListener(), GetController());
+    return storage_reference_.PutBytes(data.data(), data.size(), GetListener(),
+                                       GetController());
   }
 }
 
 firebase::Future<firebase::storage::Metadata>
 StoragePutStringTask::RunTaskImpl() {
   auto format = method_args_->GetRequiredArg<int>("format");
-  auto data = method_args_->GetRequiredArg<std::string>("data");
+  const auto& data = method_args_->GetRequiredArgRef<std::string>("data");
 
-  if (!utils::StringToByteData(data, &buffer_, format)) {
+  std::string content_type;
+  if (!utils::StringToByteData(data, format, &buffer_, &content_type)) {
     throw FirebaseStorageError(FirebaseStorageError::Code::kInvalidString,
                                "Fail to decode the input string.");
   }
 
   auto metadata_value = method_args_->GetArg<flutter::EncodableMap>("metadata");
-  if (metadata_value.has_value()) {
-    return storage_reference_.PutBytes(
-        buffer_.data(), buffer_.size(),
-        utils::ParseMetadata(metadata_value.value()), GetListener(),
-        GetController());
-  } else {
+  if (!metadata_value.has_value() && content_type.empty()) {
     return storage_reference_.PutBytes(buffer_.data(), buffer_.size(),
                                        GetListener(), GetController());
   }
+
+  firebase::storage::Metadata metadata;
+  if (metadata_value.has_value()) {
+    metadata = utils::ParseMetadata(metadata_value.value());
+  }
+  // A data URL carries its media type, which is used unless the metadata
+  // sets one.
+  if (!content_type.empty() &&
+      (!metadata.content_type() || !*metadata.content_type())) {
+    metadata.set_content_type(content_type.c_str());
+  }
+  return storage_reference_.PutBytes(buffer_.data(), buffer_.size(), metadata,
+                                     GetListener(), GetController());
 }
 
-firebase::Future<firebase::storage::Metadata>
-StoragePutFileTask::RunTaskImpl() {
+StoragePutFileTask::StoragePutFileTask(
+    const std::shared_ptr<FlMethodChannel> channel,
+    std::unique_ptr<MethodCallArguments>&& args)
+    : StoragePutTask(kPutFile, channel, std::move(args)) {
+  verify_checksum_ =
+      method_args_->GetArg<bool>("verifyChecksum").value_or(false);
+  if (verify_checksum_) {
+    // PutBytes reports its progress to the listener.
+    SetListener(std::make_unique<StorageChecksumListener>(
+        GetStorageTaskData(), channel, [this](int64_t bytes_transferred) {
+          if (checksum_) {
+            checksum_->Update(bytes_transferred);
+          }
+        }));
+  }
+  AddToJournal();
+}
+
+void StoragePutFileTask::Run() {
   auto file_path = method_args_->GetRequiredArg<std::string>("filePath");
 
+  // Both upload paths send the file from its mapping, which the task keeps
+  // until it completes.
+  file_ = MappedFile::Open(file_path);
+  if (file_ && file_->size() > 0) {
+    if (verify_checksum_) {
+      checksum_ = std::make_unique<MappedFileChecksum>(file_);
+    }
+    if (method_args_->GetArg<bool>("sniffContentType").value_or(false)) {
+      content_type_ = utils::SniffContentType(file_->data(), file_->size());
+    }
+  }
+
+  // ResumableUpload sends no Firebase Auth or App Check token, so it is only
+  // used where the SDK cannot upload, i.e. to the emulator.
+  if (!utils::IsEmulated(GetAppName())) {
+    StoragePutTask::Run();
+    return;
+  }
+
+  auto session_dir = utils::GetUploadSessionDirectory();
+  if (!session_dir.empty()) {
+    StorageTransferJournal::GetInstance().SetSessionFile(
+        GetHandle(), ResumableUpload::GetSessionFile(session_dir, GetBucket(),
+                                                     GetPath(), file_path));
+  }
+
+  auto listener = GetListener();
+  ResumableUpload::Options options;
+  options.endpoint = utils::GetUploadEndpoint(GetAppName());
+  options.session_dir = session_dir;
+  options.before_chunk = [listener](int64_t end_offset) {
+    listener->GetRateLimiter()->Throttle(end_offset);
+  };
+  options.on_retry = [handle = GetHandle()]() {
+    TransferStats::GetInstance().OnRetry(handle);
+  };
+  upload_ = std::make_unique<ResumableUpload>(
+      std::make_unique<CurlUploadTransport>(), std::move(options),
+      GetBucket(), GetPath(), file_path, file_,
+      utils::GetMetadataJson(
+          GetPath(),
+          method_args_->GetArgPointer<flutter::EncodableMap>("metadata"),
+          content_type_),
+      [this, listener](int64_t bytes_transferred, int64_t total_bytes) {
+        if (checksum_) {
+          checksum_->Update(bytes_transferred);
+        }
+        listener->SendProgress(bytes_transferred, total_bytes);
+      },
+      [listener](int64_t bytes_transferred, int64_t total_bytes) {
+        listener->SendPaused(bytes_transferred, total_bytes);
+      });
+  upload_thread_ = std::thread(&StoragePutFileTask::RunResumableUpload, this);
+}
+
+StoragePutFileTask::~StoragePutFileTask() {
+  if (!upload_thread_.joinable()) {
+    return;
+  }
+  if (upload_thread_.get_id() == std::this_thread::get_id()) {
+    // The upload completed the task, and returns right after.
+    upload_thread_.detach();
+    return;
+  }
+  // The plugin is going away. The session is kept for the next run.
+  upload_->Interrupt();
+  upload_thread_.join();
+}
+
+void StoragePutFileTask::RunResumableUpload() {
+  int error = upload_->Run();
+  if (upload_->IsInterrupted()) {
+    // The task is being destroyed.
+    return;
+  }
+  if (error != firebase::storage::Error::kErrorNone) {
+    FirebaseStorageError storage_error(error);
+    Fail(utils::GetTaskErrorEventValue(GetStorageTaskData(), error,
+                                       storage_error.GetMessage().c_str()),
+         storage_error.GetMessage().c_str());
+    Complete();
+    return;
+  }
+
+  int64_t total_bytes = upload_->total_byte_count();
+  flutter::EncodableMap metadata;
+  if (!utils::ParseObjectResource(upload_->resource(), &metadata)) {
+    // A previous run finished the upload, and the SDK would look the object
+    // up in production, so the snapshot goes without metadata.
+    Success(utils::GetTaskEventValue(GetStorageTaskData(), total_bytes,
+                                     total_bytes));
+    Complete();
+    return;
+  }
+  auto md5_hash =
+      std::get_if<std::string>(&metadata[flutter::EncodableValue("md5Hash")]);
+  if (md5_hash && FailIfChecksumDiffers(md5_hash->c_str())) {
+    return;
+  }
+  Success(utils::GetPutTaskSuccessEventValue(GetStorageTaskData(), total_bytes,
+                                             std::move(metadata)));
+  Complete();
+}
+
+void StoragePutFileTask::OnUploaded(
+    const firebase::Future<firebase::storage::Metadata>& metadata) {
+  if (metadata.error() == firebase::storage::Error::kErrorNone &&
+      metadata.result()->md5_hash() &&
+      FailIfChecksumDiffers(metadata.result()->md5_hash())) {
+    return;
+  }
+
+  StoragePutTask::OnUploaded(metadata);
+}
+
+bool StoragePutFileTask::FailIfChecksumDiffers(const char* md5_hash) {
+  if (!checksum_ || !*md5_hash || checksum_->Verify(md5_hash)) {
+    return false;
+  }
+  // The object is left as uploaded, for the app to upload the file again.
+  FirebaseStorageError error(FirebaseStorageError::Code::kNonMatchingChecksum);
+  Fail(utils::GetTaskErrorEventValue(GetStorageTaskData(),
+                                     static_cast<int>(error.GetCode()),
+                                     error.GetMessage().c_str()),
+       error.GetMessage().c_str());
+  Complete();
+  return true;
+}
+
+bool StoragePutFileTask::Pause() {
+  return IsUploading() ? upload_->Pause() : StorageTask::Pause();
+}
+
+bool StoragePutFileTask::Resume() {
+  return IsUploading() ? upload_->Resume() : StorageTask::Resume();
+}
+
+bool StoragePutFileTask::Cancel() {
+  return IsUploading() ? upload_->Cancel() : StorageTask::Cancel();
+}
+
+int64_t StoragePutFileTask::GetBytesTransferred() {
+  return IsUploading() ? upload_->bytes_transferred()
+                       : StorageTask::GetBytesTransferred();
+}
+
+int64_t StoragePutFileTask::GetTotalByteCount() {
+  return IsUploading() ? upload_->total_byte_count()
+                       : StorageTask::GetTotalByteCount();
+}
+
+firebase::Future<firebase::storage::Metadata>
+StoragePutFileTask::RunTaskImpl() {
   auto metadata_value = method_args_->GetArg<flutter::EncodableMap>("metadata");
+  if (!file_ || file_->size() == 0) {
+    // The SDK reports why the file cannot be read, or uploads it empty.
+    auto file_path = method_args_->GetRequiredArg<std::string>("filePath");
+    if (metadata_value.has_value()) {
+      return storage_reference_.PutFile(
+          file_path.data(), utils::ParseMetadata(metadata_value.value()),
+          GetListener(), GetController());
+    } else {
+      return storage_reference_.PutFile(file_path.data(), GetListener(),
+                                        GetController());
+    }
+  }
+
+  if (!metadata_value.has_value() && content_type_.empty()) {
+    return storage_reference_.PutBytes(file_->data(), file_->size(),
+                                       GetListener(), GetController());
+  }
+
+  firebase::storage::Metadata metadata;
   if (metadata_value.has_value()) {
-    return storage_reference_.PutFile(
-        file_path.data(), utils::ParseMetadata(metadata_value.value()),
-        GetListener(), GetController());
-  } else {
-    return storage_reference_.PutFile(file_path.data(), GetListener(),
-                                      GetController());
+    metadata = utils::ParseMetadata(metadata_value.value());
+  }
+  // The sniffed media type is used unless the metadata sets one.
+  if (!content_type_.empty() &&
+      (!metadata.content_type() || !*metadata.content_type())) {
+    metadata.set_content_type(content_type_.c_str());
   }
+  return storage_reference_.PutBytes(file_->data(), file_->size(), metadata,
+                                     GetListener(), GetController());
+}
+
+StorageWriteToFileTask::StorageWriteToFileTask(
+    const std::shared_ptr<FlMethodChannel> channel,
+    std::unique_ptr<MethodCallArguments>&& args)
+    : StorageTask(kWriteToFile, channel, std::move(args)) {
+  verify_checksum_ =
+      method_args_->GetArg<bool>("verifyChecksum").value_or(false);
+  if (verify_checksum_) {
+    SetListener(std::make_unique<StorageChecksumListener>(
+        GetStorageTaskData(), channel, [this](int64_t bytes_transferred) {
+          OnDataWritten(bytes_transferred);
+        }));
+  }
+  AddToJournal();
 }
 
 void StorageWriteToFileTask::Run() {
+  auto cache_options = StorageDownloadCache::GetInstance().GetOptions();
+  if (!cache_options.enabled && !verify_checksum_) {
+    Download();
+    return;
+  }
+  // Trusted cached copies are used without touching the network.
+  if (cache_options.enabled && !cache_options.validate &&
+      CompleteFromCache("")) {
+    return;
+  }
+
+  storage_reference_.GetMetadata().OnCompletion(
+      [](const firebase::Future<firebase::storage::Metadata>& metadata,
+         void* userdata) {
+        auto task = static_cast<StorageWriteToFileTask*>(userdata);
+        if (metadata.error() == firebase::storage::Error::kErrorNone) {
+          // Composed objects have no MD5 hash.
+          const char* md5_hash = metadata.result()->md5_hash();
+          if (task->verify_checksum_ && md5_hash) {
+            task->expected_md5_ = md5_hash;
+          }
+          if (StorageDownloadCache::GetInstance().GetOptions().enabled) {
+            task->validator_ =
+                StorageDownloadCache::GetValidator(*metadata.result());
+            if (task->CompleteFromCache(task->validator_)) {
+              return;
+            }
+          }
+        }
+        task->Download();
+      },
+      this);
+}
+
+void StorageWriteToFileTask::OnDataWritten(int64_t bytes_written) {
+  if (checksum_) {
+    checksum_->Update(bytes_written);
+  }
+}
+
+bool StorageWriteToFileTask::CompleteFromCache(const std::string& validator) {
+  auto file_path = method_args_->GetRequiredArg<std::string>("filePath");
+  int64_t size = 0;
+  if (!StorageDownloadCache::GetInstance().CopyToFile(
+          GetBucket(), GetPath(), validator, file_path, &size)) {
+    return false;
+  }
+
+  Success(GetSuccessValue(size, false));
+  Complete();
+  return true;
+}
+
+void StorageWriteToFileTask::Download() {
   auto file_path = method_args_->GetRequiredArg<std::string>("filePath");
+  if (!expected_md5_.empty()) {
+    checksum_ = std::make_unique<FileChecksum>(file_path);
+  }
 
   storage_reference_.GetFile(file_path.data(), GetListener(), GetController())
       .OnCompletion(
-          [](const firebase::Future<std::size_t>& metadata, void* userdata) {
-            auto task = static_cast<StorageWriteToFileTask*>(userdata);
-
-            if (metadata.error() == firebase::storage::Error::kErrorNone) {
-              task->Success(utils::GetTaskEventValue(task->GetStorageTaskData(),
-                                                     *metadata.result(),
-                                                     *metadata.result()));
-            } else {
-              task->Fail(utils::GetTaskErrorEventValue(
-                             task->GetStorageTaskData(), metadata.error(),
-                             metadata.error_message()),
-                         metadata.error_message());
+          [](const firebase::Future<std::size_t>& result, void* userdata) {
+            static_cast<StorageWriteToFileTask*>(userdata)->OnDownloaded(
+                result);
+          },
+          this);
+}
+
+void StorageWriteToFileTask::OnDownloaded(
+    const firebase::Future<size_t>& result) {
+  auto file_path = method_args_->GetRequiredArg<std::string>("filePath");
+  if (result.error() != firebase::storage::Error::kErrorNone) {
+    Fail(utils::GetTaskErrorEventValue(GetStorageTaskData(), result.error(),
+                                       result.error_message()),
+         result.error_message());
+  } else if (checksum_ && !checksum_->Verify(expected_md5_)) {
+    // The file is left for the app to inspect or remove.
+    FirebaseStorageError error(
+        FirebaseStorageError::Code::kNonMatchingChecksum);
+    Fail(utils::GetTaskErrorEventValue(GetStorageTaskData(),
+                                       static_cast<int>(error.GetCode()),
+                                       error.GetMessage().c_str()),
+         error.GetMessage().c_str());
+  } else {
+    if (!validator_.empty()) {
+      StorageDownloadCache::GetInstance().WriteFromFile(
+          GetBucket(), GetPath(), validator_, file_path);
+    }
+    Success(GetSuccessValue(*result.result(), checksum_ != nullptr));
+  }
+
+  Complete();
+}
+
+flutter::EncodableValue StorageWriteToFileTask::GetSuccessValue(
+    int64_t size, bool checksum_verified) {
+  auto value = utils::GetTaskEventValue(GetStorageTaskData(), size, size);
+  if (verify_checksum_) {
+    if (!checksum_verified) {
+      LOG_WARN("The checksum of %s was not verified.", GetPath().c_str());
+    }
+    std::get<flutter::EncodableMap>(value)[flutter::EncodableValue(
+        "checksumVerified")] = flutter::EncodableValue(checksum_verified);
+  }
+  return value;
+}
+
+StorageStreamDataTask::StorageStreamDataTask(
+    const std::shared_ptr<FlMethodChannel> channel,
+    std::unique_ptr<MethodCallArguments>&& args,
+    flutter::BinaryMessenger* messenger)
+    : StorageTask(kStreamData, channel, std::move(args)),
+      messenger_(messenger) {
+  int chunk_size =
+      method_args_->GetArg<int>("chunkSize").value_or(kDefaultChunkSize);
+  int prefetch =
+      method_args_->GetArg<int>("prefetch").value_or(kDefaultPrefetchChunks);
+  if (chunk_size <= 0 || prefetch < 0) {
+    throw std::invalid_argument("Invalid chunkSize or prefetch.");
+  }
+  chunk_size_ = static_cast<size_t>(chunk_size);
+  credit_ = prefetch;
+
+  SetListener(std::make_unique<StorageStreamListener>(GetStorageTaskData(),
+                                                      channel, this));
+}
+
+StorageStreamDataTask::~StorageStreamDataTask() {
+  if (spool_fd_ >= 0) {
+    close(spool_fd_);
+  }
+  if (!spool_path_.empty()) {
+    std::remove(spool_path_.c_str());
+  }
+}
+
+std::shared_ptr<StorageStreamDataTask> StorageStreamDataTask::FromHandle(
+    int handle) {
+  return GetStreamDataTask(handle);
+}
+
+void StorageStreamDataTask::Run() {
+  event_channel_name_ =
+      kStreamEventChannelNamePrefix + std::to_string(GetHandle());
+  event_channel_ =
+      std::make_shared<flutter::EventChannel<flutter::EncodableValue>>(
+          messenger_, event_channel_name_, &GetPayloadMethodCodec());
+
+  // The handler outlives the task if Dart never cancels the stream, so it
+  // looks the task up instead of holding on to it.
+  int handle = GetHandle();
+  event_channel_->SetStreamHandler(
+      std::make_unique<
+          flutter::StreamHandlerFunctions<flutter::EncodableValue>>(
+          [handle](
+              const flutter::EncodableValue* /*arguments*/,
+              std::unique_ptr<flutter::EventSink<flutter::EncodableValue>>&&
+                  events)
+              -> std::unique_ptr<
+                  flutter::StreamHandlerError<flutter::EncodableValue>> {
+            auto task = GetStreamDataTask(handle);
+            if (!task) {
+              FirebaseStorageError error(
+                  FirebaseStorageError::Code::KTaskNotFound);
+              return std::make_unique<
+                  flutter::StreamHandlerError<flutter::EncodableValue>>(
+                  error.GetCodeString(), error.GetMessage(), nullptr);
+            }
+            task->Listen(std::move(events));
+            return nullptr;
+          },
+          [handle](const flutter::EncodableValue* /*arguments*/)
+              -> std::unique_ptr<
+                  flutter::StreamHandlerError<flutter::EncodableValue>> {
+            auto task = GetStreamDataTask(handle);
+            if (task) {
+              task->OnCancel();
             }
+            return nullptr;
+          }));
+}
+
+void StorageStreamDataTask::RequestChunks(int64_t count) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  credit_ += count;
+  bool finished = SendChunks();
+  UpdateFlowControl();
+  lock.unlock();
+
+  // The caller holds a reference to the task.
+  if (finished) {
+    Complete();
+  }
+}
+
+void StorageStreamDataTask::OnDataAvailable(int64_t bytes_transferred) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (downloaded_) {
+    return;
+  }
+  // The last chunk is only sent once the download completes, so this never
+  // finishes the stream.
+  available_bytes_ = std::max(
+      available_bytes_,
+      std::min(static_cast<size_t>(bytes_transferred), total_bytes_));
+  SendChunks();
+  UpdateFlowControl();
+}
+
+void StorageStreamDataTask::Listen(
+    std::unique_ptr<flutter::EventSink<flutter::EncodableValue>>&& events) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (in_flight_ || downloaded_) {
+      events->Error("already-listening", "The stream has already started.");
+      return;
+    }
+    events_ = std::move(events);
+    in_flight_ = true;
+  }
 
-            task->Complete();
+  // The chunks carry the total.
+  storage_reference_.GetMetadata().OnCompletion(
+      [](const firebase::Future<firebase::storage::Metadata>& result,
+         void* userdata) {
+        static_cast<StorageStreamDataTask*>(userdata)->OnMetadata(result);
+      },
+      this);
+}
+
+void StorageStreamDataTask::OnCancel() {
+  bool in_flight;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.reset();
+    canceled_ = true;
+    in_flight = in_flight_;
+  }
+  TransferStats::GetInstance().SetCanceling(GetHandle(), true);
+
+  // Calling this will release the stream handler itself.
+  event_channel_->SetStreamHandler(nullptr);
+
+  if (in_flight) {
+    // The completion callback removes the task.
+    controller_.Cancel();
+  } else {
+    Complete();
+  }
+}
+
+void StorageStreamDataTask::OnMetadata(
+    const firebase::Future<firebase::storage::Metadata>& result) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (canceled_) {
+    in_flight_ = false;
+    lock.unlock();
+    Complete();
+    return;
+  }
+  if (result.error() != firebase::storage::Error::kErrorNone) {
+    in_flight_ = false;
+    SendError(result.error());
+    lock.unlock();
+    Complete();
+    return;
+  }
+
+  total_bytes_ = static_cast<size_t>(result.result()->size_bytes());
+  if (total_bytes_ == 0) {
+    in_flight_ = false;
+    downloaded_ = true;
+    bool finished = SendChunks();
+    lock.unlock();
+    if (finished) {
+      Complete();
+    }
+    return;
+  }
+
+  std::string spool_dir = utils::GetStreamSpoolDirectory();
+  if (spool_dir.empty()) {
+    in_flight_ = false;
+    SendError(firebase::storage::Error::kErrorUnknown);
+    lock.unlock();
+    Complete();
+    return;
+  }
+  spool_path_ = spool_dir + "/" + std::to_string(GetHandle());
+  lock.unlock();
+
+  storage_reference_
+      .GetFile(spool_path_.c_str(), GetListener(), GetController())
+      .OnCompletion(
+          [](const firebase::Future<size_t>& result, void* userdata) {
+            static_cast<StorageStreamDataTask*>(userdata)->OnDownloaded(result);
           },
           this);
 }
+
+void StorageStreamDataTask::OnDownloaded(
+    const firebase::Future<size_t>& result) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  in_flight_ = false;
+  if (canceled_) {
+    lock.unlock();
+    Complete();
+    return;
+  }
+  if (result.error() != firebase::storage::Error::kErrorNone) {
+    SendError(result.error());
+    lock.unlock();
+    Complete();
+    return;
+  }
+
+  // The object may have been replaced by another one after the metadata was
+  // read.
+  total_bytes_ = *result.result();
+  available_bytes_ = total_bytes_;
+  downloaded_ = true;
+  bool finished = SendChunks();
+  lock.unlock();
+  if (finished) {
+    Complete();
+  }
+}
+
+bool StorageStreamDataTask::SendChunks() {
+  if (!events_) {
+    return false;
+  }
+
+  while (credit_ > 0 && sent_bytes_ < available_bytes_) {
+    size_t size = std::min(chunk_size_, available_bytes_ - sent_bytes_);
+    if (size < chunk_size_ && !downloaded_) {
+      break;
+    }
+
+    // The SDK may report bytes it has not flushed to the file yet, which are
+    // read once more is available.
+    if (spool_fd_ < 0) {
+      spool_fd_ = open(spool_path_.c_str(), O_RDONLY | O_CLOEXEC);
+      if (spool_fd_ < 0) {
+        break;
+      }
+    }
+    chunk_.resize(size);
+    ssize_t read_size = pread(spool_fd_, chunk_.data(), size,
+                              static_cast<off_t>(sent_bytes_));
+    if (read_size != static_cast<ssize_t>(size)) {
+      if (downloaded_) {
+        SendError(firebase::storage::Error::kErrorUnknown);
+        return true;
+      }
+      break;
+    }
+
+    const uint8_t* data = chunk_.data();
+    int64_t offset = static_cast<int64_t>(sent_bytes_);
+    int64_t total_bytes = static_cast<int64_t>(total_bytes_);
+    events_->Success(MakePayload([&](PayloadWriter& writer) {
+      writer.WriteMap(3);
+      writer.WriteEntry("offset", offset);
+      writer.WriteString("bytes");
+      writer.WriteUint8List(data, size);
+      writer.WriteEntry("totalBytes", total_bytes);
+    }));
+
+    sent_bytes_ += size;
+    credit_--;
+  }
+
+  if (!downloaded_ || sent_bytes_ != total_bytes_) {
+    return false;
+  }
+
+  int64_t total_bytes = static_cast<int64_t>(total_bytes_);
+  Success(
+      utils::GetTaskEventValue(GetStorageTaskData(), total_bytes, total_bytes));
+  events_->EndOfStream();
+  events_.reset();
+  // Dart has nothing left to cancel.
+  event_channel_->SetStreamHandler(nullptr);
+  return true;
+}
+
+void StorageStreamDataTask::SendError(int error_code) {
+  FirebaseStorageError error(error_code);
+  Fail(utils::GetTaskErrorEventValue(GetStorageTaskData(), error_code,
+                                     error.GetMessage().c_str()),
+       error.GetMessage().c_str());
+
+  if (events_) {
+    events_->Error(error.GetCodeString(), error.GetMessage());
+    events_.reset();
+  }
+  event_channel_->SetStreamHandler(nullptr);
+}
+
+void StorageStreamDataTask::UpdateFlowControl() {
+  if (downloaded_ || !in_flight_) {
+    return;
+  }
+
+  size_t pending_chunks = (available_bytes_ - sent_bytes_) / chunk_size_;
+  if (!paused_ && pending_chunks >= kMaxPendingChunks) {
+    paused_ = controller_.Pause();
+  } else if (paused_ && pending_chunks <= kMaxPendingChunks / 2) {
+    controller_.Resume();
+    paused_ = false;
+  }
+}
@@ -5,34 +5,123 @@
 #ifndef FLUTTER_PLUGIN_FIREBASE_STORAGE_TASK_H_
 #define FLUTTER_PLUGIN_FIREBASE_STORAGE_TASK_H_
 
+#include <flutter/binary_messenger.h>
 #include <flutter/encodable_value.h>
+#include <flutter/event_channel.h>
+#include <flutter/event_sink.h>
+#include <flutter/event_stream_handler_functions.h>
 
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
+#include "firebase_storage_checksum.h"
+#include "firebase_storage_error.h"
 #include "firebase_storage_listener.h"
+#include "firebase_storage_mapped_file.h"
+#include "firebase_storage_upload.h"
 #include "firebase_storage_utils.h"
 #include "flutter_types.hpp"
 
 class StorageTask;
 
+// Owns the running tasks by handle. The tasks are spread over shards with
+// their own locks, so lookups of different tasks do not contend, and are
+// reference counted, so a task looked up stays alive until the caller drops
+// it even if it completes meanwhile.
 class StorageTaskHandler {
  public:
   static StorageTaskHandler& GetInstance();
 
-  void AddTask(int handle, std::unique_ptr<StorageTask> task);
+  void AddTask(int handle, std::shared_ptr<StorageTask> task);
 
-  std::optional<StorageTask*> GetTask(int handle);
+  // Returns nullptr if there is no task with |handle|.
+  std::shared_ptr<StorageTask> GetTask(int handle);
 
   void RemoveTask(int handle);
 
  private:
+  static constexpr size_t kShardCount = 16;
+
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_map<int, std::shared_ptr<StorageTask>> tasks;
+  };
+
   StorageTaskHandler() = default;
   StorageTaskHandler(const StorageTaskHandler&) = delete;
   void operator=(const StorageTaskHandler&) = delete;
 
-  std::unordered_map<int, std::unique_ptr<StorageTask>> tasks_;
+  Shard& GetShard(int handle);
+
+  Shard shards_[kShardCount];
+};
+
+// Limits the number of transfers running at once, if asked to. Tasks
+// submitted while all slots are taken wait in one FIFO queue per priority,
+// and are started from the highest priority queue as slots free up. Waiting
+// tasks can be paused, resumed and canceled like running ones; paused ones
+// keep their place but are skipped until resumed.
+class TransferScheduler {
+ public:
+  enum Priority {
+    kHigh,
+    kNormal,
+    kLow,
+    kPriorityCount,
+  };
+
+  static TransferScheduler& GetInstance();
+
+  // There is no limit by default, or if |max_transfers| is 0.
+  void SetMaxConcurrentTransfers(size_t max_transfers);
+
+  // Runs |task| now if a slot is free, or queues it. Exceptions thrown by
+  // StorageTask::Run() are rethrown if it runs now, and reported as the task
+  // failure otherwise.
+  void Submit(StorageTask* task, Priority priority);
+
+  // Frees the slot of |task|, or removes it from its queue. Called when the
+  // task completes.
+  void Remove(StorageTask* task);
+
+  bool Pause(StorageTask* task);
+  bool Resume(StorageTask* task);
+
+  // |dequeued| is set if |task| was waiting, in which case it will never run
+  // and is not completed by anything else.
+  bool Cancel(StorageTask* task, bool* dequeued);
+
+ private:
+  struct QueuedTask {
+    StorageTask* task;
+    bool paused;
+  };
+
+  TransferScheduler();
+  TransferScheduler(const TransferScheduler&) = delete;
+  void operator=(const TransferScheduler&) = delete;
+
+  // Must be called with |mutex_| held.
+  QueuedTask* FindQueued(StorageTask* task);
+  // Returns false if |task| is not queued.
+  bool EraseQueued(StorageTask* task);
+  std::vector<StorageTask*> TakeRunnable();
+
+  // Runs tasks taken by TakeRunnable(), with |mutex_| released.
+  void RunQueued(const std::vector<StorageTask*>& tasks);
+  void FailQueued(StorageTask* task, const FirebaseStorageError& error);
+
   std::mutex mutex_;
+  size_t max_transfers_;
+  std::unordered_set<StorageTask*> running_;
+  std::deque<QueuedTask> queues_[kPriorityCount];
 };
 
 class StorageTask {
@@ -43,16 +132,19 @@ class StorageTask {
     kPutString,
     kPutFile,
     kWriteToFile,
+    kStreamData,
   };
 
   virtual ~StorageTask() = default;
 
-  template <class T>
+  template <class T, typename... Args>
   static T* Create(const std::shared_ptr<FlMethodChannel> channel,
-                   std::unique_ptr<MethodCallArguments>&& args) {
-    auto task = std::make_unique<T>(channel, std::move(args));
+                   std::unique_ptr<MethodCallArguments>&& args,
+                   Args&&... extra_args) {
+    auto task = std::make_shared<T>(channel, std::move(args),
+                                    std::forward<Args>(extra_args)...);
     auto instance = task.get();
-    StorageTaskHandler::GetInstance().AddTask(task->GetHandle(),
+    StorageTaskHandler::GetInstance().AddTask(instance->GetHandle(),
                                               std::move(task));
     return instance;
   }
@@ -71,12 +163,27 @@ class StorageTask {
 
   firebase::storage::Controller* GetController() { return &controller_; }
 
+  // Controls the transfer. Tasks that do not transfer through |controller_|
+  // override these.
+  virtual bool Pause() { return controller_.Pause(); }
+  virtual bool Resume() { return controller_.Resume(); }
+  virtual bool Cancel() { return controller_.Cancel(); }
+  virtual int64_t GetBytesTransferred() {
+    return controller_.bytes_transferred();
+  }
+  virtual int64_t GetTotalByteCount() { return controller_.total_byte_count(); }
+
   StorageListener* GetListener() { return listener_.get(); }
 
+  TransferScheduler::Priority GetPriority() { return priority_; }
+
   const char* GetTaskName();
 
   FlMethodChannel* GetMethodChannel() { return channel_.get(); }
 
+  // Runs the task, recording its transfer in the TransferStats.
+  void Start();
+
   void Complete();
 
   void Success(const flutter::EncodableValue& result);
@@ -89,7 +196,15 @@ class StorageTask {
   StorageTask(Type type, const std::shared_ptr<FlMethodChannel> channel,
               std::unique_ptr<MethodCallArguments>&& args);
 
+  // Replaces the listener, applying the progress throttle and the rate limit
+  // of the arguments.
+  void SetListener(std::unique_ptr<StorageListener> listener);
+
+  // Records the task in the StorageTransferJournal until it completes.
+  void AddToJournal();
+
   Type type_;
+  TransferScheduler::Priority priority_;
   std::shared_ptr<FlMethodChannel> channel_;
   std::unique_ptr<MethodCallArguments> method_args_;
 
@@ -106,6 +221,11 @@ class StoragePutTask : public StorageTask {
 
   void Run() override;
   virtual firebase::Future<firebase::storage::Metadata> RunTaskImpl() = 0;
+
+ protected:
+  // Reports the outcome of the upload and completes the task.
+  virtual void OnUploaded(
+      const firebase::Future<firebase::storage::Metadata>& metadata);
 };
 
 class StoragePutDataTask final : public StoragePutTask {
@@ -117,9 +237,6 @@ class StoragePutDataTask final : public StoragePutTask {
   virtual ~StoragePutDataTask() = default;
 
   firebase::Future<firebase::storage::Metadata> RunTaskImpl() override;
-
- private:
-  std::vector<uint8_t> buffer_;
 };
 
 class StoragePutStringTask final : public StoragePutTask {
@@ -133,27 +250,146 @@ class StoragePutStringTask final : public StoragePutTask {
   firebase::Future<firebase::storage::Metadata> RunTaskImpl() override;
 
  private:
-  std::string buffer_;
+  std::vector<uint8_t> buffer_;
 };
 
+// Uploads files with PutBytes, or with ResumableUpload if the app uses the
+// Storage emulator, which the SDK cannot reach. Either way the file is sent
+// from its mapping, which is also what it is hashed and sniffed from.
 class StoragePutFileTask final : public StoragePutTask {
  public:
   StoragePutFileTask(const std::shared_ptr<FlMethodChannel> channel,
-                     std::unique_ptr<MethodCallArguments>&& args)
-      : StoragePutTask(kPutFile, channel, std::move(args)) {}
+                     std::unique_ptr<MethodCallArguments>&& args);
 
-  virtual ~StoragePutFileTask() = default;
+  // Interrupts |upload_| and waits for |upload_thread_| to return.
+  virtual ~StoragePutFileTask();
 
+  void Run() override;
   firebase::Future<firebase::storage::Metadata> RunTaskImpl() override;
+
+  bool Pause() override;
+  bool Resume() override;
+  bool Cancel() override;
+  int64_t GetBytesTransferred() override;
+  int64_t GetTotalByteCount() override;
+
+ private:
+  void RunResumableUpload();
+
+  // Fails the task if the object does not hash like the file.
+  void OnUploaded(
+      const firebase::Future<firebase::storage::Metadata>& metadata) override;
+
+  // Fails and completes the task if the file does not hash to |md5_hash|.
+  // Objects without a hash, e.g. composed ones, cannot be checked.
+  bool FailIfChecksumDiffers(const char* md5_hash);
+
+  // Whether |upload_| is running, as opposed to PutBytes.
+  bool IsUploading() { return upload_ != nullptr; }
+
+  bool verify_checksum_{false};
+  std::shared_ptr<MappedFile> file_;
+  // Set if |verify_checksum_| and the file is mapped.
+  std::unique_ptr<MappedFileChecksum> checksum_;
+  // The sniffed media type of the file, if the arguments ask for it.
+  std::string content_type_;
+  std::unique_ptr<ResumableUpload> upload_;
+  std::thread upload_thread_;
 };
 
 class StorageWriteToFileTask final : public StorageTask {
  public:
   StorageWriteToFileTask(const std::shared_ptr<FlMethodChannel> channel,
-                         std::unique_ptr<MethodCallArguments>&& args)
-      : StorageTask(kWriteToFile, channel, std::move(args)) {}
+                         std::unique_ptr<MethodCallArguments>&& args);
 
+  // Copies the object from the StorageDownloadCache if it is cached and
+  // current, and downloads it otherwise.
   void Run() override;
+
+  // Called by the listener whenever the download has written more data.
+  void OnDataWritten(int64_t bytes_written);
+
+ private:
+  bool CompleteFromCache(const std::string& validator);
+  void Download();
+  void OnDownloaded(const firebase::Future<size_t>& result);
+
+  // Tells whether the file was checked if the arguments asked for it. It is
+  // not if the object has no MD5 hash or its metadata could not be read, or
+  // if it was copied from the StorageDownloadCache.
+  flutter::EncodableValue GetSuccessValue(int64_t size, bool checksum_verified);
+
+  // Set if the download is to be cached.
+  std::string validator_;
+
+  // Whether the file is checked against the MD5 hash of the object.
+  bool verify_checksum_{false};
+  // Empty if the object has no MD5 hash, e.g. because it was composed.
+  std::string expected_md5_;
+  std::unique_ptr<FileChecksum> checksum_;
+};
+
+// Downloads an object and sends it to Dart in fixed-size chunks over an event
+// channel. Dart grants credit with Task#requestChunks, one chunk per credit;
+// the download is paused while too many chunks are waiting for credit.
+class StorageStreamDataTask final : public StorageTask {
+ public:
+  StorageStreamDataTask(const std::shared_ptr<FlMethodChannel> channel,
+                        std::unique_ptr<MethodCallArguments>&& args,
+                        flutter::BinaryMessenger* messenger);
+
+  // Removes the spooled download.
+  virtual ~StorageStreamDataTask();
+
+  // Registers the event channel. The download starts when Dart listens to it.
+  void Run() override;
+
+  // Returns the task of |handle| if it is a StorageStreamDataTask.
+  static std::shared_ptr<StorageStreamDataTask> FromHandle(int handle);
+
+  const std::string& GetEventChannelName() { return event_channel_name_; }
+
+  void RequestChunks(int64_t count);
+
+  // Called by the listener with the bytes spooled so far.
+  void OnDataAvailable(int64_t bytes_transferred);
+
+ private:
+  void Listen(
+      std::unique_ptr<flutter::EventSink<flutter::EncodableValue>>&& events);
+  void OnCancel();
+
+  void OnMetadata(const firebase::Future<firebase::storage::Metadata>& result);
+  void OnDownloaded(const firebase::Future<size_t>& result);
+
+  // The following must be called with |mutex_| held. SendChunks() returns
+  // true once the last chunk is sent, and SendError() ends the stream. The
+  // task must then be completed, after releasing |mutex_|.
+  bool SendChunks();
+  void SendError(int error_code);
+  void UpdateFlowControl();
+
+  flutter::BinaryMessenger* messenger_;
+  std::string event_channel_name_;
+  std::shared_ptr<flutter::EventChannel<flutter::EncodableValue>>
+      event_channel_;
+
+  std::mutex mutex_;
+  std::unique_ptr<flutter::EventSink<flutter::EncodableValue>> events_;
+  // The SDK cannot download ranges, so the object is spooled to a file, and
+  // only the chunk being sent is held in memory.
+  std::string spool_path_;
+  int spool_fd_{-1};
+  std::vector<uint8_t> chunk_;
+  size_t chunk_size_;
+  size_t total_bytes_{0};
+  size_t available_bytes_{0};
+  size_t sent_bytes_{0};
+  int64_t credit_;
+  bool in_flight_{false};
+  bool downloaded_{false};
+  bool paused_{false};
+  bool canceled_{false};
 };
 
 #endif
@@ -2,90 +2,84 @@
 
 #include <flutter/method_channel.h>
 #include <flutter/plugin_registrar.h>
-#include <flutter/standard_method_codec.h>
 
+#include <algorithm>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <string>
+#include <utility>
+#include <variant>
+#include <vector>
 
+#include "common/payload.h"
+#include "firebase_storage_cache.h"
 #include "firebase_storage_error.h"
+#include "firebase_storage_journal.h"
+#include "firebase_storage_list_all.h"
+#include "firebase_storage_metadata_batch.h"
+#include "firebase_storage_rate_limit.h"
+#include "firebase_storage_reference_work.h"
+#include "firebase_storage_stats.h"
 #include "firebase_storage_task.h"
 #include "flutter_types.hpp"
 #include "log.h"
 
 namespace {
 
-class StorageReferenceWork {
- public:
-  StorageReferenceWork(std::unique_ptr<MethodCallArguments>&& args,
-                       std::unique_ptr<FlMethodResult>&& result)
-      : reference_(utils::GetStorageReference(args.get())),
-        method_call_args_(std::move(args)),
-        method_result_(std::move(result)) {}
-
-  firebase::storage::StorageReference* GetStorageReference() {
-    return &reference_;
-  }
-
-  MethodCallArguments* GetMethodCallArguments() {
-    return method_call_args_.get();
-  }
-
-  void Success(const flutter::EncodableValue& result) {
-    method_result_->Success(result);
-  }
-
-  void Success() { method_result_->Success(); }
-
-  void Fail(int error_code) {
-    FirebaseStorageError error(error_code);
-    auto code = error.GetCodeString();
-    auto message = error.GetMessage();
-
-    method_result_->Error(
-        code, message,
-        flutter::EncodableValue(flutter::EncodableMap{
-            {flutter::EncodableValue("code"), flutter::EncodableValue(code)},
-            {flutter::EncodableValue("message"),
-             flutter::EncodableValue(message)}}));
-  }
-
- private:
-  firebase::storage::StorageReference reference_;
-  std::unique_ptr<MethodCallArguments> method_call_args_;
-  std::unique_ptr<FlMethodResult> method_result_;
-};
+constexpr int kDefaultProgressBatchInterval = 250;
+constexpr int kDefaultMetadataBatchConcurrency = 16;
 
 class FirebaseStorageTizenPlugin : public flutter::Plugin {
  public:
   static void RegisterWithRegistrar(flutter::PluginRegistrar* registrar) {
     auto channel = std::make_shared<FlMethodChannel>(
         registrar->messenger(), "plugins.flutter.io/firebase_storage",
-        &flutter::StandardMethodCodec::GetInstance());
-
-    auto plugin = std::make_unique<FirebaseStorageTizenPlugin>(channel);
-
-    channel->SetMethodCallHandler(
-        [plugin_pointer = plugin.get()](const auto& call, auto result) {
-          plugin_pointer->HandleMethodCall(call, std::move(result));
+        &GetPayloadMethodCodec());
+
+    // Transfers interrupted by the end of a previous run.
+    StorageTransferJournal::GetInstance().Load();
+
+    auto plugin = std::make_unique<FirebaseStorageTizenPlugin>(
+        channel, registrar->messenger());
+
+    // Decodes the calls itself instead of through the channel, so that the
+    // handler owns them and tasks can keep their arguments without a copy.
+    registrar->messenger()->SetMessageHandler(
+        "plugins.flutter.io/firebase_storage",
+        [plugin_pointer = plugin.get()](const uint8_t* message,
+                                        size_t message_size,
+                                        flutter::BinaryReply reply) {
+          const auto& codec = GetPayloadMethodCodec();
+          auto result =
+              std::make_unique<flutter::EngineMethodResult<
+                  flutter::EncodableValue>>(std::move(reply), &codec);
+          auto method_call = codec.DecodeMethodCall(message, message_size);
+          if (!method_call) {
+            result->NotImplemented();
+            return;
+          }
+          plugin_pointer->HandleMethodCall(std::move(method_call),
+                                           std::move(result));
         });
 
     registrar->AddPlugin(std::move(plugin));
   }
 
-  FirebaseStorageTizenPlugin(std::shared_ptr<FlMethodChannel> channel)
-      : channel_(std::move(channel)) {}
+  FirebaseStorageTizenPlugin(std::shared_ptr<FlMethodChannel> channel,
+                             flutter::BinaryMessenger* messenger)
+      : channel_(std::move(channel)), messenger_(messenger) {}
 
   virtual ~FirebaseStorageTizenPlugin() {}
 
  private:
   std::shared_ptr<FlMethodChannel> channel_;
+  flutter::BinaryMessenger* messenger_;
 
-  void HandleMethodCall(
-      const flutter::MethodCall<flutter::EncodableValue>& method_call,
-      std::unique_ptr<FlMethodResult> result) {
+  void HandleMethodCall(std::unique_ptr<FlMethodCall> method_call,
+                        std::unique_ptr<FlMethodResult> result) {
     auto method_call_arguments =
-        std::get_if<flutter::EncodableMap>(method_call.arguments());
+        std::get_if<flutter::EncodableMap>(method_call->arguments());
     if (!method_call_arguments) {
       FirebaseStorageError error(FirebaseStorageError::Code::kInvalidArgument);
       result->Error(error.GetCodeString(), "No arguments provided.");
@@ -93,69 +87,100 @@ class FirebaseStorageTizenPlugin : public flutter::Plugin {
     }
 
     auto args = std::make_unique<MethodCallArguments>(method_call_arguments);
-    const auto& method_name = method_call.method_name();
+    // Stays valid when a task takes |method_call| over.
+    const auto& method_name = method_call->method_name();
 
     try {
       if (method_name == "Storage#useEmulator") {
-        result->NotImplemented();
+        StorageUseEmulator(std::move(args), std::move(result));
+      } else if (method_name == "Storage#setProgressAggregation") {
+        StorageSetProgressAggregation(std::move(args), std::move(result));
+      } else if (method_name == "Storage#setMaxConcurrentTransfers") {
+        StorageSetMaxConcurrentTransfers(std::move(args), std::move(result));
+      } else if (method_name == "Storage#setDownloadCache") {
+        StorageSetDownloadCache(std::move(args), std::move(result));
+      } else if (method_name == "Storage#clearDownloadCache") {
+        StorageDownloadCache::GetInstance().Clear();
+        result->Success();
+      } else if (method_name == "Storage#getInterruptedTransfers") {
+        auto entries = StorageTransferJournal::GetInstance().GetInterrupted();
+        result->Success(StorageTransferJournal::GetEntriesPayload(entries));
+      } else if (method_name == "Storage#clearInterruptedTransfers") {
+        StorageTransferJournal::GetInstance().ClearInterrupted();
+        result->Success();
+      } else if (method_name == "Storage#getTransferStats") {
+        auto& stats = TransferStats::GetInstance();
+        result->Success(stats.GetStatsValue());
+        if (args->GetArg<bool>("reset").value_or(false)) {
+          stats.Reset();
+        }
       } else if (method_name == "Reference#delete") {
-        ReferenceDelete(std::make_shared<StorageReferenceWork>(
-            std::move(args), std::move(result)));
+        RunReferenceWork("Reference#delete", std::move(args), std::move(result),
+                         &FirebaseStorageTizenPlugin::ReferenceDelete);
       } else if (method_name == "Reference#getDownloadURL") {
-        ReferenceGetDownloadURL(std::make_shared<StorageReferenceWork>(
-            std::move(args), std::move(result)));
+        RunReferenceWork("Reference#getDownloadURL", std::move(args),
+                         std::move(result),
+                         &FirebaseStorageTizenPlugin::ReferenceGetDownloadURL);
       } else if (method_name == "Reference#getMetadata") {
-        ReferenceGetMetadata(std::make_shared<StorageReferenceWork>(
-            std::move(args), std::move(result)));
+        RunReferenceWork("Reference#getMetadata", std::move(args),
+                         std::move(result),
+                         &FirebaseStorageTizenPlugin::ReferenceGetMetadata);
+      } else if (method_name == "Reference#getMetadataBatch" ||
+                 method_name == "Reference#updateMetadataBatch") {
+        ReferenceMetadataBatch(std::move(args), std::move(result),
+                               method_name == "Reference#updateMetadataBatch");
       } else if (method_name == "Reference#getData") {
-        ReferenceGetData(std::make_shared<StorageReferenceWork>(
-            std::move(args), std::move(result)));
+        RunReferenceWork("Reference#getData", std::move(args),
+                         std::move(result),
+                         &FirebaseStorageTizenPlugin::ReferenceGetData);
       } else if (method_name == "Reference#list") {
-        ReferenceList(std::make_shared<StorageReferenceWork>(
-            std::move(args), std::move(result)));
+        RunReferenceWork("Reference#list", std::move(args), std::move(result),
+                         &FirebaseStorageTizenPlugin::ReferenceList);
       } else if (method_name == "Reference#listAll") {
-        result->NotImplemented();
+        RunReferenceWork("Reference#listAll", std::move(args),
+                         std::move(result),
+                         &FirebaseStorageTizenPlugin::ReferenceListAll);
       } else if (method_name == "Reference#updateMetadata") {
-        ReferenceUpdateMetadata(std::make_shared<StorageReferenceWork>(
-            std::move(args), std::move(result)));
+        RunReferenceWork("Reference#updateMetadata", std::move(args),
+                         std::move(result),
+                         &FirebaseStorageTizenPlugin::ReferenceUpdateMetadata);
       } else if (method_name == "Task#startPutData") {
-        StorageTask::Create<StoragePutDataTask>(channel_, std::move(args))
-            ->Run();
+        Schedule(StorageTask::Create<StoragePutDataTask>(
+            channel_, TakeArguments(std::move(method_call))));
         result->Success();
       } else if (method_name == "Task#startPutString") {
-        StorageTask::Create<StoragePutStringTask>(channel_, std::move(args))
-            ->Run();
+        Schedule(StorageTask::Create<StoragePutStringTask>(
+            channel_, TakeArguments(std::move(method_call))));
         result->Success();
       } else if (method_name == "Task#startPutFile") {
-        StorageTask::Create<StoragePutFileTask>(channel_, std::move(args))
-            ->Run();
+        Schedule(StorageTask::Create<StoragePutFileTask>(
+            channel_, TakeArguments(std::move(method_call))));
         result->Success();
       } else if (method_name == "Task#pause") {
         TaskStorageControl(
-            std::move(args), std::move(result),
-            [](StorageTask* task) { return task->GetController()->Pause(); });
+            std::move(args), std::move(result), [](StorageTask* task) {
+              return TransferScheduler::GetInstance().Pause(task);
+            });
       } else if (method_name == "Task#resume") {
-        TaskStorageControl(
-            std::move(args), std::move(result),
-            [](StorageTask* task) { return task->GetController()->Resume(); });
-      } else if (method_name == "Task#cancel") {
         TaskStorageControl(
             std::move(args), std::move(result), [](StorageTask* task) {
-              auto result = task->GetController()->Cancel();
-
-              if (result) {
-                task->GetMethodChannel()->InvokeMethod(
-                    "Task#onCanceled",
-                    std::make_unique<flutter::EncodableValue>(
-                        utils::GetTaskEventValue(task->GetStorageTaskData())));
-              }
-
-              return result;
+              return TransferScheduler::GetInstance().Resume(task);
             });
+      } else if (method_name == "Task#cancel") {
+        TaskCancel(std::move(args), std::move(result));
       } else if (method_name == "Task#writeToFile") {
-        StorageTask::Create<StorageWriteToFileTask>(channel_, std::move(args))
-            ->Run();
+        Schedule(StorageTask::Create<StorageWriteToFileTask>(
+            channel_, TakeArguments(std::move(method_call))));
         result->Success();
+      } else if (method_name == "Task#startStreamData") {
+        auto task = StorageTask::Create<StorageStreamDataTask>(
+            channel_, TakeArguments(std::move(method_call)), messenger_);
+        task->Start();
+        result->Success(flutter::EncodableValue(task->GetEventChannelName()));
+      } else if (method_name == "Task#requestChunks") {
+        TaskRequestChunks(std::move(args), std::move(result));
+      } else if (method_name == "Task#setRateLimit") {
+        TaskSetRateLimit(std::move(args), std::move(result));
       } else {
         result->NotImplemented();
       }
@@ -166,63 +191,304 @@ class FirebaseStorageTizenPlugin : public flutter::Plugin {
     }
   }
 
+  // Hands |method_call| over to the arguments of a task. Tasks outlive this
+  // handler and upload from the arguments in place.
+  static std::unique_ptr<MethodCallArguments> TakeArguments(
+      std::unique_ptr<FlMethodCall>&& method_call) {
+    return std::make_unique<MethodCallArguments>(std::move(method_call));
+  }
+
+  // Runs |task| once the TransferScheduler has a slot for it.
+  static void Schedule(StorageTask* task) {
+    TransferScheduler::GetInstance().Submit(task, task->GetPriority());
+  }
+
+  void StorageUseEmulator(std::unique_ptr<MethodCallArguments>&& args,
+                          std::unique_ptr<FlMethodResult>&& result) {
+    const auto& app_name = args->GetRequiredArgRef<std::string>("appName");
+    const auto& host = args->GetRequiredArgRef<std::string>("host");
+    int port = args->GetRequiredArg<int>("port");
+    if (host.empty() || port <= 0 || port > 65535) {
+      throw std::invalid_argument("Invalid emulator host or port.");
+    }
+
+    utils::UseEmulator(app_name, host, port);
+    LOG_WARN("Files put by %s go to the emulator at %s:%d. Its other "
+             "operations fail, as the SDK cannot reach the emulator.",
+             app_name.c_str(), host.c_str(), port);
+    result->Success();
+  }
+
+  void StorageSetMaxConcurrentTransfers(
+      std::unique_ptr<MethodCallArguments>&& args,
+      std::unique_ptr<FlMethodResult>&& result) {
+    int max_transfers = args->GetRequiredArg<int>("maxConcurrentTransfers");
+    if (max_transfers < 0) {
+      throw std::invalid_argument(
+          "maxConcurrentTransfers must not be negative.");
+    }
+
+    TransferScheduler::GetInstance().SetMaxConcurrentTransfers(
+        static_cast<size_t>(max_transfers));
+    result->Success();
+  }
+
+  void StorageSetDownloadCache(std::unique_ptr<MethodCallArguments>&& args,
+                               std::unique_ptr<FlMethodResult>&& result) {
+    StorageDownloadCache::Options options;
+    options.enabled = args->GetRequiredArg<bool>("enabled");
+    options.validate = args->GetArg<bool>("validate").value_or(true);
+    if (auto max_size = args->GetArgPointer<int64_t>("maxSize")) {
+      options.max_size = *max_size;
+    } else if (auto max_size = args->GetArgPointer<int32_t>("maxSize")) {
+      options.max_size = *max_size;
+    }
+    if (options.max_size < 0) {
+      throw std::invalid_argument("maxSize must not be negative.");
+    }
+
+    StorageDownloadCache::GetInstance().SetOptions(options);
+    result->Success();
+  }
+
+  void StorageSetProgressAggregation(
+      std::unique_ptr<MethodCallArguments>&& args,
+      std::unique_ptr<FlMethodResult>&& result) {
+    bool enabled = args->GetRequiredArg<bool>("enabled");
+    int interval =
+        args->GetArg<int>("interval").value_or(kDefaultProgressBatchInterval);
+    if (interval <= 0) {
+      throw std::invalid_argument("interval must be positive.");
+    }
+
+    if (enabled) {
+      ProgressAggregator::GetInstance().Enable(
+          channel_, std::chrono::milliseconds(interval));
+    } else {
+      ProgressAggregator::GetInstance().Disable();
+    }
+    result->Success();
+  }
+
+  // Runs |handler| with a work for the call. Errors thrown before the
+  // call is dispatched are replied like those of the SDK.
+  void RunReferenceWork(
+      const char* method_name,
+      std::unique_ptr<MethodCallArguments>&& args,
+      std::unique_ptr<FlMethodResult>&& result,
+      void (FirebaseStorageTizenPlugin::*handler)(
+          const std::shared_ptr<StorageReferenceWork>& work)) {
+    auto work = StorageReferenceWork::Create(method_name, std::move(args),
+                                             std::move(result));
+    try {
+      (this->*handler)(work);
+    } catch (const std::invalid_argument& error) {
+      work->Fail(FirebaseStorageError(
+          FirebaseStorageError::Code::kInvalidArgument, error.what()));
+    } catch (const FirebaseStorageError& error) {
+      work->Fail(error);
+    }
+  }
+
+  // Identifies the calls of |operation| on the reference of |work|.
+  static std::string GetInFlightKey(
+      const std::shared_ptr<StorageReferenceWork>& work,
+      const char* operation) {
+    auto reference = work->GetStorageReference();
+    return std::string(operation) + '\n' + reference->bucket() + '\n' +
+           reference->full_path();
+  }
+
   void ReferenceDelete(const std::shared_ptr<StorageReferenceWork>& work) {
-    work->GetStorageReference()->Delete().OnCompletion(
-        [work](const firebase::Future<void>& metadata) {
-          if (metadata.error() == firebase::storage::Error::kErrorNone) {
-            work->Success();
-          } else {
-            work->Fail(metadata.error());
-          }
-        });
+    work->Complete(work->GetStorageReference()->Delete(),
+                   [](const std::shared_ptr<StorageReferenceWork>& work,
+                      const firebase::Future<void>& /*result*/) {
+                     work->Success();
+                   });
   }
 
   void ReferenceGetDownloadURL(
       const std::shared_ptr<StorageReferenceWork>& work) {
-    work->GetStorageReference()->GetDownloadUrl().OnCompletion(
-        [work](const firebase::Future<std::string>& metadata) {
-          if (metadata.error() == firebase::storage::Error::kErrorNone) {
-            work->Success(flutter::EncodableValue(flutter::EncodableMap{
-                {flutter::EncodableValue("downloadURL"),
-                 flutter::EncodableValue(*metadata.result())}}));
-          } else {
-            work->Fail(metadata.error());
-          }
+    if (work->JoinInFlight(GetInFlightKey(work, "getDownloadURL"))) {
+      return;
+    }
+
+    work->Complete(
+        work->GetStorageReference()->GetDownloadUrl(),
+        [](const std::shared_ptr<StorageReferenceWork>& work,
+           const firebase::Future<std::string>& result) {
+          work->Success(flutter::EncodableValue(flutter::EncodableMap{
+              {flutter::EncodableValue("downloadURL"),
+               flutter::EncodableValue(*result.result())}}));
         });
   }
 
   void ReferenceGetMetadata(const std::shared_ptr<StorageReferenceWork>& work) {
-    work->GetStorageReference()->GetMetadata().OnCompletion(
-        [work](const firebase::Future<firebase::storage::Metadata>& metadata) {
-          if (metadata.error() == firebase::storage::Error::kErrorNone) {
-            work->Success(utils::GetMetadataValue(metadata.result()));
-          } else {
-            work->Fail(metadata.error());
-          }
+    work->Complete(
+        work->GetStorageReference()->GetMetadata(),
+        [](const std::shared_ptr<StorageReferenceWork>& work,
+           const firebase::Future<firebase::storage::Metadata>& result) {
+          work->Success(utils::GetMetadataValue(result.result()));
         });
   }
 
+  // Gets the metadata of |paths|, or updates that of |items|, which are
+  // {path, metadata} maps. All outcomes are in the reply, so one object
+  // failing does not fail the call.
+  void ReferenceMetadataBatch(std::unique_ptr<MethodCallArguments>&& args,
+                              std::unique_ptr<FlMethodResult>&& result,
+                              bool update) {
+    std::vector<StorageMetadataBatchOperation::Item> items;
+    if (update) {
+      const auto& list =
+          args->GetRequiredArgRef<flutter::EncodableList>("items");
+      items.reserve(list.size());
+      for (const auto& value : list) {
+        auto map = std::get_if<flutter::EncodableMap>(&value);
+        if (!map) {
+          throw std::invalid_argument("Invalid items.");
+        }
+        MethodCallArguments item(map);
+        items.push_back(StorageMetadataBatchOperation::Item{
+            item.GetRequiredArg<std::string>("path"),
+            utils::ParseMetadata(
+                item.GetRequiredArgRef<flutter::EncodableMap>("metadata")),
+            0, std::nullopt});
+      }
+    } else {
+      const auto& list =
+          args->GetRequiredArgRef<flutter::EncodableList>("paths");
+      items.reserve(list.size());
+      for (const auto& value : list) {
+        auto path = std::get_if<std::string>(&value);
+        if (!path) {
+          throw std::invalid_argument("Invalid paths.");
+        }
+        items.push_back(StorageMetadataBatchOperation::Item{
+            *path, std::nullopt, 0, std::nullopt});
+      }
+    }
+
+    int max_concurrency = args->GetArg<int>("maxConcurrency")
+                              .value_or(kDefaultMetadataBatchConcurrency);
+    if (max_concurrency <= 0) {
+      throw std::invalid_argument("maxConcurrency must be positive.");
+    }
+
+    auto storage = utils::GetStorage(args.get());
+    std::shared_ptr<FlMethodResult> shared_result = std::move(result);
+    StorageMetadataBatchOperation::Create(
+        storage, std::move(items),
+        static_cast<size_t>(max_concurrency),
+        [shared_result](
+            const std::vector<StorageMetadataBatchOperation::Item>& items) {
+          shared_result->Success(
+              StorageMetadataBatchOperation::GetResultPayload(items));
+        })
+        ->Start();
+  }
+
   void ReferenceGetData(const std::shared_ptr<StorageReferenceWork>& work) {
     auto max_size =
         work->GetMethodCallArguments()->GetRequiredArg<int>("maxSize");
-    auto buffer = std::make_shared<std::vector<uint8_t>>(max_size);
-
-    work->GetStorageReference()
-        ->GetBytes(buffer.get()->data(), max_size)
-        .OnCompletion(
-            [work, buffer, max_size](const firebase::Future<size_t>& metadata) {
-              auto buffer_size = *metadata.result();
-              assert(buffer_size <= max_size);
-
-              if (metadata.error() == firebase::storage::Error::kErrorNone) {
-                auto buffer_data = buffer.get();
-                buffer_data->resize(buffer_size);
-
-                work->Success(flutter::EncodableValue(*buffer_data));
-              } else {
-                work->Fail(metadata.error());
+
+    auto cache_options = StorageDownloadCache::GetInstance().GetOptions();
+    // Trusted cached copies are served without touching the network.
+    if (cache_options.enabled && !cache_options.validate &&
+        GetCachedBytes(work, "", max_size)) {
+      return;
+    }
+
+    // Identical reads, e.g. of an image shown several times, share one
+    // download.
+    if (work->JoinInFlight(GetInFlightKey(work, "getData") + '\n' +
+                           std::to_string(max_size))) {
+      return;
+    }
+
+    if (!cache_options.enabled) {
+      // The buffer is not initialized, so only the pages the download writes
+      // take memory, and the metadata is not worth a round trip.
+      GetBytes(work, static_cast<size_t>(max_size), "");
+      return;
+    }
+
+    // The cache needs the metadata to validate its copy, which also sizes the
+    // buffer. If the metadata is not available, the download decides.
+    work->GetStorageReference()->GetMetadata().OnCompletion(
+        [work, max_size](
+            const firebase::Future<firebase::storage::Metadata>& metadata) {
+          size_t buffer_size = static_cast<size_t>(max_size);
+          std::string validator;
+          if (metadata.error() == firebase::storage::Error::kErrorNone) {
+            int64_t size_bytes = metadata.result()->size_bytes();
+            buffer_size =
+                static_cast<size_t>(std::min<int64_t>(size_bytes, max_size));
+            // Objects larger than |max_size| are not read whole, so they are
+            // neither served from nor added to the cache.
+            if (size_bytes <= max_size) {
+              validator =
+                  StorageDownloadCache::GetValidator(*metadata.result());
+              if (GetCachedBytes(work, validator, max_size)) {
+                return;
               }
-            });
+            }
+          } else if (metadata.error() ==
+                     firebase::storage::Error::kErrorObjectNotFound) {
+            work->Fail(metadata.error());
+            return;
+          }
+          GetBytes(work, buffer_size, validator);
+        });
+  }
+
+  // Replies with the cached copy of the object if there is one for
+  // |validator| that fits in |max_size|.
+  static bool GetCachedBytes(const std::shared_ptr<StorageReferenceWork>& work,
+                             const std::string& validator, int max_size) {
+    auto reference = work->GetStorageReference();
+    std::vector<uint8_t> buffer;
+    if (!StorageDownloadCache::GetInstance().Read(
+            reference->bucket(), reference->full_path(), validator, &buffer) ||
+        buffer.size() > static_cast<size_t>(max_size)) {
+      return false;
+    }
+
+    flutter::EncodableValue value;
+    value = std::move(buffer);
+    work->Success(value);
+    return true;
+  }
+
+  // Caches the bytes read if |validator| is not empty.
+  static void GetBytes(const std::shared_ptr<StorageReferenceWork>& work,
+                       size_t buffer_size, const std::string& validator) {
+    if (buffer_size == 0) {
+      work->Success(flutter::EncodableValue(std::vector<uint8_t>()));
+      return;
+    }
+
+    // The bytes are read into the vector that is sent as the reply.
+    auto buffer = std::make_shared<std::vector<uint8_t>>(buffer_size);
+    work->Complete(
+        work->GetStorageReference()->GetBytes(buffer->data(), buffer_size),
+        [buffer, validator](const std::shared_ptr<StorageReferenceWork>& work,
+                            const firebase::Future<size_t>& result) {
+          size_t size = *result.result();
+          assert(size <= buffer->size());
+          buffer->resize(size);
+
+          if (!validator.empty()) {
+            auto reference = work->GetStorageReference();
+            StorageDownloadCache::GetInstance().Write(
+                reference->bucket(), reference->full_path(), validator,
+                buffer->data(), size);
+          }
+
+          // The templated EncodableValue constructor would copy the vector.
+          work->Success(flutter::EncodableValue(
+              std::in_place_type<std::vector<uint8_t>>, std::move(*buffer)));
+        });
   }
 
   void ReferenceList(const std::shared_ptr<StorageReferenceWork>& work) {
@@ -234,15 +500,64 @@ class FirebaseStorageTizenPlugin : public flutter::Plugin {
 
     int max_result = options.GetRequiredArg<int>("maxResults");
     auto page_token = options.GetArg<std::string>("pageToken").value_or("");
-    work->GetStorageReference()
-        ->List(max_result, page_token)
-        .OnCompletion([work](const firebase::Future<ListResult>& metadata) {
-          if (metadata.error() == firebase::storage::Error::kErrorNone) {
-            work->Success(utils::ParseListResult(*metadata.result()));
-          } else {
-            work->Fail(metadata.error());
+    work->Complete(work->GetStorageReference()->List(max_result, page_token),
+                   [](const std::shared_ptr<StorageReferenceWork>& work,
+                      const firebase::Future<ListResult>& result) {
+                     work->Success(utils::ParseListResult(*result.result()));
+                   });
+  }
+
+  // Unlike Reference#list, lists every page natively. With the recursive
+  // option, everything under the prefixes found is listed too. With
+  // batchSize, the results are sent ahead in Reference#onListAllBatch events
+  // carrying |handle|, and the reply carries the rest.
+  void ReferenceListAll(const std::shared_ptr<StorageReferenceWork>& work) {
+    auto args = work->GetMethodCallArguments();
+    StorageListAllOperation::Options options;
+    int handle = 0;
+    if (auto options_map = args->GetArgPointer<flutter::EncodableMap>(
+            "options")) {
+      MethodCallArguments options_args(options_map);
+      options.recursive =
+          options_args.GetArg<bool>("recursive").value_or(false);
+      int max_concurrency =
+          options_args.GetArg<int>("maxConcurrency")
+              .value_or(static_cast<int>(options.max_concurrency));
+      int batch_size = options_args.GetArg<int>("batchSize").value_or(0);
+      if (max_concurrency <= 0 || batch_size < 0) {
+        throw std::invalid_argument("Invalid maxConcurrency or batchSize.");
+      }
+      options.max_concurrency = static_cast<size_t>(max_concurrency);
+      options.batch_size = static_cast<size_t>(batch_size);
+      if (batch_size > 0) {
+        handle = args->GetRequiredArg<int>("handle");
+      }
+    }
+
+    auto channel = channel_;
+    StorageListAllOperation::Create(
+        *work->GetStorageReference(), options,
+        [channel, handle](flutter::EncodableList&& items,
+                          flutter::EncodableList&& prefixes) {
+          auto value =
+              utils::GetListAllValue(std::move(items), std::move(prefixes));
+          std::get<flutter::EncodableMap>(
+              value)[flutter::EncodableValue("handle")] =
+              flutter::EncodableValue(handle);
+          channel->InvokeMethod(
+              "Reference#onListAllBatch",
+              std::make_unique<flutter::EncodableValue>(std::move(value)));
+        },
+        [work](int error, flutter::EncodableList&& items,
+               flutter::EncodableList&& prefixes) {
+          if (error != firebase::storage::Error::kErrorNone) {
+            work->Fail(error);
+            return;
           }
-        });
+          work->Success(
+              utils::GetListAllValue(std::move(items), std::move(prefixes)));
+        })
+        ->Start();
   }
 
   void ReferenceUpdateMetadata(
@@ -251,17 +566,13 @@ class FirebaseStorageTizenPlugin : public flutter::Plugin {
         work->GetMethodCallArguments()->GetRequiredArg<flutter::EncodableMap>(
             "metadata");
 
-    work->GetStorageReference()
-        ->UpdateMetadata(utils::ParseMetadata(metadata))
-        .OnCompletion(
-            [work](
-                const firebase::Future<firebase::storage::Metadata>& metadata) {
-              if (metadata.error() == firebase::storage::Error::kErrorNone) {
-                work->Success(utils::GetMetadataValue(metadata.result()));
-              } else {
-                work->Fail(metadata.error());
-              }
-            });
+    work->Complete(
+        work->GetStorageReference()->UpdateMetadata(
+            utils::ParseMetadata(metadata)),
+        [](const std::shared_ptr<StorageReferenceWork>& work,
+           const firebase::Future<firebase::storage::Metadata>& result) {
+          work->Success(utils::GetMetadataValue(result.result()));
+        });
   }
 
   void TaskStorageControl(std::unique_ptr<MethodCallArguments>&& args,
@@ -269,17 +580,96 @@ class FirebaseStorageTizenPlugin : public flutter::Plugin {
                           std::function<bool(StorageTask*)> control_callback) {
     int handle = args->GetRequiredArg<int>("handle");
 
-    auto task_value = StorageTaskHandler::GetInstance().GetTask(handle);
-    if (!task_value.has_value()) {
+    // Holding the task keeps it alive even if it completes meanwhile.
+    auto task = StorageTaskHandler::GetInstance().GetTask(handle);
+    if (!task) {
+      FirebaseStorageError error(FirebaseStorageError::Code::KTaskNotFound);
+      result->Error(error.GetCodeString(), error.GetMessage());
+      return;
+    }
+
+    bool status = control_callback(task.get());
+    result->Success(utils::GetTaskControlEventValue(
+        status, task->GetPath(), task->GetBytesTransferred(),
+        task->GetTotalByteCount()));
+  }
+
+  void TaskCancel(std::unique_ptr<MethodCallArguments>&& args,
+                  std::unique_ptr<FlMethodResult>&& result) {
+    int handle = args->GetRequiredArg<int>("handle");
+
+    // Holding the task keeps it alive even if it completes meanwhile.
+    auto task = StorageTaskHandler::GetInstance().GetTask(handle);
+    if (!task) {
+      FirebaseStorageError error(FirebaseStorageError::Code::KTaskNotFound);
+      result->Error(error.GetCodeString(), error.GetMessage());
+      return;
+    }
+
+    bool dequeued = false;
+    bool status =
+        TransferScheduler::GetInstance().Cancel(task.get(), &dequeued);
+    if (status) {
+      task->GetListener()->DiscardProgress();
+      task->GetMethodChannel()->InvokeMethod(
+          "Task#onCanceled",
+          std::make_unique<flutter::EncodableValue>(
+              utils::GetTaskEventValue(task->GetStorageTaskData())));
+    }
+    result->Success(utils::GetTaskControlEventValue(
+        status, task->GetPath(), task->GetBytesTransferred(),
+        task->GetTotalByteCount()));
+
+    // A task that never started has no transfer left to remove it.
+    if (dequeued) {
+      task->Complete();
+    }
+  }
+
+  void TaskRequestChunks(std::unique_ptr<MethodCallArguments>&& args,
+                         std::unique_ptr<FlMethodResult>&& result) {
+    int handle = args->GetRequiredArg<int>("handle");
+    int count = args->GetRequiredArg<int>("count");
+    if (count <= 0) {
+      throw std::invalid_argument("count must be positive.");
+    }
+
+    auto task = StorageStreamDataTask::FromHandle(handle);
+    if (!task) {
       FirebaseStorageError error(FirebaseStorageError::Code::KTaskNotFound);
       result->Error(error.GetCodeString(), error.GetMessage());
       return;
     }
 
-    auto task = *task_value;
-    bool status = control_callback(task);
-    result->Success(utils::GetTaskControlEventValue(status, task->GetPath(),
-                                                    task->GetController()));
+    task->RequestChunks(count);
+    result->Success();
+  }
+
+  // Limits the transfer rate of the task of "handle", or of all tasks of the
+  // app if there is no handle. 0 removes the limit.
+  void TaskSetRateLimit(std::unique_ptr<MethodCallArguments>&& args,
+                        std::unique_ptr<FlMethodResult>&& result) {
+    int bytes_per_second = args->GetRequiredArg<int>("bytesPerSecond");
+    if (bytes_per_second < 0) {
+      throw std::invalid_argument("bytesPerSecond must not be negative.");
+    }
+
+    auto handle = args->GetArg<int>("handle");
+    if (!handle.has_value()) {
+      TokenBucket::ForApp(args->GetRequiredArg<std::string>("appName"))
+          ->SetRate(bytes_per_second);
+      result->Success();
+      return;
+    }
+
+    auto task = StorageTaskHandler::GetInstance().GetTask(handle.value());
+    if (!task) {
+      FirebaseStorageError error(FirebaseStorageError::Code::KTaskNotFound);
+      result->Error(error.GetCodeString(), error.GetMessage());
+      return;
+    }
+    task->GetListener()->GetRateLimiter()->SetRate(bytes_per_second);
+    result->Success();
   }
 };
 
@@ -0,0 +1,559 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "firebase_storage_upload.h"
+
+#include <curl/curl.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "firebase/storage/common.h"
+#include "log.h"
+
+using firebase::storage::Error;
+
+namespace {
+
+// Progress within a chunk is reported in steps of this many bytes.
+constexpr int64_t kProgressStep = 256 * 1024;
+
+constexpr long kRequestTimeoutSeconds = 120;
+
+std::string UrlEncode(const std::string& value) {
+  static const char kHex[] = "0123456789ABCDEF";
+  std::string out;
+  for (unsigned char c : value) {
+    if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
+      out += static_cast<char>(c);
+    } else {
+      out += '%';
+      out += kHex[c >> 4];
+      out += kHex[c & 0xf];
+    }
+  }
+  return out;
+}
+
+std::string GetHeader(const UploadResponse& response, const char* name) {
+  auto iter = response.headers.find(name);
+  return iter == response.headers.end() ? "" : iter->second;
+}
+
+bool IsRetryable(long status) {
+  return status == 408 || status == 429 || status >= 500;
+}
+
+int GetError(long status) {
+  switch (status) {
+    case 401:
+      return Error::kErrorUnauthenticated;
+    case 403:
+      return Error::kErrorUnauthorized;
+    case 404:
+      return Error::kErrorObjectNotFound;
+    default:
+      return Error::kErrorUnknown;
+  }
+}
+
+size_t WriteBody(char* buffer, size_t size, size_t nitems, void* userdata) {
+  static_cast<std::string*>(userdata)->append(buffer, size * nitems);
+  return size * nitems;
+}
+
+size_t WriteHeader(char* buffer, size_t size, size_t nitems, void* userdata) {
+  auto headers = static_cast<std::map<std::string, std::string>*>(userdata);
+  std::string line(buffer, size * nitems);
+  if (line.compare(0, 5, "HTTP/") == 0) {
+    // A new response, e.g. after "100 Continue".
+    headers->clear();
+    return size * nitems;
+  }
+
+  size_t colon = line.find(':');
+  if (colon != std::string::npos) {
+    std::string name = line.substr(0, colon);
+    std::transform(name.begin(), name.end(), name.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    size_t begin = line.find_first_not_of(" \t", colon + 1);
+    size_t end = line.find_last_not_of(" \t\r\n");
+    (*headers)[name] = begin == std::string::npos || end < begin
+                           ? ""
+                           : line.substr(begin, end - begin + 1);
+  }
+  return size * nitems;
+}
+
+int OnTransferInfo(void* clientp, curl_off_t /*dltotal*/, curl_off_t /*dlnow*/,
+                   curl_off_t /*ultotal*/, curl_off_t ulnow) {
+  auto on_progress =
+      static_cast<const UploadTransport::ProgressCallback*>(clientp);
+  return (*on_progress)(ulnow) ? 0 : 1;
+}
+
+}  // namespace
+
+CurlUploadTransport::CurlUploadTransport() {
+  static std::once_flag once;
+  std::call_once(once, [] { curl_global_init(CURL_GLOBAL_DEFAULT); });
+  curl_ = curl_easy_init();
+}
+
+CurlUploadTransport::~CurlUploadTransport() {
+  if (curl_) {
+    curl_easy_cleanup(curl_);
+  }
+}
+
+bool CurlUploadTransport::Post(const UploadRequest& request,
+                               UploadResponse* response,
+                               const ProgressCallback& on_progress) {
+  if (!curl_) {
+    return false;
+  }
+
+  curl_slist* headers = nullptr;
+  for (const auto& [name, value] : request.headers) {
+    headers = curl_slist_append(headers, (name + ": " + value).c_str());
+  }
+  // Skips the "Expect: 100-continue" round trip before each chunk.
+  headers = curl_slist_append(headers, "Expect:");
+
+  curl_easy_reset(curl_);
+  curl_easy_setopt(curl_, CURLOPT_URL, request.url.c_str());
+  curl_easy_setopt(curl_, CURLOPT_POST, 1L);
+  curl_easy_setopt(curl_, CURLOPT_POSTFIELDS,
+                   request.body ? reinterpret_cast<const char*>(request.body)
+                                : "");
+  curl_easy_setopt(curl_, CURLOPT_POSTFIELDSIZE_LARGE,
+                   static_cast<curl_off_t>(request.body_size));
+  curl_easy_setopt(curl_, CURLOPT_HTTPHEADER, headers);
+  curl_easy_setopt(curl_, CURLOPT_NOSIGNAL, 1L);
+  curl_easy_setopt(curl_, CURLOPT_TIMEOUT, kRequestTimeoutSeconds);
+  curl_easy_setopt(curl_, CURLOPT_HEADERFUNCTION, WriteHeader);
+  curl_easy_setopt(curl_, CURLOPT_HEADERDATA, &response->headers);
+  curl_easy_setopt(curl_, CURLOPT_WRITEFUNCTION, WriteBody);
+  curl_easy_setopt(curl_, CURLOPT_WRITEDATA, &response->body);
+  curl_easy_setopt(curl_, CURLOPT_NOPROGRESS, 0L);
+  curl_easy_setopt(curl_, CURLOPT_XFERINFOFUNCTION, OnTransferInfo);
+  curl_easy_setopt(curl_, CURLOPT_XFERINFODATA, &on_progress);
+
+  CURLcode code = curl_easy_perform(curl_);
+  curl_slist_free_all(headers);
+  if (code != CURLE_OK) {
+    LOG_ERROR("Upload request failed: %s", curl_easy_strerror(code));
+    return false;
+  }
+
+  curl_easy_getinfo(curl_, CURLINFO_RESPONSE_CODE, &response->status);
+  return true;
+}
+
+// Hands out the chunks of a mapped file, and has the kernel read the ones
+// following the current chunk in the background, so that reading overlaps
+// with sending.
+class ResumableUpload::ChunkReader {
+ public:
+  ChunkReader(const MappedFile* file, size_t chunk_size, size_t read_ahead)
+      : file_(file), chunk_size_(chunk_size), read_ahead_(read_ahead) {}
+
+  // Returns the chunk starting at |offset| and sets |size| to its size. The
+  // chunk stays valid as long as the file is mapped.
+  const uint8_t* Read(int64_t offset, size_t* size) {
+    int64_t file_size = static_cast<int64_t>(file_->size());
+    *size = static_cast<size_t>(
+        std::min<int64_t>(chunk_size_, file_size - offset));
+
+    int64_t end = std::min<int64_t>(
+        file_size, offset + *size + chunk_size_ * read_ahead_);
+    // Chunks sent again, from an offset the server asked for, were
+    // prefetched the first time.
+    int64_t begin = std::max(offset, prefetched_);
+    if (begin < end) {
+      file_->Prefetch(begin, static_cast<size_t>(end - begin));
+      prefetched_ = end;
+    }
+    return *size > 0 ? file_->data() + offset : nullptr;
+  }
+
+ private:
+  const MappedFile* file_;
+  size_t chunk_size_;
+  size_t read_ahead_;
+  int64_t prefetched_{0};
+};
+
+ResumableUpload::ResumableUpload(std::unique_ptr<UploadTransport> transport,
+                                 Options options, std::string bucket,
+                                 std::string path, std::string file_path,
+                                 std::shared_ptr<const MappedFile> file,
+                                 std::string metadata_json,
+                                 ProgressCallback on_progress,
+                                 ProgressCallback on_paused)
+    : transport_(std::move(transport)),
+      options_(std::move(options)),
+      bucket_(std::move(bucket)),
+      path_(std::move(path)),
+      file_path_(std::move(file_path)),
+      file_(std::move(file)),
+      metadata_json_(std::move(metadata_json)),
+      on_progress_(std::move(on_progress)),
+      on_paused_(std::move(on_paused)) {}
+
+ResumableUpload::~ResumableUpload() = default;
+
+int ResumableUpload::Run() {
+  int error = Error::kErrorUnknown;
+  if (!file_) {
+    LOG_ERROR("Failed to map %s", file_path_.c_str());
+  } else {
+    total_byte_count_ = static_cast<int64_t>(file_->size());
+    error = RunSession();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  finished_ = true;
+  return error;
+}
+
+std::string ResumableUpload::GetSessionFile(const std::string& session_dir,
+                                            const std::string& bucket,
+                                            const std::string& path,
+                                            const std::string& file_path) {
+  std::stringstream name;
+  name << std::hex
+       << std::hash<std::string>()(bucket + '\n' + path + '\n' + file_path)
+       << ".session";
+  return session_dir + "/" + name.str();
+}
+
+int ResumableUpload::RunSession() {
+  if (!options_.session_dir.empty()) {
+    session_file_ =
+        GetSessionFile(options_.session_dir, bucket_, path_, file_path_);
+  }
+
+  int64_t offset = 0;
+  bool finished = false;
+  if (LoadSession() && QuerySession(&offset, &finished) != Error::kErrorNone) {
+    // The session has expired, or the file changed since.
+    RemoveSession();
+    offset = 0;
+    finished = false;
+  }
+  if (upload_url_.empty()) {
+    int error = StartSession();
+    if (error != Error::kErrorNone) {
+      return error;
+    }
+    SaveSession();
+  }
+
+  int64_t total = total_byte_count_;
+  ChunkReader reader(file_.get(), options_.chunk_size, options_.read_ahead);
+  int attempts = 0;
+  while (!finished) {
+    bytes_transferred_ = offset;
+    if (!WaitIfPaused()) {
+      CancelSession();
+      return Error::kErrorCancelled;
+    }
+
+    size_t chunk_size = 0;
+    const uint8_t* chunk = reader.Read(offset, &chunk_size);
+    bool last = offset + static_cast<int64_t>(chunk_size) == total;
+    if (options_.before_chunk) {
+      options_.before_chunk(offset + static_cast<int64_t>(chunk_size));
+      if (IsCanceled()) {
+        continue;
+      }
+    }
+
+    UploadRequest request;
+    request.url = upload_url_;
+    request.headers = {
+        {"X-Goog-Upload-Protocol", "resumable"},
+        {"X-Goog-Upload-Command", last ? "upload, finalize" : "upload"},
+        {"X-Goog-Upload-Offset", std::to_string(offset)},
+    };
+    request.body = chunk;
+    request.body_size = chunk_size;
+
+    int64_t reported = 0;
+    UploadResponse response;
+    bool sent = Post(request, &response, [&](int64_t bytes_sent) {
+      if (bytes_sent - reported >= kProgressStep) {
+        reported = bytes_sent;
+        on_progress_(offset + bytes_sent, total);
+      }
+      return !IsCanceled();
+    });
+
+    if (sent && response.status == 200) {
+      attempts = 0;
+      offset += chunk_size;
+      bytes_transferred_ = offset;
+      on_progress_(offset, total);
+      finished = last || GetHeader(response, "x-goog-upload-status") == "final";
+      if (finished) {
+        resource_ = std::move(response.body);
+      }
+      continue;
+    }
+    if (IsCanceled()) {
+      CancelSession();
+      return Error::kErrorCancelled;
+    }
+    if (sent && !IsRetryable(response.status)) {
+      LOG_ERROR("Upload rejected with status %ld", response.status);
+      RemoveSession();
+      return GetError(response.status);
+    }
+    if (++attempts > options_.max_retries) {
+      // The session is kept, so that the next upload of the file resumes it.
+      return Error::kErrorRetryLimitExceeded;
+    }
+    if (options_.on_retry) {
+      options_.on_retry();
+    }
+    if (!Backoff(attempts)) {
+      CancelSession();
+      return Error::kErrorCancelled;
+    }
+
+    // The server may have received a part of the chunk.
+    int64_t received = offset;
+    if (QuerySession(&received, &finished) == Error::kErrorNone) {
+      offset = received;
+    }
+  }
+
+  bytes_transferred_ = total;
+  RemoveSession();
+  return Error::kErrorNone;
+}
+
+int ResumableUpload::StartSession() {
+  UploadRequest request;
+  request.url = options_.endpoint + "/v0/b/" + UrlEncode(bucket_) +
+                "/o?name=" + UrlEncode(path_);
+  request.headers = {
+      {"X-Goog-Upload-Protocol", "resumable"},
+      {"X-Goog-Upload-Command", "start"},
+      {"X-Goog-Upload-Header-Content-Length",
+       std::to_string(total_byte_count_.load())},
+      {"Content-Type", "application/json; charset=utf-8"},
+  };
+  request.body = reinterpret_cast<const uint8_t*>(metadata_json_.data());
+  request.body_size = metadata_json_.size();
+
+  UploadResponse response;
+  if (!Post(request, &response, nullptr)) {
+    return IsCanceled() ? Error::kErrorCancelled : Error::kErrorUnknown;
+  }
+  if (response.status != 200) {
+    LOG_ERROR("Upload session refused with status %ld", response.status);
+    return response.status == 404 ? Error::kErrorBucketNotFound
+                                  : GetError(response.status);
+  }
+
+  upload_url_ = GetHeader(response, "x-goog-upload-url");
+  return upload_url_.empty() ? Error::kErrorUnknown : Error::kErrorNone;
+}
+
+int ResumableUpload::QuerySession(int64_t* offset, bool* finished) {
+  UploadRequest request;
+  request.url = upload_url_;
+  request.headers = {
+      {"X-Goog-Upload-Protocol", "resumable"},
+      {"X-Goog-Upload-Command", "query"},
+  };
+
+  UploadResponse response;
+  if (!Post(request, &response, nullptr)) {
+    return Error::kErrorRetryLimitExceeded;
+  }
+  if (response.status != 200) {
+    return GetError(response.status);
+  }
+
+  std::string status = GetHeader(response, "x-goog-upload-status");
+  if (status == "final") {
+    *finished = true;
+    return Error::kErrorNone;
+  }
+  if (status != "active") {
+    return Error::kErrorUnknown;
+  }
+  std::string received = GetHeader(response, "x-goog-upload-size-received");
+  if (received.empty()) {
+    return Error::kErrorUnknown;
+  }
+  char* end = nullptr;
+  errno = 0;
+  long long size = std::strtoll(received.c_str(), &end, 10);
+  if (errno != 0 || end == received.c_str() || *end != '\0' || size < 0 ||
+      size > total_byte_count_) {
+    LOG_ERROR("Invalid upload size received: %s", received.c_str());
+    return Error::kErrorUnknown;
+  }
+  *offset = size;
+  *finished = false;
+  return Error::kErrorNone;
+}
+
+void ResumableUpload::CancelSession() {
+  if (IsInterrupted()) {
+    return;
+  }
+
+  std::string upload_url = upload_url_;
+  RemoveSession();
+  if (upload_url.empty()) {
+    return;
+  }
+
+  UploadRequest request;
+  request.url = upload_url;
+  request.headers = {
+      {"X-Goog-Upload-Protocol", "resumable"},
+      {"X-Goog-Upload-Command", "cancel"},
+  };
+  UploadResponse response;
+  Post(request, &response, nullptr);
+}
+
+bool ResumableUpload::Post(
+    const UploadRequest& request,
+    UploadResponse* response,
+    const UploadTransport::ProgressCallback& on_progress) {
+  UploadTransport::ProgressCallback callback = on_progress;
+  if (!callback) {
+    callback = [this](int64_t /*bytes_sent*/) { return !IsCanceled(); };
+  }
+
+  return transport_->Post(request, response, callback);
+}
+
+bool ResumableUpload::Backoff(int attempt) {
+  auto delay = std::chrono::milliseconds(
+      std::min(10000, 250 * (1 << std::min(attempt - 1, 6))));
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait_for(lock, delay, [this] { return canceled_; });
+  return !canceled_;
+}
+
+bool ResumableUpload::WaitIfPaused() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (paused_ && !canceled_) {
+    lock.unlock();
+    on_paused_(bytes_transferred_, total_byte_count_);
+    lock.lock();
+    cv_.wait(lock, [this] { return !paused_ || canceled_; });
+  }
+  return !canceled_;
+}
+
+bool ResumableUpload::IsCanceled() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return canceled_;
+}
+
+bool ResumableUpload::Pause() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (finished_ || canceled_) {
+    return false;
+  }
+  paused_ = true;
+  return true;
+}
+
+bool ResumableUpload::Resume() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (finished_ || canceled_) {
+    return false;
+  }
+  paused_ = false;
+  cv_.notify_all();
+  return true;
+}
+
+bool ResumableUpload::Cancel() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (finished_ || canceled_) {
+    return false;
+  }
+  canceled_ = true;
+  cv_.notify_all();
+  return true;
+}
+
+void ResumableUpload::Interrupt() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  canceled_ = true;
+  interrupted_ = true;
+  cv_.notify_all();
+}
+
+bool ResumableUpload::IsInterrupted() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return interrupted_;
+}
+
+bool ResumableUpload::LoadSession() {
+  if (session_file_.empty()) {
+    return false;
+  }
+
+  std::ifstream file(session_file_);
+  std::map<std::string, std::string> values;
+  std::string line;
+  while (std::getline(file, line)) {
+    size_t separator = line.find('=');
+    if (separator != std::string::npos) {
+      values[line.substr(0, separator)] = line.substr(separator + 1);
+    }
+  }
+  if (values["bucket"] != bucket_ || values["path"] != path_ ||
+      values["file"] != file_path_ ||
+      values["size"] != std::to_string(total_byte_count_.load()) ||
+      values["mtime"] != std::to_string(file_->mtime()) ||
+      values["url"].empty()) {
+    return false;
+  }
+
+  upload_url_ = values["url"];
+  return true;
+}
+
+void ResumableUpload::SaveSession() {
+  if (session_file_.empty()) {
+    return;
+  }
+
+  std::ofstream file(session_file_, std::ios::trunc);
+  file << "url=" << upload_url_ << "\n"
+       << "bucket=" << bucket_ << "\n"
+       << "path=" << path_ << "\n"
+       << "file=" << file_path_ << "\n"
+       << "size=" << total_byte_count_ << "\n"
+       << "mtime=" << file_->mtime() << "\n";
+  if (!file) {
+    LOG_ERROR("Failed to write %s", session_file_.c_str());
+  }
+}
+
+void ResumableUpload::RemoveSession() {
+  if (!session_file_.empty()) {
+    std::remove(session_file_.c_str());
+  }
+  upload_url_.clear();
+}
@@ -0,0 +1,177 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_PLUGIN_FIREBASE_STORAGE_UPLOAD_H_
+#define FLUTTER_PLUGIN_FIREBASE_STORAGE_UPLOAD_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "firebase_storage_mapped_file.h"
+
+struct UploadRequest {
+  std::string url;
+  std::vector<std::pair<std::string, std::string>> headers;
+  const uint8_t* body = nullptr;
+  size_t body_size = 0;
+};
+
+struct UploadResponse {
+  long status = 0;
+  // The header names are in lower case.
+  std::map<std::string, std::string> headers;
+  std::string body;
+};
+
+// Sends the POST requests of an upload. |on_progress| is called with the
+// number of body bytes sent so far and aborts the request if it returns
+// false. Returns false if no response was received.
+class UploadTransport {
+ public:
+  using ProgressCallback = std::function<bool(int64_t bytes_sent)>;
+
+  virtual ~UploadTransport() = default;
+
+  virtual bool Post(const UploadRequest& request, UploadResponse* response,
+                    const ProgressCallback& on_progress) = 0;
+};
+
+class CurlUploadTransport : public UploadTransport {
+ public:
+  CurlUploadTransport();
+  ~CurlUploadTransport() override;
+
+  bool Post(const UploadRequest& request, UploadResponse* response,
+            const ProgressCallback& on_progress) override;
+
+ private:
+  void* curl_;
+};
+
+// Uploads a file with the resumable upload protocol of Cloud Storage for
+// Firebase. The file is sent in chunks straight from its mapping, and the
+// session is persisted so that a failed or interrupted upload of the same
+// file continues from the last chunk the server received. A session takes its
+// chunks in order, so they are sent one at a time.
+//
+// The requests carry no Firebase Auth or App Check token, which only the SDK
+// has, so this is only meant for the Storage emulator.
+class ResumableUpload {
+ public:
+  struct Options {
+    // e.g. "https://firebasestorage.googleapis.com".
+    std::string endpoint;
+    // The directory the sessions are persisted in. Sessions are not persisted
+    // if empty.
+    std::string session_dir;
+    // A multiple of 256 KiB, as required by the protocol.
+    size_t chunk_size = 2 * 1024 * 1024;
+    // The number of chunks prefetched from the file ahead of the one being
+    // sent.
+    size_t read_ahead = 2;
+    int max_retries = 5;
+    // Called before a chunk is sent with the offset it ends at. May block to
+    // slow the upload down.
+    std::function<void(int64_t end_offset)> before_chunk;
+    // Called whenever a chunk is about to be sent again.
+    std::function<void()> on_retry;
+  };
+
+  // Called with the bytes the server has received so far.
+  using ProgressCallback =
+      std::function<void(int64_t bytes_transferred, int64_t total_bytes)>;
+
+  // |file| is the mapping of |file_path|, or nullptr if it could not be
+  // mapped.
+  ResumableUpload(std::unique_ptr<UploadTransport> transport, Options options,
+                  std::string bucket, std::string path, std::string file_path,
+                  std::shared_ptr<const MappedFile> file,
+                  std::string metadata_json, ProgressCallback on_progress,
+                  ProgressCallback on_paused);
+  ~ResumableUpload();
+
+  // Returns the file the session of an upload is persisted in. It exists
+  // while an upload of the same file to the same object can be resumed.
+  static std::string GetSessionFile(const std::string& session_dir,
+                                    const std::string& bucket,
+                                    const std::string& path,
+                                    const std::string& file_path);
+
+  // Runs the upload on the calling thread and returns one of
+  // firebase::storage::Error.
+  int Run();
+
+  bool Pause();
+  bool Resume();
+  bool Cancel();
+
+  // Stops the upload like Cancel(), but keeps its session, so that the next
+  // upload of the file resumes it.
+  void Interrupt();
+  bool IsInterrupted();
+
+  int64_t bytes_transferred() const { return bytes_transferred_; }
+  int64_t total_byte_count() const { return total_byte_count_; }
+
+  // The object resource the server sent, as JSON, once Run() has succeeded.
+  // Empty if the upload had been finished by an earlier run.
+  const std::string& resource() const { return resource_; }
+
+ private:
+  class ChunkReader;
+
+  int RunSession();
+  int StartSession();
+  int QuerySession(int64_t* offset, bool* finished);
+  void CancelSession();
+
+  bool Post(const UploadRequest& request, UploadResponse* response,
+            const UploadTransport::ProgressCallback& on_progress);
+
+  // Waits before the |attempt|th retry. Returns false if the upload was
+  // cancelled meanwhile.
+  bool Backoff(int attempt);
+
+  // Blocks while the upload is paused. Returns false if it was cancelled.
+  bool WaitIfPaused();
+  bool IsCanceled();
+
+  bool LoadSession();
+  void SaveSession();
+  void RemoveSession();
+
+  std::unique_ptr<UploadTransport> transport_;
+  Options options_;
+  std::string bucket_;
+  std::string path_;
+  std::string file_path_;
+  std::shared_ptr<const MappedFile> file_;
+  std::string metadata_json_;
+  ProgressCallback on_progress_;
+  ProgressCallback on_paused_;
+
+  std::string session_file_;
+  std::string upload_url_;
+  std::string resource_;
+
+  std::atomic<int64_t> bytes_transferred_{0};
+  std::atomic<int64_t> total_byte_count_{0};
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool paused_{false};
+  bool canceled_{false};
+  bool interrupted_{false};
+  bool finished_{false};
+};
+
+#endif  // FLUTTER_PLUGIN_FIREBASE_STORAGE_UPLOAD_H_
@@ -4,49 +4,555 @@
 
 #include "firebase_storage_utils.h"
 
+#include <app_common.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
-#include "firebase/app/src/base64.h"
+#include "common/app_events.h"
+#include "common/payload.h"
 #include "firebase/storage/controller.h"
+#include "firebase_storage_base64.h"
 #include "firebase_storage_error.h"
 
-namespace utils {
+namespace {
 
-firebase::storage::Storage* GetStorage(MethodCallArguments* args) {
-  auto appName = args->GetRequiredArg<std::string>("appName");
-  firebase::App* app = firebase::App::GetInstance(appName.data());
-  if (!app) {
-    throw FirebaseStorageError(FirebaseStorageError::Code::kAppNotFound);
+std::string GetJsonString(const std::string& value) {
+  std::ostringstream os;
+  os << '"';
+  for (unsigned char c : value) {
+    switch (c) {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      case '\n':
+        os << "\\n";
+        break;
+      case '\r':
+        os << "\\r";
+        break;
+      case '\t':
+        os << "\\t";
+        break;
+      default:
+        if (c < 0x20) {
+          char escaped[7];
+          snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+          os << escaped;
+        } else {
+          os << c;
+        }
+    }
+  }
+  os << '"';
+  return os.str();
+}
+
+// Parses the JSON responses of the Storage REST API into EncodableValues.
+// Numbers without a fraction or exponent become int64_t, other numbers
+// double.
+class JsonParser {
+ public:
+  explicit JsonParser(std::string_view json) : json_(json) {}
+
+  bool Parse(flutter::EncodableValue* value) {
+    if (!ParseValue(value, 0)) {
+      return false;
+    }
+    SkipSpace();
+    return pos_ == json_.size();
+  }
+
+ private:
+  // Bounds the recursion on malformed input.
+  static constexpr int kMaxDepth = 32;
+
+  void SkipSpace() {
+    while (pos_ < json_.size() &&
+           (json_[pos_] == ' ' || json_[pos_] == '\t' || json_[pos_] == '\n' ||
+            json_[pos_] == '\r')) {
+      pos_++;
+    }
+  }
+
+  bool Consume(char c) {
+    SkipSpace();
+    if (pos_ < json_.size() && json_[pos_] == c) {
+      pos_++;
+      return true;
+    }
+    return false;
+  }
+
+  bool ConsumeLiteral(std::string_view literal) {
+    if (json_.compare(pos_, literal.size(), literal) != 0) {
+      return false;
+    }
+    pos_ += literal.size();
+    return true;
+  }
+
+  bool ParseValue(flutter::EncodableValue* value, int depth) {
+    SkipSpace();
+    if (pos_ == json_.size() || depth > kMaxDepth) {
+      return false;
+    }
+    switch (json_[pos_]) {
+      case '{':
+        return ParseObject(value, depth);
+      case '[':
+        return ParseArray(value, depth);
+      case '"': {
+        std::string string;
+        if (!ParseString(&string)) {
+          return false;
+        }
+        *value = flutter::EncodableValue(std::move(string));
+        return true;
+      }
+      case 't':
+        *value = flutter::EncodableValue(true);
+        return ConsumeLiteral("true");
+      case 'f':
+        *value = flutter::EncodableValue(false);
+        return ConsumeLiteral("false");
+      case 'n':
+        *value = flutter::EncodableValue();
+        return ConsumeLiteral("null");
+      default:
+        return ParseNumber(value);
+    }
+  }
+
+  bool ParseObject(flutter::EncodableValue* value, int depth) {
+    pos_++;
+    flutter::EncodableMap map;
+    if (!Consume('}')) {
+      do {
+        std::string key;
+        flutter::EncodableValue member;
+        SkipSpace();
+        if (!ParseString(&key) || !Consume(':') ||
+            !ParseValue(&member, depth + 1)) {
+          return false;
+        }
+        map[flutter::EncodableValue(std::move(key))] = std::move(member);
+      } while (Consume(','));
+      if (!Consume('}')) {
+        return false;
+      }
+    }
+    *value = flutter::EncodableValue(std::move(map));
+    return true;
   }
 
-  firebase::storage::Storage* storage = nullptr;
-  auto bucket = args->GetArg<std::string>("bucket");
+  bool ParseArray(flutter::EncodableValue* value, int depth) {
+    pos_++;
+    flutter::EncodableList list;
+    if (!Consume(']')) {
+      do {
+        flutter::EncodableValue element;
+        if (!ParseValue(&element, depth + 1)) {
+          return false;
+        }
+        list.push_back(std::move(element));
+      } while (Consume(','));
+      if (!Consume(']')) {
+        return false;
+      }
+    }
+    *value = flutter::EncodableValue(std::move(list));
+    return true;
+  }
+
+  bool ParseString(std::string* string) {
+    if (pos_ == json_.size() || json_[pos_] != '"') {
+      return false;
+    }
+    pos_++;
+    while (pos_ < json_.size()) {
+      char c = json_[pos_++];
+      if (c == '"') {
+        return true;
+      }
+      if (static_cast<unsigned char>(c) < 0x20) {
+        return false;
+      }
+      if (c != '\\') {
+        string->push_back(c);
+        continue;
+      }
+      if (pos_ == json_.size()) {
+        return false;
+      }
+      switch (json_[pos_++]) {
+        case '"':
+          string->push_back('"');
+          break;
+        case '\\':
+          string->push_back('\\');
+          break;
+        case '/':
+          string->push_back('/');
+          break;
+        case 'b':
+          string->push_back('\b');
+          break;
+        case 'f':
+          string->push_back('\f');
+          break;
+        case 'n':
+          string->push_back('\n');
+          break;
+        case 'r':
+          string->push_back('\r');
+          break;
+        case 't':
+          string->push_back('\t');
+          break;
+        case 'u': {
+          uint32_t code_point;
+          if (!ParseHex(&code_point)) {
+            return false;
+          }
+          if (code_point >= 0xd800 && code_point < 0xdc00) {
+            // A high surrogate, followed by the low one.
+            uint32_t low;
+            if (!ConsumeLiteral("\\u") || !ParseHex(&low) || low < 0xdc00 ||
+                low >= 0xe000) {
+              return false;
+            }
+            code_point = 0x10000 + ((code_point - 0xd800) << 10) +
+                         (low - 0xdc00);
+          }
+          AppendUtf8(code_point, string);
+          break;
+        }
+        default:
+          return false;
+      }
+    }
+    return false;
+  }
 
-  if (bucket.has_value()) {
-    std::string url("gs://" + bucket.value());
-    storage = firebase::storage::Storage::GetInstance(app, url.data());
-  } else {
-    storage = firebase::storage::Storage::GetInstance(app);
+  bool ParseHex(uint32_t* value) {
+    if (json_.size() - pos_ < 4) {
+      return false;
+    }
+    *value = 0;
+    for (int i = 0; i < 4; i++) {
+      char c = json_[pos_++];
+      *value <<= 4;
+      if (c >= '0' && c <= '9') {
+        *value |= c - '0';
+      } else if (c >= 'a' && c <= 'f') {
+        *value |= c - 'a' + 10;
+      } else if (c >= 'A' && c <= 'F') {
+        *value |= c - 'A' + 10;
+      } else {
+        return false;
+      }
+    }
+    return true;
   }
 
-  auto max_operation_retry_time = args->GetArg<double>("maxOperationRetryTime");
-  if (max_operation_retry_time.has_value()) {
-    storage->set_max_operation_retry_time(max_operation_retry_time.value());
+  static void AppendUtf8(uint32_t code_point, std::string* string) {
+    if (code_point < 0x80) {
+      string->push_back(static_cast<char>(code_point));
+    } else if (code_point < 0x800) {
+      string->push_back(static_cast<char>(0xc0 | (code_point >> 6)));
+      string->push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+    } else if (code_point < 0x10000) {
+      string->push_back(static_cast<char>(0xe0 | (code_point >> 12)));
+      string->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3f)));
+      string->push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+    } else {
+      string->push_back(static_cast<char>(0xf0 | (code_point >> 18)));
+      string->push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3f)));
+      string->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3f)));
+      string->push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+    }
   }
 
-  auto max_download_retry_time = args->GetArg<double>("maxDownloadRetryTime");
-  if (max_download_retry_time.has_value()) {
-    storage->set_max_download_retry_time(max_download_retry_time.value());
+  bool ParseNumber(flutter::EncodableValue* value) {
+    size_t start = pos_;
+    bool is_integer = true;
+    while (pos_ < json_.size()) {
+      char c = json_[pos_];
+      if (c == '.' || c == 'e' || c == 'E' || c == '+') {
+        is_integer = false;
+      } else if (c != '-' && !isdigit(static_cast<unsigned char>(c))) {
+        break;
+      }
+      pos_++;
+    }
+    std::string number(json_.substr(start, pos_ - start));
+    if (number.empty()) {
+      return false;
+    }
+
+    char* end = nullptr;
+    errno = 0;
+    if (is_integer) {
+      long long integer = strtoll(number.c_str(), &end, 10);
+      *value = flutter::EncodableValue(static_cast<int64_t>(integer));
+    } else {
+      *value = flutter::EncodableValue(strtod(number.c_str(), &end));
+    }
+    return *end == '\0' && errno == 0;
+  }
+
+  std::string_view json_;
+  size_t pos_ = 0;
+};
+
+// Returns the milliseconds since the epoch of the RFC 3339 time |time|, or 0
+// if it is not one.
+int64_t ParseTimeMillis(const std::string& time) {
+  std::tm tm = {};
+  int consumed = 0;
+  if (sscanf(time.c_str(), "%4d-%2d-%2dT%2d:%2d:%2d%n", &tm.tm_year,
+             &tm.tm_mon, &tm.tm_mday, &tm.tm_hour, &tm.tm_min, &tm.tm_sec,
+             &consumed) != 6) {
+    return 0;
+  }
+  tm.tm_year -= 1900;
+  tm.tm_mon -= 1;
+  int64_t millis = static_cast<int64_t>(timegm(&tm)) * 1000;
+
+  const char* rest = time.c_str() + consumed;
+  if (*rest == '.') {
+    rest++;
+    for (int scale = 100; isdigit(static_cast<unsigned char>(*rest)); rest++) {
+      millis += (*rest - '0') * scale;
+      scale /= 10;
+    }
+  }
+  int offset_hours = 0;
+  int offset_minutes = 0;
+  if ((*rest == '+' || *rest == '-') &&
+      sscanf(rest + 1, "%2d:%2d", &offset_hours, &offset_minutes) == 2) {
+    int64_t offset = (offset_hours * 60 + offset_minutes) * 60 * 1000;
+    millis += *rest == '+' ? -offset : offset;
+  }
+  return millis;
+}
+
+struct StorageSettings {
+  std::optional<double> max_operation_retry_time;
+  std::optional<double> max_download_retry_time;
+  std::optional<double> max_upload_retry_time;
+};
+
+// Caches the Storage instance of each app and bucket, along with the settings
+// last applied to it, so that a call only touches the instance when its
+// settings differ. The entries of an app are dropped when it is deleted.
+class StorageRegistry {
+ public:
+  static StorageRegistry& GetInstance() {
+    static StorageRegistry instance;
+    return instance;
+  }
+
+  // |bucket| is empty for the default bucket of |app|.
+  firebase::storage::Storage* Get(firebase::App* app,
+                                  const std::string& app_name,
+                                  const std::string& bucket,
+                                  const StorageSettings& settings) {
+    // The SDK keys its instances by URL, so the default bucket and its
+    // explicit name share one instance, and one entry.
+    const char* bucket_name =
+        bucket.empty() ? app->options().storage_bucket() : bucket.c_str();
+    std::string url;
+    if (bucket_name && *bucket_name) {
+      url = std::string("gs://") + bucket_name;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& entry = entries_[app_name][url];
+    if (!entry.storage) {
+      entry.storage =
+          url.empty()
+              ? firebase::storage::Storage::GetInstance(app)
+              : firebase::storage::Storage::GetInstance(app, url.data());
+      if (!entry.storage) {
+        return nullptr;
+      }
+    }
+
+    Apply(settings.max_operation_retry_time,
+          &entry.settings.max_operation_retry_time, entry.storage,
+          &firebase::storage::Storage::set_max_operation_retry_time);
+    Apply(settings.max_download_retry_time,
+          &entry.settings.max_download_retry_time, entry.storage,
+          &firebase::storage::Storage::set_max_download_retry_time);
+    Apply(settings.max_upload_retry_time,
+          &entry.settings.max_upload_retry_time, entry.storage,
+          &firebase::storage::Storage::set_max_upload_retry_time);
+    return entry.storage;
+  }
+
+  void SetEmulator(const std::string& app_name, std::string origin) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    emulators_[app_name] = std::move(origin);
+  }
+
+  // Returns the origin of the emulator of |app_name|, or an empty string.
+  std::string GetEmulator(const std::string& app_name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = emulators_.find(app_name);
+    return it == emulators_.end() ? "" : it->second;
+  }
+
+ private:
+  struct Entry {
+    firebase::storage::Storage* storage = nullptr;
+    StorageSettings settings;
+  };
+
+  StorageRegistry() {
+    // The SDK deletes the instances of an app along with it, and an app
+    // created later under the same name may reuse its address.
+    AddAppDeletedListener([this](firebase::App* app) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      entries_.erase(app->name());
+      emulators_.erase(app->name());
+    });
+  }
+
+  static void Apply(const std::optional<double>& value,
+                    std::optional<double>* applied,
+                    firebase::storage::Storage* storage,
+                    void (firebase::storage::Storage::*setter)(double)) {
+    if (value.has_value() && value != *applied) {
+      (storage->*setter)(value.value());
+      *applied = value;
+    }
+  }
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::unordered_map<std::string, Entry>>
+      entries_;
+  std::unordered_map<std::string, std::string> emulators_;
+};
+
+// Returns the directory |name| in the app data directory, creating it if
+// needed, or an empty string on failure.
+std::string GetDataDirectory(const char* name) {
+  char* data_path = app_get_data_path();
+  if (!data_path) {
+    return "";
+  }
+  std::string path = std::string(data_path) + name;
+  free(data_path);
+
+  if (mkdir(path.c_str(), 0700) != 0 && errno != EEXIST) {
+    return "";
+  }
+  return path;
+}
+
+bool PercentDecode(std::string_view input, std::vector<uint8_t>* output) {
+  output->clear();
+  output->reserve(input.size());
+  for (size_t i = 0; i < input.size(); ++i) {
+    if (input[i] != '%') {
+      output->push_back(static_cast<uint8_t>(input[i]));
+      continue;
+    }
+    if (i + 2 >= input.size() || !isxdigit(input[i + 1]) ||
+        !isxdigit(input[i + 2])) {
+      return false;
+    }
+    output->push_back(static_cast<uint8_t>(
+        std::stoi(std::string(input.substr(i + 1, 2)), nullptr, 16)));
+    i += 2;
+  }
+  return true;
+}
+
+// A file whose bytes match |prefix| at its start and |tag| at |tag_offset|
+// is of the media type |content_type|.
+struct FileSignature {
+  std::string_view prefix;
+  size_t tag_offset;
+  std::string_view tag;
+  const char* content_type;
+};
+
+// The more specific signatures of a prefix come first.
+constexpr FileSignature kFileSignatures[] = {
+    {"\x89PNG\r\n\x1a\n", 0, "", "image/png"},
+    {"\xff\xd8\xff", 0, "", "image/jpeg"},
+    {"GIF87a", 0, "", "image/gif"},
+    {"GIF89a", 0, "", "image/gif"},
+    {"RIFF", 8, "WEBP", "image/webp"},
+    {"RIFF", 8, "WAVE", "audio/wav"},
+    {"RIFF", 8, "AVI ", "video/x-msvideo"},
+    {"", 4, "ftypheic", "image/heic"},
+    {"", 4, "ftypheix", "image/heic"},
+    {"", 4, "ftypavif", "image/avif"},
+    {"", 4, "ftypqt  ", "video/quicktime"},
+    {"", 4, "ftyp", "video/mp4"},
+    {"\x1a\x45\xdf\xa3", 0, "", "video/webm"},
+    {"ID3", 0, "", "audio/mpeg"},
+    {"OggS", 0, "", "audio/ogg"},
+    {"fLaC", 0, "", "audio/flac"},
+    {"%PDF-", 0, "", "application/pdf"},
+    {"PK\x03\x04", 0, "", "application/zip"},
+    {"\x1f\x8b", 0, "", "application/gzip"},
+    {"BM", 0, "", "image/bmp"},
+};
+
+bool HasBytes(std::string_view bytes, size_t offset, std::string_view value) {
+  return bytes.size() >= offset + value.size() &&
+         bytes.compare(offset, value.size(), value) == 0;
+}
+
+}  // namespace
+
+namespace utils {
+
+firebase::storage::Storage* GetStorage(MethodCallArguments* args) {
+  if (IsEmulated(args->GetRequiredArgRef<std::string>("appName"))) {
+    // The SDK cannot be pointed at the emulator, and would go to production.
+    throw FirebaseStorageError(
+        FirebaseStorageError::Code::kUnimplemented,
+        "Only putFile() is implemented with the Storage emulator.");
   }
+  return GetStorageIgnoringEmulator(args);
+}
 
-  auto max_upload_retry_time = args->GetArg<double>("maxUploadRetryTime");
-  if (max_upload_retry_time.has_value()) {
-    storage->set_max_upload_retry_time(max_upload_retry_time.value());
+firebase::storage::Storage* GetStorageIgnoringEmulator(
+    MethodCallArguments* args) {
+  const auto& app_name = args->GetRequiredArgRef<std::string>("appName");
+  firebase::App* app = firebase::App::GetInstance(app_name.data());
+  if (!app) {
+    throw FirebaseStorageError(FirebaseStorageError::Code::kAppNotFound);
   }
 
-  return storage;
+  static const std::string kDefaultBucket;
+  auto bucket = args->GetArgPointer<std::string>("bucket");
+  return StorageRegistry::GetInstance().Get(
+      app, app_name, bucket ? *bucket : kDefaultBucket,
+      StorageSettings{args->GetArg<double>("maxOperationRetryTime"),
+                      args->GetArg<double>("maxDownloadRetryTime"),
+                      args->GetArg<double>("maxUploadRetryTime")});
 }
 
 firebase::storage::StorageReference GetStorageReference(
@@ -55,11 +561,32 @@ firebase::storage::StorageReference GetStorageReference(
       args->GetRequiredArg<std::string>("path"));
 }
 
-bool StringToByteData(const std::string& input, std::string* output,
-                      int format) {
+bool StringToByteData(const std::string& input, int format,
+                      std::vector<uint8_t>* output,
+                      std::string* content_type) {
+  std::string_view data = input;
+  base64::Alphabet alphabet = base64::Alphabet::kStandard;
   switch (format) {
+    case 0:  // PutStringFormat.raw
+      output->assign(input.begin(), input.end());
+      return true;
     case 1:  // PutStringFormat.base64
-      return firebase::internal::Base64Decode(input, output);
+      break;
+    case 2:  // PutStringFormat.base64Url
+      alphabet = base64::Alphabet::kUrl;
+      break;
+    case 3: {  // PutStringFormat.dataUrl
+      std::string_view media_type;
+      bool is_base64;
+      if (!base64::ParseDataUrl(input, &media_type, &is_base64, &data)) {
+        return false;
+      }
+      content_type->assign(media_type);
+      if (!is_base64) {
+        return PercentDecode(data, output);
+      }
+      break;
+    }
     default:
       std::ostringstream os;
       os << "This format(" << format << ") is not supported yet.";
@@ -67,7 +594,8 @@ bool StringToByteData(const std::string& input, std::string* output,
                                  os.str());
   }
 
-  return false;
+  output->resize(base64::GetDecodedSize(data));
+  return base64::Decode(data, alphabet, output->data());
 }
 
 firebase::storage::Metadata ParseMetadata(const flutter::EncodableMap& value) {
@@ -114,6 +642,136 @@ firebase::storage::Metadata ParseMetadata(const flutter::EncodableMap& value) {
   return out;
 }
 
+std::string GetMetadataJson(const std::string& path,
+                            const flutter::EncodableMap* metadata,
+                            const std::string& content_type) {
+  std::ostringstream os;
+  os << "{\"name\":" << GetJsonString(path);
+  bool has_content_type = false;
+  if (metadata) {
+    MethodCallArguments args(metadata);
+    for (const char* key : {"cacheControl", "contentDisposition",
+                            "contentEncoding", "contentLanguage",
+                            "contentType"}) {
+      auto value = args.GetArgPointer<std::string>(key);
+      if (value) {
+        os << ",\"" << key << "\":" << GetJsonString(*value);
+        has_content_type |= std::string_view(key) == "contentType";
+      }
+    }
+
+    auto custom_metadata =
+        args.GetArgPointer<flutter::EncodableMap>("customMetadata");
+    if (custom_metadata) {
+      os << ",\"metadata\":{";
+      bool first = true;
+      for (const auto& [key, value] : *custom_metadata) {
+        auto key_string = std::get_if<std::string>(&key);
+        auto value_string = std::get_if<std::string>(&value);
+        if (key_string && value_string) {
+          os << (first ? "" : ",") << GetJsonString(*key_string) << ":"
+             << GetJsonString(*value_string);
+          first = false;
+        }
+      }
+      os << "}";
+    }
+  }
+  if (!has_content_type && !content_type.empty()) {
+    os << ",\"contentType\":" << GetJsonString(content_type);
+  }
+  os << "}";
+  return os.str();
+}
+
+std::string SniffContentType(const uint8_t* data, size_t size) {
+  std::string_view bytes(reinterpret_cast<const char*>(data), size);
+  for (const auto& signature : kFileSignatures) {
+    if (HasBytes(bytes, 0, signature.prefix) &&
+        HasBytes(bytes, signature.tag_offset, signature.tag)) {
+      return signature.content_type;
+    }
+  }
+  return "";
+}
+
+void UseEmulator(const std::string& app_name, const std::string& host,
+                 int port) {
+  // IPv6 addresses are bracketed in URLs.
+  std::string authority = host.find(':') != std::string::npos &&
+                                  host.front() != '['
+                              ? "[" + host + "]"
+                              : host;
+  StorageRegistry::GetInstance().SetEmulator(
+      app_name, "http://" + authority + ":" + std::to_string(port));
+}
+
+bool IsEmulated(const std::string& app_name) {
+  return !StorageRegistry::GetInstance().GetEmulator(app_name).empty();
+}
+
+std::string GetUploadEndpoint(const std::string& app_name) {
+  std::string emulator = StorageRegistry::GetInstance().GetEmulator(app_name);
+  return emulator.empty() ? "https://firebasestorage.googleapis.com"
+                          : emulator;
+}
+
+std::string GetUploadSessionDirectory() {
+  return GetDataDirectory("firebase_storage_uploads");
+}
+
+std::string GetDownloadCacheDirectory() {
+  return GetDataDirectory("firebase_storage_cache");
+}
+
+std::string GetTransferJournalDirectory() {
+  return GetDataDirectory("firebase_storage_journal");
+}
+
+std::string GetStreamSpoolDirectory() {
+  static const std::string directory = [] {
+    std::string path = GetDataDirectory("firebase_storage_streams");
+    DIR* dir = path.empty() ? nullptr : opendir(path.c_str());
+    if (dir) {
+      while (dirent* file = readdir(dir)) {
+        if (file->d_name[0] != '.') {
+          std::remove((path + "/" + file->d_name).c_str());
+        }
+      }
+      closedir(dir);
+    }
+    return path;
+  }();
+  return directory;
+}
+
+void WriteMetadata(PayloadWriter& writer,
+                   const firebase::storage::Metadata* metadata) {
+  writer.WriteMap(16);
+  writer.WriteEntry("bucket", metadata->bucket());
+  writer.WriteEntry("cacheControl", metadata->cache_control());
+  writer.WriteEntry("contentDisposition", metadata->content_disposition());
+  writer.WriteEntry("contentEncoding", metadata->content_encoding());
+  writer.WriteEntry("contentLanguage", metadata->content_language());
+  writer.WriteEntry("contentType", metadata->content_type());
+  writer.WriteEntry("fullPath", metadata->path());
+  writer.WriteEntry("generation", metadata->generation());
+  writer.WriteEntry("metadataGeneration", metadata->metadata_generation());
+  writer.WriteEntry("md5Hash", metadata->md5_hash());
+  writer.WriteEntry("metageneration", metadata->metadata_generation());
+  writer.WriteEntry("name", metadata->name());
+  writer.WriteEntry("size", metadata->size_bytes());
+  writer.WriteEntry("creationTimeMillis", metadata->creation_time());
+  writer.WriteEntry("updatedTimeMillis", metadata->updated_time());
+
+  const auto* custom_metadata = metadata->custom_metadata();
+  writer.WriteString("customMetadata");
+  writer.WriteMap(custom_metadata->size());
+  for (const auto& [key, value] : *custom_metadata) {
+    writer.WriteEntry(key, value);
+  }
+}
+
 flutter::EncodableValue GetMetadataValue(
     const firebase::storage::Metadata* metadata) {
   auto metadata_map = flutter::EncodableMap{
@@ -160,6 +818,82 @@ flutter::EncodableValue GetMetadataValue(
   return flutter::EncodableValue(metadata_map);
 }
 
+bool ParseObjectResource(const std::string& json,
+                         flutter::EncodableMap* metadata) {
+  flutter::EncodableValue value;
+  if (!JsonParser(json).Parse(&value)) {
+    return false;
+  }
+  auto resource = std::get_if<flutter::EncodableMap>(&value);
+  if (!resource) {
+    return false;
+  }
+
+  auto get_string = [resource](const char* key) {
+    auto it = resource->find(flutter::EncodableValue(key));
+    auto string = it != resource->end()
+                      ? std::get_if<std::string>(&it->second)
+                      : nullptr;
+    return string ? *string : std::string();
+  };
+  // The API sends 64-bit numbers as strings.
+  auto get_int = [&get_string](const char* key) {
+    return static_cast<int64_t>(
+        strtoll(get_string(key).c_str(), nullptr, 10));
+  };
+
+  std::string full_path = get_string("name");
+  int64_t generation = get_int("generation");
+  int64_t metageneration = get_int("metageneration");
+  *metadata = flutter::EncodableMap{
+      {flutter::EncodableValue("bucket"),
+       flutter::EncodableValue(get_string("bucket"))},
+      {flutter::EncodableValue("cacheControl"),
+       flutter::EncodableValue(get_string("cacheControl"))},
+      {flutter::EncodableValue("contentDisposition"),
+       flutter::EncodableValue(get_string("contentDisposition"))},
+      {flutter::EncodableValue("contentEncoding"),
+       flutter::EncodableValue(get_string("contentEncoding"))},
+      {flutter::EncodableValue("contentLanguage"),
+       flutter::EncodableValue(get_string("contentLanguage"))},
+      {flutter::EncodableValue("contentType"),
+       flutter::EncodableValue(get_string("contentType"))},
+      {flutter::EncodableValue("fullPath"), flutter::EncodableValue(full_path)},
+      {flutter::EncodableValue("generation"),
+       flutter::EncodableValue(generation)},
+      {flutter::EncodableValue("metadataGeneration"),
+       flutter::EncodableValue(metageneration)},
+      {flutter::EncodableValue("md5Hash"),
+       flutter::EncodableValue(get_string("md5Hash"))},
+      {flutter::EncodableValue("metageneration"),
+       flutter::EncodableValue(metageneration)},
+      {flutter::EncodableValue("name"),
+       flutter::EncodableValue(full_path.substr(full_path.rfind('/') + 1))},
+      {flutter::EncodableValue("size"),
+       flutter::EncodableValue(get_int("size"))},
+      {flutter::EncodableValue("creationTimeMillis"),
+       flutter::EncodableValue(ParseTimeMillis(get_string("timeCreated")))},
+      {flutter::EncodableValue("updatedTimeMillis"),
+       flutter::EncodableValue(ParseTimeMillis(get_string("updated")))},
+  };
+
+  flutter::EncodableMap custom_metadata;
+  auto it = resource->find(flutter::EncodableValue("metadata"));
+  auto map = it != resource->end()
+                 ? std::get_if<flutter::EncodableMap>(&it->second)
+                 : nullptr;
+  if (map) {
+    for (const auto& [key, value] : *map) {
+      if (std::holds_alternative<std::string>(value)) {
+        custom_metadata[key] = value;
+      }
+    }
+  }
+  (*metadata)[flutter::EncodableValue("customMetadata")] =
+      flutter::EncodableValue(std::move(custom_metadata));
+  return true;
+}
+
 static flutter::EncodableMap GetTaskEventMap(const int handle,
                                              const std::string& name,
                                              const std::string& bucket) {
@@ -199,15 +933,52 @@ flutter::EncodableValue GetTaskEventValue(const StorageTaskData& data,
   return flutter::EncodableValue(map);
 }
 
+static void WriteTaskEvent(PayloadWriter& writer, const StorageTaskData& data,
+                           int64_t bytes_transferred, int64_t total_bytes) {
+  writer.WriteMap(4);
+  writer.WriteEntry("handle", static_cast<int32_t>(data.handle));
+  writer.WriteEntry("appName", data.app_name);
+  writer.WriteEntry("bucket", data.bucket);
+  writer.WriteString("snapshot");
+  writer.WriteMap(3);
+  writer.WriteEntry("path", data.path);
+  writer.WriteEntry("bytesTransferred", bytes_transferred);
+  writer.WriteEntry("totalBytes", total_bytes);
+}
+
+flutter::EncodableValue GetTaskEventPayload(const StorageTaskData& data,
+                                            int64_t bytes_transferred,
+                                            int64_t total_bytes) {
+  return MakePayload(
+      [&data, bytes_transferred, total_bytes](PayloadWriter& writer) {
+        WriteTaskEvent(writer, data, bytes_transferred, total_bytes);
+      });
+}
+
+flutter::EncodableValue GetTaskProgressBatchPayload(
+    const std::vector<TaskProgress>& progress) {
+  return MakePayload([&progress](PayloadWriter& writer) {
+    writer.WriteMap(1);
+    writer.WriteString("events");
+    writer.WriteList(progress.size());
+    for (const auto& task : progress) {
+      WriteTaskEvent(writer, task.data, task.bytes_transferred,
+                     task.total_bytes);
+    }
+  });
+}
+
 flutter::EncodableValue GetTaskControlEventValue(
-    const bool status, const std::string& path,
-    const firebase::storage::Controller* controller) {
+    const bool status,
+    const std::string& path,
+    const int64_t bytes_transferred,
+    const int64_t total_bytes) {
   auto map = flutter::EncodableMap{
       {flutter::EncodableValue("status"), flutter::EncodableValue(status)},
   };
   if (status) {
-    flutter::EncodableMap snapshot = GetSnapshotMap(
-        path, controller->bytes_transferred(), controller->total_byte_count());
+    flutter::EncodableMap snapshot =
+        GetSnapshotMap(path, bytes_transferred, total_bytes);
 
     map[flutter::EncodableValue("snapshot")] =
         flutter::EncodableValue(snapshot);
@@ -267,6 +1038,22 @@ flutter::EncodableValue GetPutTaskSuccessEventValue(
   return flutter::EncodableValue(map);
 }
 
+flutter::EncodableValue GetPutTaskSuccessEventValue(
+    const StorageTaskData& data, const int64_t total_bytes,
+    flutter::EncodableMap metadata) {
+  flutter::EncodableMap map =
+      GetTaskEventMap(data.handle, data.app_name, data.bucket);
+
+  flutter::EncodableMap snapshot =
+      GetSnapshotMap(data.path, total_bytes, total_bytes);
+  snapshot[flutter::EncodableValue("metadata")] =
+      flutter::EncodableValue(std::move(metadata));
+  map[flutter::EncodableValue("snapshot")] =
+      flutter::EncodableValue(std::move(snapshot));
+
+  return flutter::EncodableValue(map);
+}
+
 flutter::EncodableValue GetTaskErrorEventValue(const StorageTaskData& data,
                                                const int error_code,
                                                const char* error_message) {
@@ -308,4 +1095,16 @@ flutter::EncodableValue ParseListResult(
   return flutter::EncodableValue(map);
 }
 
+flutter::EncodableValue GetListAllValue(flutter::EncodableList&& items,
+                                        flutter::EncodableList&& prefixes) {
+  // Assigned rather than constructed, which would copy the lists.
+  flutter::EncodableMap map;
+  map[flutter::EncodableValue("items")] = std::move(items);
+  map[flutter::EncodableValue("prefixes")] = std::move(prefixes);
+
+  flutter::EncodableValue value;
+  value = std::move(map);
+  return value;
+}
+
 }  // namespace utils
@@ -7,11 +7,15 @@
 
 #include <flutter/encodable_value.h>
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include "firebase/storage.h"
 #include "flutter_types.hpp"
 
+class PayloadWriter;
+
 namespace utils {
 
 struct StorageTaskData {
@@ -21,31 +25,116 @@ struct StorageTaskData {
   std::string bucket;
 };
 
+// Returns the Storage instance of the app and bucket in |args|. Throws
+// FirebaseStorageError if there is no such app, or if the app uses the
+// Storage emulator, which the SDK cannot reach. See UseEmulator().
 firebase::storage::Storage* GetStorage(MethodCallArguments* args);
 
+// Same as GetStorage(), for the uploads that reach the emulator on their own.
+firebase::storage::Storage* GetStorageIgnoringEmulator(
+    MethodCallArguments* args);
+
 firebase::storage::StorageReference GetStorageReference(
     MethodCallArguments* args);
 
-bool StringToByteData(const std::string& input, std::string* output,
-                      int format);
+// Decodes |input|, which is in the PutStringFormat |format|, into |output|.
+// Sets |content_type| to the media type of data URLs. Returns false if
+// |input| is not valid in |format|.
+bool StringToByteData(const std::string& input, int format,
+                      std::vector<uint8_t>* output,
+                      std::string* content_type);
 
 firebase::storage::Metadata ParseMetadata(const flutter::EncodableMap& value);
 
+// Returns the object resource of an upload to |path| as JSON. |content_type|
+// is used unless |metadata| sets one.
+std::string GetMetadataJson(const std::string& path,
+                            const flutter::EncodableMap* metadata,
+                            const std::string& content_type);
+
+// Returns the media type that the leading bytes of a file identify, or an
+// empty string if they identify none.
+std::string SniffContentType(const uint8_t* data, size_t size);
+
+// Routes the transfers of the app |app_name| that the plugin makes itself,
+// i.e. resumable uploads, to the Storage emulator at |host|:|port|. All other
+// operations of the app then fail with Code::kUnimplemented.
+void UseEmulator(const std::string& app_name, const std::string& host,
+                 int port);
+
+// Whether UseEmulator() was called for the app |app_name|.
+bool IsEmulated(const std::string& app_name);
+
+// Returns the origin the resumable uploads of the app |app_name| are sent to.
+std::string GetUploadEndpoint(const std::string& app_name);
+
+// Returns the directory resumable upload sessions are kept in, or an empty
+// string if it is not available.
+std::string GetUploadSessionDirectory();
+
+// Returns the directory downloads are cached in, or an empty string if it is
+// not available.
+std::string GetDownloadCacheDirectory();
+
+// Returns the directory the StorageTransferJournal is kept in, or an empty
+// string if it is not available.
+std::string GetTransferJournalDirectory();
+
+// Returns the directory streamed downloads are spooled in, or an empty string
+// if it is not available. Spool files left by a previous run are removed.
+std::string GetStreamSpoolDirectory();
+
+// Same as GetMetadataValue(), but written straight into a payload.
+void WriteMetadata(PayloadWriter& writer,
+                   const firebase::storage::Metadata* metadata);
+
 flutter::EncodableValue GetMetadataValue(
     const firebase::storage::Metadata* metadata);
 
+// Parses the object resource |json| that the Storage REST API returns, e.g.
+// when a resumable upload finishes, into a map like GetMetadataValue().
+// Returns false if |json| is not a JSON object.
+bool ParseObjectResource(const std::string& json,
+                         flutter::EncodableMap* metadata);
+
 flutter::EncodableValue GetTaskEventValue(const StorageTaskData& data);
 flutter::EncodableValue GetTaskEventValue(const StorageTaskData& data,
                                           const int64_t bytes_transferred,
                                           const int64_t total_bytes);
 
+// Same as GetTaskEventValue(), but written straight into the message when
+// sent over a channel using GetPayloadMethodCodec(). |data| must outlive the
+// call sending the value.
+flutter::EncodableValue GetTaskEventPayload(const StorageTaskData& data,
+                                            const int64_t bytes_transferred,
+                                            const int64_t total_bytes);
+
+struct TaskProgress {
+  StorageTaskData data;
+  int64_t bytes_transferred;
+  int64_t total_bytes;
+};
+
+// The Task#onProgressBatch event: the task events of |progress| in one list.
+// |progress| must outlive the call sending the value.
+flutter::EncodableValue GetTaskProgressBatchPayload(
+    const std::vector<TaskProgress>& progress);
+
 flutter::EncodableValue GetTaskControlEventValue(
-    const bool status, const std::string& path,
-    const firebase::storage::Controller* controller);
+    const bool status,
+    const std::string& path,
+    const int64_t bytes_transferred,
+    const int64_t total_bytes);
 
 flutter::EncodableValue GetPutTaskSuccessEventValue(
     const StorageTaskData& data, const firebase::storage::Metadata* result);
 
+// Same as above, for an upload the SDK did not make. |metadata| is as
+// returned by ParseObjectResource().
+flutter::EncodableValue GetPutTaskSuccessEventValue(
+    const StorageTaskData& data, const int64_t total_bytes,
+    flutter::EncodableMap metadata);
+
 flutter::EncodableValue GetTaskErrorEventValue(const StorageTaskData& data,
                                                const int error_code,
                                                const char* error_message);
@@ -53,6 +142,11 @@ flutter::EncodableValue GetTaskErrorEventValue(const StorageTaskData& data,
 flutter::EncodableValue ParseListResult(
     const firebase::storage::ListResult& list_result);
 
+// Same as ParseListResult(), for results without a page token. The lists are
+// moved into the value.
+flutter::EncodableValue GetListAllValue(flutter::EncodableList&& items,
+                                        flutter::EncodableList&& prefixes);
+
 }  // namespace utils
 
 #endif
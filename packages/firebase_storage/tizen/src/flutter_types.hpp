@@ -6,12 +6,15 @@
 #define FLUTTER_PLUGIN_FLUTTER_ARGUMENTS_H_
 
 #include <flutter/encodable_value.h>
+#include <flutter/method_call.h>
 #include <flutter/method_channel.h>
 #include <flutter/method_result.h>
 
+#include <memory>
 #include <optional>
 #include <cassert>
 
+typedef flutter::MethodCall<flutter::EncodableValue> FlMethodCall;
 typedef flutter::MethodChannel<flutter::EncodableValue> FlMethodChannel;
 typedef flutter::MethodResult<flutter::EncodableValue> FlMethodResult;
 
@@ -20,24 +23,43 @@ public:
   MethodCallArguments(const flutter::EncodableMap *arguments)
       : arguments_(arguments) {}
 
+  // Takes ownership of |method_call|, whose arguments must be a map, so that
+  // values borrowed from them stay valid for the lifetime of this instance.
+  explicit MethodCallArguments(std::unique_ptr<FlMethodCall> &&method_call)
+      : method_call_(std::move(method_call)),
+        arguments_(
+            std::get_if<flutter::EncodableMap>(method_call_->arguments())) {}
+
   template <typename T> std::optional<T> GetArg(const char *key) {
+    if (auto *value = GetArgPointer<T>(key)) {
+      return *value;
+    }
+    return std::nullopt;
+  }
+
+  // Same as GetArg(), but returns a pointer into the arguments instead of a
+  // copy of the value.
+  template <typename T> const T *GetArgPointer(const char *key) {
     assert(arguments_);
 
     auto iter = arguments_->find(flutter::EncodableValue(key));
     if (iter != arguments_->end() && !iter->second.IsNull()) {
-      if (auto *value = std::get_if<T>(&iter->second)) {
-        return *value;
-      }
+      return std::get_if<T>(&iter->second);
     }
-    return std::nullopt;
+    return nullptr;
   }
 
   template <typename T> T GetRequiredArg(const char *key) {
+    return GetRequiredArgRef<T>(key);
+  }
+
+  // Same as GetRequiredArg(), but returns a reference into the arguments
+  // instead of a copy of the value.
+  template <typename T> const T &GetRequiredArgRef(const char *key) {
     assert(arguments_);
-    
-    auto value = GetArg<T>(key);
-    if (value.has_value()) {
-      return value.value();
+
+    if (auto *value = GetArgPointer<T>(key)) {
+      return *value;
     }
     std::string message =
         "No " + std::string(key) + " provided or has invalid type or value.";
@@ -58,6 +80,7 @@ public:
   }
 
 private:
+  std::unique_ptr<FlMethodCall> method_call_;
   const flutter::EncodableMap *arguments_;
 };
 
@@ -0,0 +1,195 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "benchmark_utils.h"
+
+#include <flutter/standard_message_codec.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <variant>
+#include <vector>
+
+using flutter::EncodableList;
+using flutter::EncodableMap;
+using flutter::EncodableValue;
+
+namespace {
+
+std::atomic<uint64_t> allocation_count{0};
+
+}  // namespace
+
+// Counts every allocation of the process, including the ones made by the
+// plugin libraries, which resolve operator new to this definition.
+void* operator new(size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (size == 0) {
+    size = 1;
+  }
+  if (void* ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+
+namespace benchmark_utils {
+
+uint64_t GetAllocationCount() {
+  return allocation_count.load(std::memory_order_relaxed);
+}
+
+AllocationCounter::AllocationCounter(benchmark::State& state)
+    : state_(state), start_(GetAllocationCount()) {}
+
+AllocationCounter::~AllocationCounter() {
+  state_.counters["allocs_per_op"] =
+      benchmark::Counter(static_cast<double>(GetAllocationCount() - start_),
+                         benchmark::Counter::kAvgIterations);
+}
+
+void SetThroughput(benchmark::State& state, size_t bytes, size_t items) {
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * items));
+}
+
+size_t GetEncodedSize(const EncodableValue& value) {
+  return flutter::StandardMessageCodec::GetInstance()
+      .EncodeMessage(value)
+      ->size();
+}
+
+size_t CountNodes(const EncodableValue& value) {
+  size_t count = 1;
+  if (const auto* list = std::get_if<EncodableList>(&value)) {
+    for (const auto& item : *list) {
+      count += CountNodes(item);
+    }
+  } else if (const auto* map = std::get_if<EncodableMap>(&value)) {
+    for (const auto& [key, item] : *map) {
+      count += CountNodes(key) + CountNodes(item);
+    }
+  }
+  return count;
+}
+
+EncodableValue MakeDeepValue(int depth) {
+  EncodableValue value = EncodableValue(EncodableMap{
+      {EncodableValue("leaf"), EncodableValue(true)},
+  });
+  for (int i = 0; i < depth; ++i) {
+    value = EncodableValue(EncodableMap{
+        {EncodableValue("child"), std::move(value)},
+        {EncodableValue("depth"), EncodableValue(i)},
+        {EncodableValue("name"), EncodableValue("node-" + std::to_string(i))},
+        {EncodableValue("weight"), EncodableValue(i * 0.5)},
+    });
+  }
+  return value;
+}
+
+EncodableValue MakeWideValue(int width) {
+  EncodableMap map;
+  for (int i = 0; i < width; ++i) {
+    EncodableValue key("key-" + std::to_string(i));
+    switch (i % 4) {
+      case 0:
+        map.emplace(std::move(key), EncodableValue(i));
+        break;
+      case 1:
+        map.emplace(std::move(key), EncodableValue(int64_t{1} << 40 | i));
+        break;
+      case 2:
+        map.emplace(std::move(key), EncodableValue(i / 3.0));
+        break;
+      default:
+        map.emplace(std::move(key),
+                    EncodableValue("value-" + std::to_string(i)));
+        break;
+    }
+  }
+  return EncodableValue(std::move(map));
+}
+
+EncodableValue MakeRecordListValue(int count) {
+  EncodableList list;
+  list.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    list.emplace_back(EncodableMap{
+        {EncodableValue("id"), EncodableValue("user-" + std::to_string(i))},
+        {EncodableValue("age"), EncodableValue(20 + i % 50)},
+        {EncodableValue("active"), EncodableValue(i % 2 == 0)},
+        {EncodableValue("score"), EncodableValue(i * 1.25)},
+        {EncodableValue("tags"),
+         EncodableValue(
+             EncodableList{EncodableValue("a"), EncodableValue("b")})},
+    });
+  }
+  return EncodableValue(std::move(list));
+}
+
+EncodableValue MakeTypedArrayValue(int length) {
+  std::vector<uint8_t> bytes(length);
+  std::vector<int32_t> ints(length);
+  std::vector<int64_t> longs(length);
+  std::vector<double> doubles(length);
+  for (int i = 0; i < length; ++i) {
+    bytes[i] = static_cast<uint8_t>(i);
+    ints[i] = i;
+    longs[i] = int64_t{i} << 20;
+    doubles[i] = i * 0.25;
+  }
+  return EncodableValue(EncodableMap{
+      {EncodableValue("bytes"), EncodableValue(std::move(bytes))},
+      {EncodableValue("ints"), EncodableValue(std::move(ints))},
+      {EncodableValue("longs"), EncodableValue(std::move(longs))},
+      {EncodableValue("doubles"), EncodableValue(std::move(doubles))},
+  });
+}
+
+EncodableValue MakeLongStringValue(int length) {
+  return EncodableValue(MakeString(length));
+}
+
+std::string MakeString(size_t length) {
+  std::string string(length, ' ');
+  for (size_t i = 0; i < length; ++i) {
+    string[i] = static_cast<char>('a' + i % 26);
+  }
+  return string;
+}
+
+bool RegisterForEachShape(const char* name, ValueBenchmark benchmark) {
+  static const auto* shapes =
+      new std::vector<std::pair<std::string, EncodableValue>>{
+          {"deep", MakeDeepValue(64)},
+          {"wide", MakeWideValue(1000)},
+          {"records", MakeRecordListValue(1000)},
+          {"typed_arrays", MakeTypedArrayValue(16 * 1024)},
+          {"long_string", MakeLongStringValue(1024 * 1024)},
+      };
+  for (const auto& [shape, value] : *shapes) {
+    const EncodableValue* shape_value = &value;
+    benchmark::RegisterBenchmark(
+        (std::string(name) + "/" + shape).c_str(),
+        [benchmark, shape_value](benchmark::State& state) {
+          benchmark(state, *shape_value);
+        });
+  }
+  return true;
+}
+
+}  // namespace benchmark_utils
@@ -0,0 +1,73 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BENCHMARK_UTILS_H_
+#define BENCHMARK_UTILS_H_
+
+#include <benchmark/benchmark.h>
+#include <flutter/encodable_value.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace benchmark_utils {
+
+// Returns the number of heap allocations made by the process so far.
+uint64_t GetAllocationCount();
+
+// Reports the heap allocations made during its lifetime as the
+// "allocs_per_op" counter, averaged over the iterations of |state|.
+// Construct it right before the benchmark loop.
+class AllocationCounter {
+ public:
+  explicit AllocationCounter(benchmark::State& state);
+  ~AllocationCounter();
+
+ private:
+  benchmark::State& state_;
+  uint64_t start_;
+};
+
+// Reports |bytes| (typically the encoded size of the payload) and |items|
+// processed per iteration, so that throughput is printed for |state|.
+void SetThroughput(benchmark::State& state, size_t bytes, size_t items);
+
+// Returns the size of |value| encoded with the standard message codec, i.e.
+// the size of the value on the platform channel.
+size_t GetEncodedSize(const flutter::EncodableValue& value);
+
+// Returns the number of values in |value|, counting containers and their
+// keys.
+size_t CountNodes(const flutter::EncodableValue& value);
+
+// Data shapes
+
+// A map nested |depth| levels deep, each level having a few scalar fields.
+flutter::EncodableValue MakeDeepValue(int depth);
+
+// A flat map of |width| string keys to alternating scalar values.
+flutter::EncodableValue MakeWideValue(int width);
+
+// A list of |count| small records, like the children of a typical node.
+flutter::EncodableValue MakeRecordListValue(int count);
+
+// A map holding |length|-element typed arrays of every supported type.
+flutter::EncodableValue MakeTypedArrayValue(int length);
+
+// A string value of |length| bytes.
+flutter::EncodableValue MakeLongStringValue(int length);
+
+std::string MakeString(size_t length);
+
+using ValueBenchmark = void (*)(benchmark::State& state,
+                                const flutter::EncodableValue& value);
+
+// Registers |benchmark| as "|name|/<shape>" for each of the shapes above.
+// Meant to initialize a static variable, like the BENCHMARK macro.
+bool RegisterForEachShape(const char* name, ValueBenchmark benchmark);
+
+}  // namespace benchmark_utils
+
+#endif  // BENCHMARK_UTILS_H_
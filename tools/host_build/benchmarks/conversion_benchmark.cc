@@ -0,0 +1,55 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Benchmarks of the EncodableValue <-> firebase::Variant conversions used by
+// the database and functions plugins.
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_utils.h"
+#include "common/conversion.h"
+
+using benchmark_utils::AllocationCounter;
+using firebase::Variant;
+using flutter::EncodableValue;
+
+namespace {
+
+void BM_ToFirebaseVariant(benchmark::State& state,
+                          const EncodableValue& value) {
+  {
+    AllocationCounter allocations(state);
+    for (auto _ : state) {
+      Variant variant = Conversion::ToFirebaseVariant(value);
+      benchmark::DoNotOptimize(variant);
+    }
+  }
+  benchmark_utils::SetThroughput(state, benchmark_utils::GetEncodedSize(value),
+                                 benchmark_utils::CountNodes(value));
+}
+
+void BM_ToEncodableValue(benchmark::State& state,
+                         const EncodableValue& value) {
+  const Variant variant = Conversion::ToFirebaseVariant(value);
+  // Typed arrays come back as lists, so measure the converted value.
+  const EncodableValue round_trip = Conversion::ToEncodableValue(variant);
+  {
+    AllocationCounter allocations(state);
+    for (auto _ : state) {
+      EncodableValue result = Conversion::ToEncodableValue(variant);
+      benchmark::DoNotOptimize(result);
+    }
+  }
+  benchmark_utils::SetThroughput(state,
+                                 benchmark_utils::GetEncodedSize(round_trip),
+                                 benchmark_utils::CountNodes(round_trip));
+}
+
+const bool registered =
+    benchmark_utils::RegisterForEachShape("BM_ToFirebaseVariant",
+                                          BM_ToFirebaseVariant) &&
+    benchmark_utils::RegisterForEachShape("BM_ToEncodableValue",
+                                          BM_ToEncodableValue);
+
+}  // namespace
@@ -0,0 +1,42 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Benchmarks of the payloads the database plugin sends for query results and
+// listener events.
+
+#include <benchmark/benchmark.h>
+#include <firebase/database/data_snapshot.h>
+
+#include "benchmark_utils.h"
+#include "common/conversion.h"
+#include "firebase_database_utils.h"
+
+using benchmark_utils::AllocationCounter;
+using firebase::database::DataSnapshot;
+using flutter::EncodableMap;
+using flutter::EncodableValue;
+
+namespace {
+
+void BM_CreateDataSnapshotPayload(benchmark::State& state,
+                                  const EncodableValue& value) {
+  const DataSnapshot snapshot("node", Conversion::ToFirebaseVariant(value),
+                              firebase::Variant(1.0));
+  const EncodableValue payload(CreateDataSnapshotPayload(&snapshot));
+  {
+    AllocationCounter allocations(state);
+    for (auto _ : state) {
+      EncodableMap result = CreateDataSnapshotPayload(&snapshot);
+      benchmark::DoNotOptimize(result);
+    }
+  }
+  benchmark_utils::SetThroughput(state,
+                                 benchmark_utils::GetEncodedSize(payload),
+                                 benchmark_utils::CountNodes(payload));
+}
+
+const bool registered = benchmark_utils::RegisterForEachShape(
+    "BM_CreateDataSnapshotPayload", BM_CreateDataSnapshotPayload);
+
+}  // namespace
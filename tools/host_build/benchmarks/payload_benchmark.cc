@@ -0,0 +1,136 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// End-to-end encode cost of the hot payloads through StandardMethodCodec,
+// built as EncodableValue trees ("Tree") versus written straight into the
+// message by the payload codec ("Direct").
+
+#include <benchmark/benchmark.h>
+#include <firebase/database/data_snapshot.h>
+#include <flutter/method_call.h>
+#include <flutter/method_result_functions.h>
+#include <flutter/standard_method_codec.h>
+
+#include <memory>
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "common/conversion.h"
+#include "common/payload.h"
+#include "firebase_database_utils.h"
+#include "firebase_storage_utils.h"
+
+using benchmark_utils::AllocationCounter;
+using firebase::database::DataSnapshot;
+using flutter::EncodableValue;
+using flutter::MethodCall;
+using flutter::MethodResultFunctions;
+using flutter::StandardMethodCodec;
+
+namespace {
+
+const utils::StorageTaskData kTaskData{1, "[DEFAULT]", "videos/clip.mp4",
+                                       "benchmark-bucket"};
+
+// Both encodings must decode to the same value.
+bool HasSameResult(const std::vector<uint8_t>& tree,
+                   const std::vector<uint8_t>& direct) {
+  const auto& codec = StandardMethodCodec::GetInstance();
+  const auto tree_call = codec.DecodeMethodCall(tree);
+  const auto direct_call = codec.DecodeMethodCall(direct);
+  return tree_call && direct_call &&
+         tree_call->method_name() == direct_call->method_name() &&
+         *tree_call->arguments() == *direct_call->arguments();
+}
+
+std::vector<uint8_t> EncodeProgress(bool direct) {
+  const auto& codec =
+      direct ? GetPayloadMethodCodec() : StandardMethodCodec::GetInstance();
+  const int64_t bytes_transferred = 3 << 20;
+  const int64_t total_bytes = 64 << 20;
+  MethodCall<EncodableValue> call(
+      "Task#onProgress",
+      std::make_unique<EncodableValue>(
+          direct ? utils::GetTaskEventPayload(kTaskData, bytes_transferred,
+                                              total_bytes)
+                 : utils::GetTaskEventValue(kTaskData, bytes_transferred,
+                                            total_bytes)));
+  return std::move(*codec.EncodeMethodCall(call));
+}
+
+void BM_EncodeTaskProgress(benchmark::State& state, bool direct) {
+  if (!HasSameResult(EncodeProgress(false), EncodeProgress(true))) {
+    state.SkipWithError("The direct payload differs from the tree payload.");
+    return;
+  }
+  size_t size = 0;
+  {
+    AllocationCounter allocations(state);
+    for (auto _ : state) {
+      std::vector<uint8_t> message = EncodeProgress(direct);
+      size = message.size();
+      benchmark::DoNotOptimize(message);
+    }
+  }
+  benchmark_utils::SetThroughput(state, size, 1);
+}
+BENCHMARK_CAPTURE(BM_EncodeTaskProgress, Tree, false);
+BENCHMARK_CAPTURE(BM_EncodeTaskProgress, Direct, true);
+
+std::vector<uint8_t> EncodeSnapshot(const DataSnapshot& snapshot,
+                                    bool direct) {
+  if (direct) {
+    const EncodableValue payload = MakeDataSnapshotPayload(&snapshot);
+    return std::move(*GetPayloadMethodCodec().EncodeSuccessEnvelope(&payload));
+  }
+  const EncodableValue payload(CreateDataSnapshotPayload(&snapshot));
+  return std::move(
+      *StandardMethodCodec::GetInstance().EncodeSuccessEnvelope(&payload));
+}
+
+std::unique_ptr<EncodableValue> DecodeSuccessEnvelope(
+    const std::vector<uint8_t>& envelope) {
+  std::unique_ptr<EncodableValue> value;
+  MethodResultFunctions<EncodableValue> result(
+      [&value](const EncodableValue* result) {
+        value = std::make_unique<EncodableValue>(result ? *result
+                                                        : EncodableValue());
+      },
+      nullptr, nullptr);
+  StandardMethodCodec::GetInstance().DecodeAndProcessResponseEnvelope(
+      envelope.data(), envelope.size(), &result);
+  return value;
+}
+
+template <bool direct>
+void BM_EncodeDataSnapshot(benchmark::State& state,
+                           const EncodableValue& value) {
+  const DataSnapshot snapshot("node", Conversion::ToFirebaseVariant(value),
+                              firebase::Variant(1.0));
+  const auto tree = DecodeSuccessEnvelope(EncodeSnapshot(snapshot, false));
+  const auto direct_value =
+      DecodeSuccessEnvelope(EncodeSnapshot(snapshot, true));
+  if (!tree || !direct_value || !(*tree == *direct_value)) {
+    state.SkipWithError("The direct payload differs from the tree payload.");
+    return;
+  }
+  size_t size = 0;
+  {
+    AllocationCounter allocations(state);
+    for (auto _ : state) {
+      std::vector<uint8_t> message = EncodeSnapshot(snapshot, direct);
+      size = message.size();
+      benchmark::DoNotOptimize(message);
+    }
+  }
+  benchmark_utils::SetThroughput(state, size, 1);
+}
+
+const bool registered =
+    benchmark_utils::RegisterForEachShape("BM_EncodeDataSnapshot/Tree",
+                                          BM_EncodeDataSnapshot<false>) &&
+    benchmark_utils::RegisterForEachShape("BM_EncodeDataSnapshot/Direct",
+                                          BM_EncodeDataSnapshot<true>);
+
+}  // namespace
@@ -0,0 +1,257 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Benchmarks of the storage plugin's event and result builders.
+
+#include <benchmark/benchmark.h>
+#include <fake_firebase/storage_control.h>
+#include <firebase/app.h>
+#include <firebase/app/src/base64.h>
+#include <firebase/storage.h>
+#include <fcntl.h>
+#include <flutter/method_result_functions.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "firebase_storage_base64.h"
+#include "firebase_storage_mapped_file.h"
+#include "firebase_storage_reference_work.h"
+#include "firebase_storage_utils.h"
+
+using benchmark_utils::AllocationCounter;
+using firebase::storage::ListResult;
+using firebase::storage::Metadata;
+using firebase::storage::Storage;
+using flutter::EncodableValue;
+
+namespace {
+
+constexpr char kBucket[] = "benchmark-bucket";
+
+Storage* GetStorage() {
+  static Storage* storage = [] {
+    firebase::App* app = firebase::App::Create(firebase::AppOptions());
+    return Storage::GetInstance(app, (std::string("gs://") + kBucket).c_str());
+  }();
+  return storage;
+}
+
+// Returns the metadata of a stored object with |custom_entries| custom
+// metadata entries.
+Metadata MakeMetadata(int custom_entries) {
+  const std::string path = "files/object.bin";
+  fake_firebase::PutStorageObject(kBucket, path,
+                                  benchmark_utils::MakeString(4096),
+                                  "application/octet-stream");
+  Metadata metadata = *GetStorage()->GetReference(path).GetMetadata().result();
+  metadata.set_cache_control("public, max-age=3600");
+  metadata.set_content_disposition("attachment; filename=\"object.bin\"");
+  for (int i = 0; i < custom_entries; ++i) {
+    metadata.custom_metadata()->emplace("key-" + std::to_string(i),
+                                        benchmark_utils::MakeString(32));
+  }
+  return metadata;
+}
+
+void BM_GetMetadataValue(benchmark::State& state) {
+  const Metadata metadata = MakeMetadata(static_cast<int>(state.range(0)));
+  const EncodableValue value = utils::GetMetadataValue(&metadata);
+  {
+    AllocationCounter allocations(state);
+    for (auto _ : state) {
+      EncodableValue result = utils::GetMetadataValue(&metadata);
+      benchmark::DoNotOptimize(result);
+    }
+  }
+  benchmark_utils::SetThroughput(state, benchmark_utils::GetEncodedSize(value),
+                                 benchmark_utils::CountNodes(value));
+}
+BENCHMARK(BM_GetMetadataValue)->Arg(0)->Arg(16)->Arg(256);
+
+void BM_GetPutTaskSuccessEventValue(benchmark::State& state) {
+  const Metadata metadata = MakeMetadata(static_cast<int>(state.range(0)));
+  const utils::StorageTaskData data{1, "[DEFAULT]", "files/object.bin",
+                                    kBucket};
+  const EncodableValue value =
+      utils::GetPutTaskSuccessEventValue(data, &metadata);
+  {
+    AllocationCounter allocations(state);
+    for (auto _ : state) {
+      EncodableValue result =
+          utils::GetPutTaskSuccessEventValue(data, &metadata);
+      benchmark::DoNotOptimize(result);
+    }
+  }
+  benchmark_utils::SetThroughput(state, benchmark_utils::GetEncodedSize(value),
+                                 benchmark_utils::CountNodes(value));
+}
+BENCHMARK(BM_GetPutTaskSuccessEventValue)->Arg(0)->Arg(16)->Arg(256);
+
+void BM_ParseListResult(benchmark::State& state) {
+  const int count = static_cast<int>(state.range(0));
+  fake_firebase::ResetStorage();
+  for (int i = 0; i < count; ++i) {
+    const std::string index = std::to_string(i);
+    fake_firebase::PutStorageObject(kBucket, "list/item-" + index, "");
+    if (i % 10 == 0) {
+      fake_firebase::PutStorageObject(kBucket, "list/dir-" + index + "/x", "");
+    }
+  }
+  const ListResult list_result =
+      *GetStorage()->GetReference("list").List(count * 2).result();
+  const EncodableValue value = utils::ParseListResult(list_result);
+  {
+    AllocationCounter allocations(state);
+    for (auto _ : state) {
+      EncodableValue result = utils::ParseListResult(list_result);
+      benchmark::DoNotOptimize(result);
+    }
+  }
+  benchmark_utils::SetThroughput(state, benchmark_utils::GetEncodedSize(value),
+                                 benchmark_utils::CountNodes(value));
+}
+BENCHMARK(BM_ParseListResult)->Arg(10)->Arg(100)->Arg(1000);
+
+// Returns |size| bytes encoded in base64, as Task#startPutString receives
+// them.
+std::string MakeBase64(size_t size) {
+  std::string encoded;
+  firebase::internal::Base64Encode(benchmark_utils::MakeString(size), &encoded);
+  return encoded;
+}
+
+// The SDK's decoder, which Task#startPutString used before.
+void BM_Base64DecodeBaseline(benchmark::State& state) {
+  const std::string input = MakeBase64(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::string output;
+    benchmark::DoNotOptimize(firebase::internal::Base64Decode(input, &output));
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(input.size()));
+}
+BENCHMARK(BM_Base64DecodeBaseline)->Arg(1 << 20)->Arg(4 << 20)->Arg(16 << 20);
+
+void BM_Base64Decode(benchmark::State& state) {
+  const std::string input = MakeBase64(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::vector<uint8_t> output(base64::GetDecodedSize(input));
+    benchmark::DoNotOptimize(
+        base64::Decode(input, base64::Alphabet::kStandard, output.data()));
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(input.size()));
+}
+BENCHMARK(BM_Base64Decode)->Arg(1 << 20)->Arg(4 << 20)->Arg(16 << 20);
+
+// The arguments of a Reference#getMetadata call.
+flutter::EncodableMap MakeReferenceArguments() {
+  GetStorage();
+  return flutter::EncodableMap{
+      {EncodableValue("appName"), EncodableValue("__FIRAPP_DEFAULT")},
+      {EncodableValue("bucket"), EncodableValue(kBucket)},
+      {EncodableValue("path"), EncodableValue("files/object.bin")}};
+}
+
+std::unique_ptr<FlMethodResult> MakeMethodResult() {
+  return std::make_unique<flutter::MethodResultFunctions<EncodableValue>>(
+      nullptr, nullptr, nullptr);
+}
+
+void BM_ReferenceWork(benchmark::State& state) {
+  const flutter::EncodableMap arguments = MakeReferenceArguments();
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    StorageReferenceWork::Create(
+        "Reference#getMetadata",
+        std::make_unique<MethodCallArguments>(&arguments), MakeMethodResult())
+        ->Success();
+  }
+}
+BENCHMARK(BM_ReferenceWork);
+
+constexpr size_t kUploadChunkSize = 2 * 1024 * 1024;
+
+// A file of |size| bytes to upload, removed when the benchmark ends.
+class UploadSource {
+ public:
+  explicit UploadSource(size_t size) : path_("/tmp/storage_benchmark.bin") {
+    std::ofstream file(path_, std::ios::binary);
+    file << benchmark_utils::MakeString(size);
+  }
+  ~UploadSource() { std::remove(path_.c_str()); }
+
+  const std::string& path() const { return path_; }
+
+ private:
+  std::string path_;
+};
+
+// Reads every byte of |chunk|, as sending it does. Touching one byte per
+// page would only measure the page faults.
+uint64_t SumChunk(const uint8_t* chunk, size_t size) {
+  uint64_t sum = 0;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, chunk + i, sizeof(word));
+    sum += word;
+  }
+  for (; i < size; i++) {
+    sum += chunk[i];
+  }
+  return sum;
+}
+
+// Reads the chunks of the file into a buffer, as ResumableUpload used
+// before.
+void BM_UploadChunksBaseline(benchmark::State& state) {
+  const size_t size = static_cast<size_t>(state.range(0));
+  UploadSource source(size);
+  std::vector<uint8_t> chunk(kUploadChunkSize);
+  for (auto _ : state) {
+    int fd = open(source.path().c_str(), O_RDONLY | O_CLOEXEC);
+    ssize_t read_size;
+    while ((read_size = read(fd, chunk.data(), chunk.size())) > 0) {
+      benchmark::DoNotOptimize(
+          SumChunk(chunk.data(), static_cast<size_t>(read_size)));
+    }
+    close(fd);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(size));
+}
+BENCHMARK(BM_UploadChunksBaseline)->Arg(8 << 20)->Arg(32 << 20);
+
+// Maps the file and reads the chunks from the mapping, as the transport
+// does when it sends them.
+void BM_UploadChunks(benchmark::State& state) {
+  const size_t size = static_cast<size_t>(state.range(0));
+  UploadSource source(size);
+  for (auto _ : state) {
+    auto file = MappedFile::Open(source.path());
+    for (size_t offset = 0; offset < size; offset += kUploadChunkSize) {
+      file->Prefetch(offset + kUploadChunkSize, kUploadChunkSize);
+      size_t end = std::min(size, offset + kUploadChunkSize);
+      benchmark::DoNotOptimize(
+          SumChunk(file->data() + offset, end - offset));
+    }
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(size));
+}
+BENCHMARK(BM_UploadChunks)->Arg(8 << 20)->Arg(32 << 20);
+
+}  // namespace
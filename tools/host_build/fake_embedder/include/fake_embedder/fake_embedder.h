@@ -0,0 +1,55 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// A host-only stand-in for the embedder side of the plugin C API. It routes
+// platform messages between plugins and the caller in-process, so plugins can
+// be driven without an engine.
+
+#ifndef FAKE_EMBEDDER_H_
+#define FAKE_EMBEDDER_H_
+
+#include <flutter_plugin_registrar.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace fake_embedder {
+
+using BinaryReply = std::function<void(const uint8_t* data, size_t size)>;
+
+// Handles a message sent by a plugin to Dart. Calling |reply| is optional.
+using DartHandler = std::function<void(const std::string& channel,
+                                       const uint8_t* message, size_t size,
+                                       BinaryReply reply)>;
+
+struct MessageStats {
+  uint64_t count;
+  uint64_t bytes;
+};
+
+// Returns the registrar to pass to a plugin's RegisterWithRegistrar function.
+FlutterDesktopPluginRegistrarRef GetRegistrar();
+
+// Runs the destruction handler set by the plugins, if any.
+void DestroyRegistrar();
+
+// Delivers |message| to the handler a plugin registered for |channel|, as if
+// it was sent from Dart. |reply| is called when the plugin responds, which
+// may be on another thread. Returns false if no handler is registered.
+bool SendToPlugin(const std::string& channel, const uint8_t* message,
+                  size_t size, BinaryReply reply);
+
+// Installs the handler of messages sent by plugins to Dart. By default such
+// messages are only counted.
+void SetDartHandler(DartHandler handler);
+
+// Returns the number and total size of messages sent by plugins to Dart.
+MessageStats GetMessageStats();
+void ResetMessageStats();
+
+}  // namespace fake_embedder
+
+#endif  // FAKE_EMBEDDER_H_
@@ -0,0 +1,228 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "fake_embedder/fake_embedder.h"
+
+#include <flutter_messenger.h>
+#include <flutter_plugin_registrar.h>
+#include <flutter_texture_registrar.h>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <utility>
+
+struct FlutterDesktopMessenger {
+  struct Handler {
+    FlutterDesktopMessageCallback callback;
+    void* user_data;
+  };
+
+  std::mutex mutex;
+  std::map<std::string, Handler> handlers;
+  fake_embedder::DartHandler dart_handler;
+  std::atomic<uint64_t> message_count{0};
+  std::atomic<uint64_t> message_bytes{0};
+};
+
+struct FlutterDesktopPluginRegistrar {
+  FlutterDesktopMessenger messenger;
+  FlutterDesktopOnPluginRegistrarDestroyed destruction_handler{nullptr};
+};
+
+struct FlutterDesktopTextureRegistrar {};
+
+// FlutterDesktopMessageResponseHandle
+struct _FlutterPlatformMessageResponseHandle {
+  fake_embedder::BinaryReply reply;
+};
+
+namespace {
+
+FlutterDesktopPluginRegistrar* GetInstance() {
+  static FlutterDesktopPluginRegistrar* registrar =
+      new FlutterDesktopPluginRegistrar();
+  return registrar;
+}
+
+bool SendToDart(FlutterDesktopMessengerRef messenger, const char* channel,
+                const uint8_t* message, size_t message_size,
+                fake_embedder::BinaryReply reply) {
+  messenger->message_count++;
+  messenger->message_bytes += message_size;
+
+  fake_embedder::DartHandler handler;
+  {
+    std::lock_guard<std::mutex> lock(messenger->mutex);
+    handler = messenger->dart_handler;
+  }
+  if (handler) {
+    handler(channel, message, message_size, std::move(reply));
+  }
+  return true;
+}
+
+}  // namespace
+
+namespace fake_embedder {
+
+FlutterDesktopPluginRegistrarRef GetRegistrar() { return GetInstance(); }
+
+void DestroyRegistrar() {
+  FlutterDesktopPluginRegistrar* registrar = GetInstance();
+  if (registrar->destruction_handler) {
+    registrar->destruction_handler(registrar);
+    registrar->destruction_handler = nullptr;
+  }
+}
+
+bool SendToPlugin(const std::string& channel, const uint8_t* message,
+                  size_t size, BinaryReply reply) {
+  FlutterDesktopMessenger* messenger = &GetInstance()->messenger;
+  FlutterDesktopMessenger::Handler handler;
+  {
+    std::lock_guard<std::mutex> lock(messenger->mutex);
+    auto it = messenger->handlers.find(channel);
+    if (it == messenger->handlers.end()) {
+      return false;
+    }
+    handler = it->second;
+  }
+
+  // Owned by the plugin side until FlutterDesktopMessengerSendResponse.
+  auto* response_handle = new FlutterDesktopMessageResponseHandle{
+      reply ? std::move(reply) : [](const uint8_t*, size_t) {}};
+  FlutterDesktopMessage desktop_message = {};
+  desktop_message.struct_size = sizeof(FlutterDesktopMessage);
+  desktop_message.channel = channel.c_str();
+  desktop_message.message = message;
+  desktop_message.message_size = size;
+  desktop_message.response_handle = response_handle;
+  handler.callback(messenger, &desktop_message, handler.user_data);
+  return true;
+}
+
+void SetDartHandler(DartHandler handler) {
+  FlutterDesktopMessenger* messenger = &GetInstance()->messenger;
+  std::lock_guard<std::mutex> lock(messenger->mutex);
+  messenger->dart_handler = std::move(handler);
+}
+
+MessageStats GetMessageStats() {
+  FlutterDesktopMessenger* messenger = &GetInstance()->messenger;
+  return MessageStats{messenger->message_count, messenger->message_bytes};
+}
+
+void ResetMessageStats() {
+  FlutterDesktopMessenger* messenger = &GetInstance()->messenger;
+  messenger->message_count = 0;
+  messenger->message_bytes = 0;
+}
+
+}  // namespace fake_embedder
+
+// Plugin registrar
+
+FlutterDesktopMessengerRef FlutterDesktopPluginRegistrarGetMessenger(
+    FlutterDesktopPluginRegistrarRef registrar) {
+  return &registrar->messenger;
+}
+
+FlutterDesktopTextureRegistrarRef FlutterDesktopRegistrarGetTextureRegistrar(
+    FlutterDesktopPluginRegistrarRef registrar) {
+  static FlutterDesktopTextureRegistrar texture_registrar;
+  return &texture_registrar;
+}
+
+void FlutterDesktopPluginRegistrarSetDestructionHandler(
+    FlutterDesktopPluginRegistrarRef registrar,
+    FlutterDesktopOnPluginRegistrarDestroyed callback) {
+  registrar->destruction_handler = callback;
+}
+
+// Messenger
+
+bool FlutterDesktopMessengerSend(FlutterDesktopMessengerRef messenger,
+                                 const char* channel, const uint8_t* message,
+                                 const size_t message_size) {
+  return SendToDart(messenger, channel, message, message_size, nullptr);
+}
+
+bool FlutterDesktopMessengerSendWithReply(FlutterDesktopMessengerRef messenger,
+                                          const char* channel,
+                                          const uint8_t* message,
+                                          const size_t message_size,
+                                          const FlutterDesktopBinaryReply reply,
+                                          void* user_data) {
+  fake_embedder::BinaryReply binary_reply;
+  if (reply) {
+    binary_reply = [reply, user_data](const uint8_t* data, size_t size) {
+      reply(data, size, user_data);
+    };
+  }
+  return SendToDart(messenger, channel, message, message_size,
+                    std::move(binary_reply));
+}
+
+void FlutterDesktopMessengerSendResponse(
+    FlutterDesktopMessengerRef messenger,
+    const FlutterDesktopMessageResponseHandle* handle, const uint8_t* data,
+    size_t data_length) {
+  handle->reply(data, data_length);
+  delete handle;
+}
+
+void FlutterDesktopMessengerSetCallback(FlutterDesktopMessengerRef messenger,
+                                        const char* channel,
+                                        FlutterDesktopMessageCallback callback,
+                                        void* user_data) {
+  std::lock_guard<std::mutex> lock(messenger->mutex);
+  if (callback) {
+    messenger->handlers[channel] = {callback, user_data};
+  } else {
+    messenger->handlers.erase(channel);
+  }
+}
+
+// The messenger lives as long as the process, so reference counting and
+// locking are no-ops.
+
+FlutterDesktopMessengerRef FlutterDesktopMessengerAddRef(
+    FlutterDesktopMessengerRef messenger) {
+  return messenger;
+}
+
+void FlutterDesktopMessengerRelease(FlutterDesktopMessengerRef messenger) {}
+
+bool FlutterDesktopMessengerIsAvailable(FlutterDesktopMessengerRef messenger) {
+  return true;
+}
+
+FlutterDesktopMessengerRef FlutterDesktopMessengerLock(
+    FlutterDesktopMessengerRef messenger) {
+  return messenger;
+}
+
+void FlutterDesktopMessengerUnlock(FlutterDesktopMessengerRef messenger) {}
+
+// Texture registrar. None of the plugins use textures.
+
+int64_t FlutterDesktopTextureRegistrarRegisterExternalTexture(
+    FlutterDesktopTextureRegistrarRef texture_registrar,
+    const FlutterDesktopTextureInfo* info) {
+  return -1;
+}
+
+void FlutterDesktopTextureRegistrarUnregisterExternalTexture(
+    FlutterDesktopTextureRegistrarRef texture_registrar, int64_t texture_id,
+    void (*callback)(void* user_data), void* user_data) {
+  if (callback) {
+    callback(user_data);
+  }
+}
+
+bool FlutterDesktopTextureRegistrarMarkExternalTextureFrameAvailable(
+    FlutterDesktopTextureRegistrarRef texture_registrar, int64_t texture_id) {
+  return false;
+}
@@ -0,0 +1,34 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Knobs of the fake storage backend that have no counterpart in the SDK.
+
+#ifndef FAKE_FIREBASE_STORAGE_CONTROL_H_
+#define FAKE_FIREBASE_STORAGE_CONTROL_H_
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+namespace fake_firebase {
+
+// Splits transfers into |chunk_size| byte chunks and sleeps |chunk_delay|
+// after each one, so that progress, pause and cancel can be observed.
+// Defaults to 256 KiB chunks without delay.
+void SetStorageTransferPacing(size_t chunk_size,
+                              std::chrono::microseconds chunk_delay);
+
+// Stores or reads an object directly, bypassing the transfer machinery.
+void PutStorageObject(const std::string& bucket, const std::string& path,
+                      const std::string& data,
+                      const std::string& content_type = "");
+bool GetStorageObject(const std::string& bucket, const std::string& path,
+                      std::string* data);
+
+// Removes all objects of all buckets.
+void ResetStorage();
+
+}  // namespace fake_firebase
+
+#endif  // FAKE_FIREBASE_STORAGE_CONTROL_H_
@@ -0,0 +1,77 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_APP_H_
+#define FAKE_FIREBASE_APP_H_
+
+#include <string>
+#include <vector>
+
+#include "firebase/future.h"
+#include "firebase/log.h"
+
+namespace firebase {
+
+enum InitResult {
+  kInitResultSuccess = 0,
+  kInitResultFailedMissingDependency,
+};
+
+extern const char* const kDefaultAppName;
+
+class AppOptions {
+ public:
+  void set_api_key(const char* value) { api_key_ = value; }
+  const char* api_key() const { return api_key_.c_str(); }
+  void set_app_id(const char* value) { app_id_ = value; }
+  const char* app_id() const { return app_id_.c_str(); }
+  void set_messaging_sender_id(const char* value) {
+    messaging_sender_id_ = value;
+  }
+  const char* messaging_sender_id() const {
+    return messaging_sender_id_.c_str();
+  }
+  void set_project_id(const char* value) { project_id_ = value; }
+  const char* project_id() const { return project_id_.c_str(); }
+  void set_database_url(const char* value) { database_url_ = value; }
+  const char* database_url() const { return database_url_.c_str(); }
+  void set_storage_bucket(const char* value) { storage_bucket_ = value; }
+  const char* storage_bucket() const { return storage_bucket_.c_str(); }
+  void set_ga_tracking_id(const char* value) { ga_tracking_id_ = value; }
+  const char* ga_tracking_id() const { return ga_tracking_id_.c_str(); }
+
+ private:
+  std::string api_key_;
+  std::string app_id_;
+  std::string messaging_sender_id_;
+  std::string project_id_;
+  std::string database_url_;
+  std::string storage_bucket_;
+  std::string ga_tracking_id_;
+};
+
+class App {
+ public:
+  ~App();
+
+  static App* Create(const AppOptions& options);
+  static App* Create(const AppOptions& options, const char* name);
+  static App* GetInstance();
+  static App* GetInstance(const char* name);
+  static std::vector<App*> GetApps();
+
+  const char* name() const { return name_.c_str(); }
+  const AppOptions& options() const { return options_; }
+
+ private:
+  App(const AppOptions& options, const char* name)
+      : name_(name), options_(options) {}
+
+  std::string name_;
+  AppOptions options_;
+};
+
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_APP_H_
@@ -0,0 +1,19 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_APP_SRC_BASE64_H_
+#define FAKE_FIREBASE_APP_SRC_BASE64_H_
+
+#include <string>
+
+namespace firebase {
+namespace internal {
+
+bool Base64Encode(const std::string& input, std::string* output);
+bool Base64Decode(const std::string& input, std::string* output);
+
+}  // namespace internal
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_APP_SRC_BASE64_H_
@@ -0,0 +1,61 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_DATABASE_H_
+#define FAKE_FIREBASE_DATABASE_H_
+
+#include <memory>
+
+#include "firebase/app.h"
+#include "firebase/database/common.h"
+#include "firebase/database/data_snapshot.h"
+#include "firebase/database/database_reference.h"
+#include "firebase/database/disconnection.h"
+#include "firebase/database/listener.h"
+#include "firebase/database/mutable_data.h"
+#include "firebase/database/query.h"
+#include "firebase/database/transaction.h"
+#include "firebase/log.h"
+
+namespace firebase {
+namespace database {
+
+// An in-memory database. Writes are applied immediately and listeners are
+// notified synchronously on the writing thread.
+class Database {
+ public:
+  ~Database();
+
+  static Database* GetInstance(App* app, InitResult* init_result_out = nullptr);
+  static Database* GetInstance(App* app, const char* url,
+                               InitResult* init_result_out = nullptr);
+
+  App* app() const { return app_; }
+  const char* url() const { return url_.c_str(); }
+
+  DatabaseReference GetReference() const;
+  DatabaseReference GetReference(const char* path) const;
+  DatabaseReference GetReferenceFromUrl(const char* url) const;
+
+  void GoOffline() {}
+  void GoOnline() {}
+  void PurgeOutstandingWrites() {}
+
+  void set_persistence_enabled(bool enabled) {}
+  void set_log_level(LogLevel log_level) { log_level_ = log_level; }
+  LogLevel log_level() const { return log_level_; }
+
+ private:
+  Database(App* app, const char* url);
+
+  App* app_;
+  std::string url_;
+  LogLevel log_level_{kLogLevelInfo};
+  std::unique_ptr<internal::DatabaseInternal> internal_;
+};
+
+}  // namespace database
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_DATABASE_H_
@@ -0,0 +1,34 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_DATABASE_COMMON_H_
+#define FAKE_FIREBASE_DATABASE_COMMON_H_
+
+namespace firebase {
+namespace database {
+
+enum Error {
+  kErrorNone = 0,
+  kErrorDisconnected,
+  kErrorExpiredToken,
+  kErrorInvalidToken,
+  kErrorMaxRetries,
+  kErrorNetworkError,
+  kErrorOperationFailed,
+  kErrorOverriddenBySet,
+  kErrorPermissionDenied,
+  kErrorUnavailable,
+  kErrorUnknownError,
+  kErrorWriteCanceled,
+  kErrorInvalidVariantType,
+  kErrorConflictingOperationInProgress,
+  kErrorTransactionAbortedByUser,
+};
+
+const char* GetErrorMessage(Error error);
+
+}  // namespace database
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_DATABASE_COMMON_H_
@@ -0,0 +1,45 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_DATABASE_DATA_SNAPSHOT_H_
+#define FAKE_FIREBASE_DATABASE_DATA_SNAPSHOT_H_
+
+#include <string>
+#include <vector>
+
+#include "firebase/variant.h"
+
+namespace firebase {
+namespace database {
+
+class DataSnapshot {
+ public:
+  DataSnapshot() = default;
+  DataSnapshot(const std::string& key, const Variant& value,
+               const Variant& priority = Variant())
+      : key_(key), value_(value), priority_(priority) {}
+
+  bool is_valid() const { return true; }
+  bool exists() const { return !value_.is_null(); }
+  bool has_children() const;
+  size_t children_count() const;
+  std::vector<DataSnapshot> children() const;
+  DataSnapshot Child(const std::string& path) const;
+  bool HasChild(const std::string& path) const;
+
+  const char* key() const { return key_.c_str(); }
+  std::string key_string() const { return key_; }
+  Variant value() const { return value_; }
+  Variant priority() const { return priority_; }
+
+ private:
+  std::string key_;
+  Variant value_;
+  Variant priority_;
+};
+
+}  // namespace database
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_DATABASE_DATA_SNAPSHOT_H_
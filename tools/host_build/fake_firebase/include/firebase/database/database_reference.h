@@ -0,0 +1,63 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_DATABASE_DATABASE_REFERENCE_H_
+#define FAKE_FIREBASE_DATABASE_DATABASE_REFERENCE_H_
+
+#include <functional>
+#include <string>
+
+#include "firebase/database/data_snapshot.h"
+#include "firebase/database/disconnection.h"
+#include "firebase/database/mutable_data.h"
+#include "firebase/database/query.h"
+#include "firebase/database/transaction.h"
+#include "firebase/future.h"
+#include "firebase/variant.h"
+
+namespace firebase {
+namespace database {
+
+class DatabaseReference : public Query {
+ public:
+  DatabaseReference() = default;
+
+  const char* key() const;
+  std::string key_string() const;
+  bool is_root() const { return path_.empty(); }
+
+  DatabaseReference GetParent() const;
+  DatabaseReference GetRoot() const;
+  DatabaseReference Child(const char* path) const;
+  DatabaseReference Child(const std::string& path) const;
+  DatabaseReference PushChild() const;
+
+  Future<void> RemoveValue();
+  Future<void> SetValue(Variant value);
+  Future<void> SetPriority(Variant priority);
+  Future<void> SetValueAndPriority(Variant value, Variant priority);
+  Future<void> UpdateChildren(Variant values);
+
+  // Runs |transaction_function| on a worker thread, like the real SDK does.
+  Future<DataSnapshot> RunTransaction(
+      DoTransactionFunction transaction_function,
+      bool trigger_local_events = true);
+
+  DisconnectionHandler* OnDisconnect();
+
+  std::string url() const;
+
+ private:
+  friend class Database;
+  friend class internal::DatabaseInternal;
+
+  DatabaseReference(internal::DatabaseInternal* database,
+                    const std::string& path)
+      : Query(database, path) {}
+};
+
+}  // namespace database
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_DATABASE_DATABASE_REFERENCE_H_
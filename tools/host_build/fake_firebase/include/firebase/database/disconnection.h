@@ -0,0 +1,28 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_DATABASE_DISCONNECTION_H_
+#define FAKE_FIREBASE_DATABASE_DISCONNECTION_H_
+
+#include "firebase/future.h"
+#include "firebase/variant.h"
+
+namespace firebase {
+namespace database {
+
+// Operations are acknowledged but never run, since the fake never
+// disconnects.
+class DisconnectionHandler {
+ public:
+  Future<void> Cancel();
+  Future<void> RemoveValue();
+  Future<void> SetValue(Variant value);
+  Future<void> SetValueAndPriority(Variant value, Variant priority);
+  Future<void> UpdateChildren(Variant values);
+};
+
+}  // namespace database
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_DATABASE_DISCONNECTION_H_
@@ -0,0 +1,37 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_DATABASE_LISTENER_H_
+#define FAKE_FIREBASE_DATABASE_LISTENER_H_
+
+#include "firebase/database/common.h"
+#include "firebase/database/data_snapshot.h"
+
+namespace firebase {
+namespace database {
+
+class ValueListener {
+ public:
+  virtual ~ValueListener() = default;
+  virtual void OnValueChanged(const DataSnapshot& snapshot) = 0;
+  virtual void OnCancelled(const Error& error, const char* error_message) = 0;
+};
+
+class ChildListener {
+ public:
+  virtual ~ChildListener() = default;
+  virtual void OnChildAdded(const DataSnapshot& snapshot,
+                            const char* previous_sibling_key) = 0;
+  virtual void OnChildChanged(const DataSnapshot& snapshot,
+                              const char* previous_sibling_key) = 0;
+  virtual void OnChildMoved(const DataSnapshot& snapshot,
+                            const char* previous_sibling_key) = 0;
+  virtual void OnChildRemoved(const DataSnapshot& snapshot) = 0;
+  virtual void OnCancelled(const Error& error, const char* error_message) = 0;
+};
+
+}  // namespace database
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_DATABASE_LISTENER_H_
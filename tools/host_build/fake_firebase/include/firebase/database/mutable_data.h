@@ -0,0 +1,43 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_DATABASE_MUTABLE_DATA_H_
+#define FAKE_FIREBASE_DATABASE_MUTABLE_DATA_H_
+
+#include <string>
+#include <vector>
+
+#include "firebase/variant.h"
+
+namespace firebase {
+namespace database {
+
+// Holds the data of a transaction. Unlike the real SDK, the children returned
+// by children() are copies, so writes to them are not reflected on the parent.
+class MutableData {
+ public:
+  MutableData(const std::string& key, const Variant& value,
+              const Variant& priority = Variant())
+      : key_(key), value_(value), priority_(priority) {}
+
+  std::vector<MutableData> children();
+  size_t children_count();
+  const char* key() const { return key_.c_str(); }
+  std::string key_string() const { return key_; }
+  Variant value() const { return value_; }
+  Variant priority() { return priority_; }
+
+  void set_value(const Variant& value) { value_ = value; }
+  void set_priority(const Variant& priority) { priority_ = priority; }
+
+ private:
+  std::string key_;
+  Variant value_;
+  Variant priority_;
+};
+
+}  // namespace database
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_DATABASE_MUTABLE_DATA_H_
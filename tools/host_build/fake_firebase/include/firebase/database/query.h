@@ -0,0 +1,63 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_DATABASE_QUERY_H_
+#define FAKE_FIREBASE_DATABASE_QUERY_H_
+
+#include <string>
+
+#include "firebase/database/data_snapshot.h"
+#include "firebase/database/listener.h"
+#include "firebase/future.h"
+#include "firebase/variant.h"
+
+namespace firebase {
+namespace database {
+
+namespace internal {
+class DatabaseInternal;
+}  // namespace internal
+
+// Ordering, range and limit modifiers are accepted but not applied: a query
+// always observes the whole location.
+class Query {
+ public:
+  Query() = default;
+  virtual ~Query() = default;
+
+  Future<DataSnapshot> GetValue();
+  void SetKeepSynchronized(bool keep_sync) {}
+
+  void AddValueListener(ValueListener* listener);
+  void RemoveValueListener(ValueListener* listener);
+  void RemoveAllValueListeners();
+  void AddChildListener(ChildListener* listener);
+  void RemoveChildListener(ChildListener* listener);
+  void RemoveAllChildListeners();
+
+  Query OrderByChild(const char* path) { return *this; }
+  Query OrderByChild(const std::string& path) { return *this; }
+  Query OrderByKey() { return *this; }
+  Query OrderByPriority() { return *this; }
+  Query OrderByValue() { return *this; }
+  Query StartAt(Variant order_value) { return *this; }
+  Query EndAt(Variant order_value) { return *this; }
+  Query EqualTo(Variant order_value) { return *this; }
+  Query LimitToFirst(size_t limit) { return *this; }
+  Query LimitToLast(size_t limit) { return *this; }
+
+  bool is_valid() const { return database_ != nullptr; }
+
+ protected:
+  Query(internal::DatabaseInternal* database, const std::string& path)
+      : database_(database), path_(path) {}
+
+  internal::DatabaseInternal* database_{nullptr};
+  std::string path_;
+};
+
+}  // namespace database
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_DATABASE_QUERY_H_
@@ -0,0 +1,26 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_DATABASE_TRANSACTION_H_
+#define FAKE_FIREBASE_DATABASE_TRANSACTION_H_
+
+#include <functional>
+
+#include "firebase/database/mutable_data.h"
+
+namespace firebase {
+namespace database {
+
+enum TransactionResult {
+  kTransactionResultSuccess = 0,
+  kTransactionResultAbort,
+};
+
+typedef std::function<TransactionResult(MutableData* data)>
+    DoTransactionFunction;
+
+}  // namespace database
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_DATABASE_TRANSACTION_H_
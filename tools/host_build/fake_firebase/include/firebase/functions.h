@@ -0,0 +1,44 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_FUNCTIONS_H_
+#define FAKE_FIREBASE_FUNCTIONS_H_
+
+#include <string>
+
+#include "firebase/app.h"
+#include "firebase/functions/callable_reference.h"
+#include "firebase/functions/callable_result.h"
+#include "firebase/functions/common.h"
+
+namespace firebase {
+namespace functions {
+
+class Functions {
+ public:
+  static Functions* GetInstance(App* app,
+                                InitResult* init_result_out = nullptr);
+  static Functions* GetInstance(App* app, const char* region,
+                                InitResult* init_result_out = nullptr);
+
+  App* app() const { return app_; }
+  const std::string& region() const { return region_; }
+  const std::string& emulator_origin() const { return emulator_origin_; }
+
+  HttpsCallableReference GetHttpsCallable(const char* name) const;
+
+  void UseFunctionsEmulator(const char* origin) { emulator_origin_ = origin; }
+
+ private:
+  Functions(App* app, const char* region) : app_(app), region_(region) {}
+
+  App* app_;
+  std::string region_;
+  std::string emulator_origin_;
+};
+
+}  // namespace functions
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_FUNCTIONS_H_
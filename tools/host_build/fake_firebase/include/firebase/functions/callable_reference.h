@@ -0,0 +1,43 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_FUNCTIONS_CALLABLE_REFERENCE_H_
+#define FAKE_FIREBASE_FUNCTIONS_CALLABLE_REFERENCE_H_
+
+#include <string>
+
+#include "firebase/functions/callable_result.h"
+#include "firebase/future.h"
+#include "firebase/variant.h"
+
+namespace firebase {
+namespace functions {
+
+class Functions;
+
+// Calling a fake function echoes its parameters back as the result. The
+// function named "error" fails with kErrorInternal instead.
+class HttpsCallableReference {
+ public:
+  HttpsCallableReference() = default;
+
+  Future<HttpsCallableResult> Call();
+  Future<HttpsCallableResult> Call(const Variant& data);
+
+  bool is_valid() const { return functions_ != nullptr; }
+
+ private:
+  friend class Functions;
+
+  HttpsCallableReference(Functions* functions, const std::string& name)
+      : functions_(functions), name_(name) {}
+
+  Functions* functions_{nullptr};
+  std::string name_;
+};
+
+}  // namespace functions
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_FUNCTIONS_CALLABLE_REFERENCE_H_
@@ -0,0 +1,29 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_FUNCTIONS_CALLABLE_RESULT_H_
+#define FAKE_FIREBASE_FUNCTIONS_CALLABLE_RESULT_H_
+
+#include <utility>
+
+#include "firebase/variant.h"
+
+namespace firebase {
+namespace functions {
+
+class HttpsCallableResult {
+ public:
+  HttpsCallableResult() = default;
+  explicit HttpsCallableResult(Variant data) : data_(std::move(data)) {}
+
+  const Variant& data() const { return data_; }
+
+ private:
+  Variant data_;
+};
+
+}  // namespace functions
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_FUNCTIONS_CALLABLE_RESULT_H_
@@ -0,0 +1,34 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_FUNCTIONS_COMMON_H_
+#define FAKE_FIREBASE_FUNCTIONS_COMMON_H_
+
+namespace firebase {
+namespace functions {
+
+enum Error {
+  kErrorNone = 0,
+  kErrorCancelled,
+  kErrorUnknown,
+  kErrorInvalidArgument,
+  kErrorDeadlineExceeded,
+  kErrorNotFound,
+  kErrorAlreadyExists,
+  kErrorPermissionDenied,
+  kErrorResourceExhausted,
+  kErrorFailedPrecondition,
+  kErrorAborted,
+  kErrorOutOfRange,
+  kErrorUnimplemented,
+  kErrorInternal,
+  kErrorUnavailable,
+  kErrorDataLoss,
+  kErrorUnauthenticated,
+};
+
+}  // namespace functions
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_FUNCTIONS_COMMON_H_
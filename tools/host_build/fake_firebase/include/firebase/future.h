@@ -0,0 +1,163 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_FUTURE_H_
+#define FAKE_FIREBASE_FUTURE_H_
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace firebase {
+
+enum FutureStatus {
+  kFutureStatusComplete,
+  kFutureStatusPending,
+  kFutureStatusInvalid,
+};
+
+template <typename T>
+class Future;
+
+namespace internal {
+
+template <typename T>
+using FutureValue = std::conditional_t<std::is_void_v<T>, char, T>;
+
+template <typename T>
+struct FutureState {
+  std::mutex mutex;
+  FutureStatus status{kFutureStatusPending};
+  int error{0};
+  std::string error_message;
+  FutureValue<T> result{};
+  std::vector<std::function<void(const Future<T>&)>> callbacks;
+};
+
+// The producer side of a fake Future. Completing it runs the registered
+// callbacks on the calling thread.
+template <typename T>
+class Promise {
+ public:
+  Promise() : state_(std::make_shared<FutureState<T>>()) {}
+
+  Future<T> future() const { return Future<T>(state_); }
+
+  template <typename U = T,
+            typename = std::enable_if_t<!std::is_void_v<U>>>
+  void Complete(int error, const char* error_message, U result) {
+    {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      state_->result = std::move(result);
+      SetComplete(error, error_message);
+    }
+    RunCallbacks();
+  }
+
+  void Complete(int error = 0, const char* error_message = "") {
+    {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      SetComplete(error, error_message);
+    }
+    RunCallbacks();
+  }
+
+ private:
+  void SetComplete(int error, const char* error_message) {
+    state_->status = kFutureStatusComplete;
+    state_->error = error;
+    state_->error_message = error_message ? error_message : "";
+  }
+
+  void RunCallbacks() {
+    Future<T> future(state_);
+    std::vector<std::function<void(const Future<T>&)>> callbacks;
+    {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      callbacks.swap(state_->callbacks);
+    }
+    for (auto& callback : callbacks) {
+      callback(future);
+    }
+  }
+
+  std::shared_ptr<FutureState<T>> state_;
+};
+
+// Returns a future that is already complete.
+template <typename T>
+Future<T> CompletedFuture(int error, const char* error_message,
+                          FutureValue<T> result = {}) {
+  Promise<T> promise;
+  if constexpr (std::is_void_v<T>) {
+    promise.Complete(error, error_message);
+  } else {
+    promise.Complete(error, error_message, std::move(result));
+  }
+  return promise.future();
+}
+
+}  // namespace internal
+
+template <typename T>
+class Future {
+ public:
+  typedef void (*TypedCompletionCallback)(const Future<T>& result_data,
+                                          void* user_data);
+
+  Future() = default;
+  explicit Future(std::shared_ptr<internal::FutureState<T>> state)
+      : state_(std::move(state)) {}
+
+  FutureStatus status() const {
+    if (!state_) {
+      return kFutureStatusInvalid;
+    }
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->status;
+  }
+
+  int error() const { return state_ ? state_->error : -1; }
+
+  const char* error_message() const {
+    return state_ ? state_->error_message.c_str() : "";
+  }
+
+  template <typename U = T,
+            typename = std::enable_if_t<!std::is_void_v<U>>>
+  const U* result() const {
+    return state_ ? &state_->result : nullptr;
+  }
+
+  void OnCompletion(TypedCompletionCallback callback, void* user_data) const {
+    OnCompletion([callback, user_data](const Future<T>& future) {
+      callback(future, user_data);
+    });
+  }
+
+  void OnCompletion(std::function<void(const Future<T>&)> callback) const {
+    if (!state_) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      if (state_->status == kFutureStatusPending) {
+        state_->callbacks.push_back(std::move(callback));
+        return;
+      }
+    }
+    callback(*this);
+  }
+
+ private:
+  std::shared_ptr<internal::FutureState<T>> state_;
+};
+
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_FUTURE_H_
@@ -0,0 +1,27 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// A host-only stand-in for the Firebase C++ SDK. It mirrors the subset of the
+// SDK API used by the plugins and keeps all state in memory.
+
+#ifndef FAKE_FIREBASE_LOG_H_
+#define FAKE_FIREBASE_LOG_H_
+
+namespace firebase {
+
+enum LogLevel {
+  kLogLevelVerbose = 0,
+  kLogLevelDebug,
+  kLogLevelInfo,
+  kLogLevelWarning,
+  kLogLevelError,
+  kLogLevelAssert,
+};
+
+void SetLogLevel(LogLevel level);
+LogLevel GetLogLevel();
+
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_LOG_H_
@@ -0,0 +1,66 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_STORAGE_H_
+#define FAKE_FIREBASE_STORAGE_H_
+
+#include <string>
+
+#include "firebase/app.h"
+#include "firebase/storage/common.h"
+#include "firebase/storage/controller.h"
+#include "firebase/storage/list_result.h"
+#include "firebase/storage/listener.h"
+#include "firebase/storage/metadata.h"
+#include "firebase/storage/storage_reference.h"
+
+namespace firebase {
+namespace storage {
+
+// An in-memory object store shared by all Storage instances of the process,
+// partitioned by bucket.
+class Storage {
+ public:
+  static Storage* GetInstance(App* app, InitResult* init_result_out = nullptr);
+  static Storage* GetInstance(App* app, const char* url,
+                              InitResult* init_result_out = nullptr);
+
+  App* app() const { return app_; }
+  std::string url() const { return "gs://" + bucket_; }
+  const std::string& bucket() const { return bucket_; }
+
+  StorageReference GetReference() const;
+  StorageReference GetReference(const char* path) const;
+  StorageReference GetReference(const std::string& path) const {
+    return GetReference(path.c_str());
+  }
+  StorageReference GetReferenceFromUrl(const char* url) const;
+
+  double max_download_retry_time() const { return max_download_retry_time_; }
+  void set_max_download_retry_time(double seconds) {
+    max_download_retry_time_ = seconds;
+  }
+  double max_upload_retry_time() const { return max_upload_retry_time_; }
+  void set_max_upload_retry_time(double seconds) {
+    max_upload_retry_time_ = seconds;
+  }
+  double max_operation_retry_time() const { return max_operation_retry_time_; }
+  void set_max_operation_retry_time(double seconds) {
+    max_operation_retry_time_ = seconds;
+  }
+
+ private:
+  Storage(App* app, const std::string& bucket) : app_(app), bucket_(bucket) {}
+
+  App* app_;
+  std::string bucket_;
+  double max_download_retry_time_{600.0};
+  double max_upload_retry_time_{600.0};
+  double max_operation_retry_time_{120.0};
+};
+
+}  // namespace storage
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_STORAGE_H_
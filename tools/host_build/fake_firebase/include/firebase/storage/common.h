@@ -0,0 +1,31 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_STORAGE_COMMON_H_
+#define FAKE_FIREBASE_STORAGE_COMMON_H_
+
+namespace firebase {
+namespace storage {
+
+enum Error {
+  kErrorNone = 0,
+  kErrorUnknown,
+  kErrorObjectNotFound,
+  kErrorBucketNotFound,
+  kErrorProjectNotFound,
+  kErrorQuotaExceeded,
+  kErrorUnauthenticated,
+  kErrorUnauthorized,
+  kErrorRetryLimitExceeded,
+  kErrorNonMatchingChecksum,
+  kErrorDownloadSizeExceeded,
+  kErrorCancelled,
+};
+
+const char* GetErrorMessage(Error error);
+
+}  // namespace storage
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_STORAGE_COMMON_H_
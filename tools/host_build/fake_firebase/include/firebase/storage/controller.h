@@ -0,0 +1,48 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_STORAGE_CONTROLLER_H_
+#define FAKE_FIREBASE_STORAGE_CONTROLLER_H_
+
+#include <cstdint>
+#include <memory>
+
+namespace firebase {
+namespace storage {
+
+namespace internal {
+struct TransferState;
+class TransferAccess;
+}  // namespace internal
+
+class StorageReference;
+
+// Controls a transfer. Copies of a controller share the same transfer.
+class Controller {
+ public:
+  Controller();
+  ~Controller();
+  Controller(const Controller& other) = default;
+  Controller& operator=(const Controller& other) = default;
+
+  bool Pause();
+  bool Resume();
+  bool Cancel();
+
+  bool is_paused() const;
+  int64_t bytes_transferred() const;
+  int64_t total_byte_count() const;
+  StorageReference GetReference() const;
+  bool is_valid() const { return state_ != nullptr; }
+
+ private:
+  friend class internal::TransferAccess;
+
+  std::shared_ptr<internal::TransferState> state_;
+};
+
+}  // namespace storage
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_STORAGE_CONTROLLER_H_
@@ -0,0 +1,35 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_STORAGE_LIST_RESULT_H_
+#define FAKE_FIREBASE_STORAGE_LIST_RESULT_H_
+
+#include <string>
+#include <vector>
+
+#include "firebase/storage/storage_reference.h"
+
+namespace firebase {
+namespace storage {
+
+class ListResult {
+ public:
+  ListResult() = default;
+
+  std::vector<StorageReference> GetItems() const { return items_; }
+  std::vector<StorageReference> GetPrefixes() const { return prefixes_; }
+  std::string GetPageToken() const { return page_token_; }
+
+ private:
+  friend class StorageReference;
+
+  std::vector<StorageReference> items_;
+  std::vector<StorageReference> prefixes_;
+  std::string page_token_;
+};
+
+}  // namespace storage
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_STORAGE_LIST_RESULT_H_
@@ -0,0 +1,23 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_STORAGE_LISTENER_H_
+#define FAKE_FIREBASE_STORAGE_LISTENER_H_
+
+#include "firebase/storage/controller.h"
+
+namespace firebase {
+namespace storage {
+
+class Listener {
+ public:
+  virtual ~Listener() = default;
+  virtual void OnProgress(Controller* controller) = 0;
+  virtual void OnPaused(Controller* controller) = 0;
+};
+
+}  // namespace storage
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_STORAGE_LISTENER_H_
@@ -0,0 +1,92 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_STORAGE_METADATA_H_
+#define FAKE_FIREBASE_STORAGE_METADATA_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace firebase {
+namespace storage {
+
+namespace internal {
+struct ObjectStore;
+}  // namespace internal
+
+class Storage;
+class StorageReference;
+
+class Metadata {
+ public:
+  Metadata() = default;
+
+  bool is_valid() const { return true; }
+
+  const char* bucket() const { return bucket_.c_str(); }
+  const char* cache_control() const { return cache_control_.c_str(); }
+  const char* content_disposition() const {
+    return content_disposition_.c_str();
+  }
+  const char* content_encoding() const { return content_encoding_.c_str(); }
+  const char* content_language() const { return content_language_.c_str(); }
+  const char* content_type() const { return content_type_.c_str(); }
+  const char* md5_hash() const { return md5_hash_.c_str(); }
+  const char* name() const;
+  const char* path() const { return path_.c_str(); }
+  int64_t creation_time() const { return creation_time_; }
+  int64_t updated_time() const { return updated_time_; }
+  int64_t generation() const { return generation_; }
+  int64_t metadata_generation() const { return metadata_generation_; }
+  int64_t size_bytes() const { return size_bytes_; }
+  std::map<std::string, std::string>* custom_metadata() const {
+    return &custom_metadata_;
+  }
+  StorageReference GetReference() const;
+
+  void set_cache_control(const char* value) { cache_control_ = value; }
+  void set_cache_control(const std::string& value) { cache_control_ = value; }
+  void set_content_disposition(const char* value) {
+    content_disposition_ = value;
+  }
+  void set_content_disposition(const std::string& value) {
+    content_disposition_ = value;
+  }
+  void set_content_encoding(const char* value) { content_encoding_ = value; }
+  void set_content_encoding(const std::string& value) {
+    content_encoding_ = value;
+  }
+  void set_content_language(const char* value) { content_language_ = value; }
+  void set_content_language(const std::string& value) {
+    content_language_ = value;
+  }
+  void set_content_type(const char* value) { content_type_ = value; }
+  void set_content_type(const std::string& value) { content_type_ = value; }
+
+ private:
+  friend class StorageReference;
+  friend struct internal::ObjectStore;
+
+  Storage* storage_{nullptr};
+  std::string bucket_;
+  std::string cache_control_;
+  std::string content_disposition_;
+  std::string content_encoding_;
+  std::string content_language_;
+  std::string content_type_;
+  std::string md5_hash_;
+  std::string path_;
+  int64_t creation_time_{0};
+  int64_t updated_time_{0};
+  int64_t generation_{0};
+  int64_t metadata_generation_{0};
+  int64_t size_bytes_{0};
+  mutable std::map<std::string, std::string> custom_metadata_;
+};
+
+}  // namespace storage
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_STORAGE_METADATA_H_
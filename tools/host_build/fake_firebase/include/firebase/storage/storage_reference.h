@@ -0,0 +1,83 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_STORAGE_STORAGE_REFERENCE_H_
+#define FAKE_FIREBASE_STORAGE_STORAGE_REFERENCE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "firebase/future.h"
+#include "firebase/storage/controller.h"
+#include "firebase/storage/listener.h"
+#include "firebase/storage/metadata.h"
+
+namespace firebase {
+namespace storage {
+
+class ListResult;
+class Storage;
+
+// Transfers (GetBytes, GetFile, PutBytes, PutFile) run on a worker thread in
+// chunks, reporting progress and honoring pause, resume and cancel between
+// chunks. Other operations complete before returning.
+class StorageReference {
+ public:
+  StorageReference() = default;
+
+  Storage* storage() const { return storage_; }
+  std::string bucket() const;
+  std::string full_path() const { return path_; }
+  std::string name() const;
+  bool is_valid() const { return storage_ != nullptr; }
+
+  StorageReference Child(const char* path) const;
+  StorageReference Child(const std::string& path) const {
+    return Child(path.c_str());
+  }
+  StorageReference GetParent() const;
+
+  Future<void> Delete();
+  Future<std::string> GetDownloadUrl();
+  Future<Metadata> GetMetadata();
+  Future<Metadata> UpdateMetadata(const Metadata& metadata);
+  Future<ListResult> List(int32_t max_results, const std::string& page_token);
+  Future<ListResult> List(int32_t max_results) { return List(max_results, ""); }
+
+  Future<size_t> GetBytes(void* buffer, size_t buffer_size,
+                          Listener* listener = nullptr,
+                          Controller* controller_out = nullptr);
+  Future<size_t> GetFile(const char* path, Listener* listener = nullptr,
+                         Controller* controller_out = nullptr);
+
+  Future<Metadata> PutBytes(const void* buffer, size_t buffer_size,
+                            Listener* listener = nullptr,
+                            Controller* controller_out = nullptr);
+  Future<Metadata> PutBytes(const void* buffer, size_t buffer_size,
+                            const Metadata& metadata,
+                            Listener* listener = nullptr,
+                            Controller* controller_out = nullptr);
+  Future<Metadata> PutFile(const char* path, Listener* listener = nullptr,
+                           Controller* controller_out = nullptr);
+  Future<Metadata> PutFile(const char* path, const Metadata& metadata,
+                           Listener* listener = nullptr,
+                           Controller* controller_out = nullptr);
+
+ private:
+  friend class Storage;
+  friend class Metadata;
+  friend class Controller;
+
+  StorageReference(Storage* storage, const std::string& path)
+      : storage_(storage), path_(path) {}
+
+  Storage* storage_{nullptr};
+  std::string path_;
+};
+
+}  // namespace storage
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_STORAGE_STORAGE_REFERENCE_H_
@@ -0,0 +1,124 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FIREBASE_VARIANT_H_
+#define FAKE_FIREBASE_VARIANT_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace firebase {
+
+// A simplified but API compatible version of firebase::Variant.
+class Variant {
+ public:
+  enum Type {
+    kTypeNull,
+    kTypeInt64,
+    kTypeDouble,
+    kTypeBool,
+    kTypeStaticString,
+    kTypeMutableString,
+    kTypeVector,
+    kTypeMap,
+    kTypeStaticBlob,
+    kTypeMutableBlob,
+  };
+
+  Variant() = default;
+  Variant(const Variant& other) { *this = other; }
+  Variant(Variant&& other) = default;
+  Variant& operator=(const Variant& other);
+  Variant& operator=(Variant&& other) = default;
+
+  template <typename T,
+            typename = std::enable_if_t<std::is_integral_v<T> &&
+                                        !std::is_same_v<T, bool>>>
+  Variant(T value)  // NOLINT
+      : type_(kTypeInt64), int64_value_(static_cast<int64_t>(value)) {}
+  Variant(double value)  // NOLINT
+      : type_(kTypeDouble), double_value_(value) {}
+  Variant(float value)  // NOLINT
+      : type_(kTypeDouble), double_value_(value) {}
+  Variant(bool value)  // NOLINT
+      : type_(kTypeBool), bool_value_(value) {}
+  Variant(const char* value)  // NOLINT
+      : type_(kTypeStaticString), string_value_(value ? value : "") {}
+  Variant(const std::string& value)  // NOLINT
+      : type_(kTypeMutableString), string_value_(value) {}
+  Variant(const std::vector<Variant>& value)  // NOLINT
+      : type_(kTypeVector), vector_value_(value) {}
+  template <typename T>
+  Variant(const std::vector<T>& value)  // NOLINT
+      : type_(kTypeVector), vector_value_(value.begin(), value.end()) {}
+  Variant(const std::map<Variant, Variant>& value)  // NOLINT
+      : type_(kTypeMap),
+        map_value_(std::make_unique<std::map<Variant, Variant>>(value)) {}
+  template <typename K, typename V>
+  Variant(const std::map<K, V>& value)  // NOLINT
+      : type_(kTypeMap),
+        map_value_(std::make_unique<std::map<Variant, Variant>>()) {
+    for (const auto& [key, item] : value) {
+      map_value_->emplace(Variant(key), Variant(item));
+    }
+  }
+
+  static Variant Null() { return Variant(); }
+  static Variant EmptyVector() { return Variant(std::vector<Variant>()); }
+  static Variant EmptyMap() { return Variant(std::map<Variant, Variant>()); }
+  static Variant FromMutableBlob(const void* blob, size_t size);
+
+  Type type() const { return type_; }
+
+  bool is_null() const { return type_ == kTypeNull; }
+  bool is_int64() const { return type_ == kTypeInt64; }
+  bool is_double() const { return type_ == kTypeDouble; }
+  bool is_bool() const { return type_ == kTypeBool; }
+  bool is_vector() const { return type_ == kTypeVector; }
+  bool is_map() const { return type_ == kTypeMap; }
+  bool is_string() const {
+    return type_ == kTypeStaticString || type_ == kTypeMutableString;
+  }
+  bool is_blob() const {
+    return type_ == kTypeStaticBlob || type_ == kTypeMutableBlob;
+  }
+  bool is_fundamental_type() const { return type_ < kTypeVector; }
+  bool is_container_type() const { return is_vector() || is_map(); }
+
+  int64_t int64_value() const { return int64_value_; }
+  double double_value() const { return double_value_; }
+  bool bool_value() const { return bool_value_; }
+  const char* string_value() const { return string_value_.c_str(); }
+  std::string& mutable_string();
+  const std::string& mutable_string() const;
+  const std::vector<Variant>& vector() const;
+  std::vector<Variant>& vector();
+  const std::map<Variant, Variant>& map() const;
+  std::map<Variant, Variant>& map();
+  const uint8_t* blob_data() const;
+  size_t blob_size() const;
+
+  bool operator==(const Variant& other) const;
+  bool operator!=(const Variant& other) const { return !(*this == other); }
+  bool operator<(const Variant& other) const;
+
+ private:
+  Type type_{kTypeNull};
+  int64_t int64_value_{0};
+  double double_value_{0};
+  bool bool_value_{false};
+  // Strings and blobs are always stored by value, and like the real SDK,
+  // containers are deep-copied along with the Variant.
+  std::string string_value_;
+  std::vector<Variant> vector_value_;
+  std::unique_ptr<std::map<Variant, Variant>> map_value_;
+};
+
+}  // namespace firebase
+
+#endif  // FAKE_FIREBASE_VARIANT_H_
@@ -0,0 +1,58 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "firebase/app.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace firebase {
+
+const char* const kDefaultAppName = "__FIRAPP_DEFAULT";
+
+namespace {
+
+std::mutex apps_mutex;
+std::vector<App*> apps;
+
+}  // namespace
+
+App::~App() {
+  std::lock_guard<std::mutex> lock(apps_mutex);
+  apps.erase(std::remove(apps.begin(), apps.end(), this), apps.end());
+}
+
+App* App::Create(const AppOptions& options) {
+  return Create(options, kDefaultAppName);
+}
+
+App* App::Create(const AppOptions& options, const char* name) {
+  App* app = GetInstance(name);
+  if (app) {
+    return app;
+  }
+  app = new App(options, name);
+  std::lock_guard<std::mutex> lock(apps_mutex);
+  apps.push_back(app);
+  return app;
+}
+
+App* App::GetInstance() { return GetInstance(kDefaultAppName); }
+
+App* App::GetInstance(const char* name) {
+  std::lock_guard<std::mutex> lock(apps_mutex);
+  for (App* app : apps) {
+    if (app->name_ == name) {
+      return app;
+    }
+  }
+  return nullptr;
+}
+
+std::vector<App*> App::GetApps() {
+  std::lock_guard<std::mutex> lock(apps_mutex);
+  return apps;
+}
+
+}  // namespace firebase
@@ -0,0 +1,97 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "firebase/app/src/base64.h"
+
+#include <cstdint>
+
+namespace firebase {
+namespace internal {
+
+namespace {
+
+constexpr char kAlphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+int DecodeChar(char c) {
+  if (c >= 'A' && c <= 'Z') return c - 'A';
+  if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+  if (c >= '0' && c <= '9') return c - '0' + 52;
+  if (c == '+') return 62;
+  if (c == '/') return 63;
+  return -1;
+}
+
+}  // namespace
+
+bool Base64Encode(const std::string& input, std::string* output) {
+  if (!output) {
+    return false;
+  }
+  std::string encoded;
+  encoded.reserve((input.size() + 2) / 3 * 4);
+  size_t i = 0;
+  for (; i + 2 < input.size(); i += 3) {
+    uint32_t triple = (static_cast<uint8_t>(input[i]) << 16) |
+                      (static_cast<uint8_t>(input[i + 1]) << 8) |
+                      static_cast<uint8_t>(input[i + 2]);
+    encoded.push_back(kAlphabet[(triple >> 18) & 0x3f]);
+    encoded.push_back(kAlphabet[(triple >> 12) & 0x3f]);
+    encoded.push_back(kAlphabet[(triple >> 6) & 0x3f]);
+    encoded.push_back(kAlphabet[triple & 0x3f]);
+  }
+  size_t rest = input.size() - i;
+  if (rest > 0) {
+    uint32_t triple = static_cast<uint8_t>(input[i]) << 16;
+    if (rest == 2) {
+      triple |= static_cast<uint8_t>(input[i + 1]) << 8;
+    }
+    encoded.push_back(kAlphabet[(triple >> 18) & 0x3f]);
+    encoded.push_back(kAlphabet[(triple >> 12) & 0x3f]);
+    encoded.push_back(rest == 2 ? kAlphabet[(triple >> 6) & 0x3f] : '=');
+    encoded.push_back('=');
+  }
+  *output = std::move(encoded);
+  return true;
+}
+
+// Decodes one byte at a time, like the SDK's own portable implementation.
+bool Base64Decode(const std::string& input, std::string* output) {
+  if (!output || input.size() % 4 != 0) {
+    return false;
+  }
+  std::string decoded;
+  decoded.reserve(input.size() / 4 * 3);
+  uint32_t bits = 0;
+  int bit_count = 0;
+  size_t padding = 0;
+  for (size_t i = 0; i < input.size(); ++i) {
+    char c = input[i];
+    if (c == '=') {
+      if (i + 2 < input.size()) {
+        return false;
+      }
+      ++padding;
+      continue;
+    }
+    if (padding > 0) {
+      return false;
+    }
+    int value = DecodeChar(c);
+    if (value < 0) {
+      return false;
+    }
+    bits = (bits << 6) | static_cast<uint32_t>(value);
+    bit_count += 6;
+    if (bit_count >= 8) {
+      bit_count -= 8;
+      decoded.push_back(static_cast<char>((bits >> bit_count) & 0xff));
+    }
+  }
+  *output = std::move(decoded);
+  return true;
+}
+
+}  // namespace internal
+}  // namespace firebase
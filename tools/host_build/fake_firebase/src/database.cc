@@ -0,0 +1,619 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "firebase/database.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace firebase {
+namespace database {
+
+namespace {
+
+std::vector<std::string> SplitPath(const std::string& path) {
+  std::vector<std::string> components;
+  size_t start = 0;
+  while (start <= path.size()) {
+    size_t end = path.find('/', start);
+    if (end == std::string::npos) {
+      end = path.size();
+    }
+    if (end > start) {
+      components.push_back(path.substr(start, end - start));
+    }
+    start = end + 1;
+  }
+  return components;
+}
+
+std::string JoinPath(const std::vector<std::string>& components) {
+  std::string path;
+  for (const auto& component : components) {
+    if (!path.empty()) {
+      path += '/';
+    }
+    path += component;
+  }
+  return path;
+}
+
+std::string NormalizePath(const std::string& path) {
+  return JoinPath(SplitPath(path));
+}
+
+std::string ChildPath(const std::string& parent, const std::string& child) {
+  return NormalizePath(parent + "/" + child);
+}
+
+std::string LastComponent(const std::string& path) {
+  size_t pos = path.rfind('/');
+  return pos == std::string::npos ? path : path.substr(pos + 1);
+}
+
+std::string KeyToString(const Variant& key) {
+  if (key.is_string()) {
+    return key.string_value();
+  }
+  if (key.is_int64()) {
+    return std::to_string(key.int64_value());
+  }
+  return std::string();
+}
+
+// Returns whether |a| and |b| are the same location or one contains the
+// other.
+bool IsRelated(const std::string& a, const std::string& b) {
+  auto is_prefix = [](const std::string& prefix, const std::string& path) {
+    return prefix.empty() || path == prefix ||
+           (path.size() > prefix.size() && path[prefix.size()] == '/' &&
+            path.compare(0, prefix.size(), prefix) == 0);
+  };
+  return is_prefix(a, b) || is_prefix(b, a);
+}
+
+std::vector<std::pair<std::string, Variant>> ChildrenOf(const Variant& value) {
+  std::vector<std::pair<std::string, Variant>> children;
+  if (value.is_map()) {
+    for (const auto& [key, child] : value.map()) {
+      children.emplace_back(KeyToString(key), child);
+    }
+  } else if (value.is_vector()) {
+    const auto& vector = value.vector();
+    for (size_t i = 0; i < vector.size(); ++i) {
+      children.emplace_back(std::to_string(i), vector[i]);
+    }
+  }
+  return children;
+}
+
+const Variant* FindChild(const Variant& value, const std::string& key) {
+  if (!value.is_map()) {
+    return nullptr;
+  }
+  auto it = value.map().find(Variant(key));
+  return it == value.map().end() ? nullptr : &it->second;
+}
+
+Future<void> CompletedVoidFuture() {
+  return firebase::internal::CompletedFuture<void>(kErrorNone, "");
+}
+
+}  // namespace
+
+namespace internal {
+
+class DatabaseInternal {
+ public:
+  Variant GetValue(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return GetValueLocked(path);
+  }
+
+  Variant GetPriority(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = priorities_.find(path);
+    return it == priorities_.end() ? Variant() : it->second;
+  }
+
+  DataSnapshot GetSnapshot(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return SnapshotLocked(path);
+  }
+
+  void SetValue(const std::string& path, const Variant& value) {
+    Write(path, [&]() { SetValueLocked(path, value); });
+  }
+
+  void SetPriority(const std::string& path, const Variant& priority) {
+    Write(path, [&]() { SetPriorityLocked(path, priority); });
+  }
+
+  void SetValueAndPriority(const std::string& path, const Variant& value,
+                           const Variant& priority) {
+    Write(path, [&]() {
+      SetValueLocked(path, value);
+      SetPriorityLocked(path, priority);
+    });
+  }
+
+  void UpdateChildren(const std::string& path, const Variant& values) {
+    Write(path, [&]() {
+      for (const auto& [key, value] : ChildrenOf(values)) {
+        SetValueLocked(ChildPath(path, key), value);
+      }
+    });
+  }
+
+  void AddValueListener(const std::string& path, ValueListener* listener) {
+    DataSnapshot snapshot;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      value_listeners_.emplace_back(path, listener);
+      snapshot = SnapshotLocked(path);
+    }
+    listener->OnValueChanged(snapshot);
+  }
+
+  void AddChildListener(const std::string& path, ChildListener* listener) {
+    Variant value;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      child_listeners_.emplace_back(path, listener);
+      value = GetValueLocked(path);
+    }
+    std::string previous_key;
+    for (const auto& [key, child] : ChildrenOf(value)) {
+      listener->OnChildAdded(DataSnapshot(key, child), previous_key.c_str());
+      previous_key = key;
+    }
+  }
+
+  void RemoveValueListener(const std::string& path, ValueListener* listener) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    RemoveListener(value_listeners_, path, listener);
+  }
+
+  void RemoveChildListener(const std::string& path, ChildListener* listener) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    RemoveListener(child_listeners_, path, listener);
+  }
+
+  DisconnectionHandler* GetDisconnectionHandler(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& handler = disconnection_handlers_[path];
+    if (!handler) {
+      handler = std::make_unique<DisconnectionHandler>();
+    }
+    return handler.get();
+  }
+
+  std::string NextPushKey() { return "-N" + std::to_string(++push_count_); }
+
+ private:
+  template <typename Listener>
+  using Listeners = std::vector<std::pair<std::string, Listener*>>;
+
+  template <typename Listener>
+  static void RemoveListener(Listeners<Listener>& listeners,
+                             const std::string& path, Listener* listener) {
+    listeners.erase(
+        std::remove_if(listeners.begin(), listeners.end(),
+                       [&](const auto& entry) {
+                         return entry.first == path &&
+                                (entry.second == listener || !listener);
+                       }),
+        listeners.end());
+  }
+
+  Variant GetValueLocked(const std::string& path) const {
+    const Variant* node = &root_;
+    for (const auto& component : SplitPath(path)) {
+      node = FindChild(*node, component);
+      if (!node) {
+        return Variant();
+      }
+    }
+    return *node;
+  }
+
+  DataSnapshot SnapshotLocked(const std::string& path) const {
+    auto it = priorities_.find(path);
+    return DataSnapshot(LastComponent(path), GetValueLocked(path),
+                        it == priorities_.end() ? Variant() : it->second);
+  }
+
+  void SetValueLocked(const std::string& path, const Variant& value) {
+    std::vector<std::string> components = SplitPath(path);
+    if (components.empty()) {
+      root_ = value;
+      return;
+    }
+    // Walks down creating intermediate maps, remembering the visited nodes
+    // so that empty parents can be pruned after a removal.
+    std::vector<Variant*> parents;
+    Variant* node = &root_;
+    for (size_t i = 0; i + 1 < components.size(); ++i) {
+      if (!node->is_map()) {
+        *node = Variant::EmptyMap();
+      }
+      parents.push_back(node);
+      node = &node->map()[Variant(components[i])];
+    }
+    if (!node->is_map()) {
+      *node = Variant::EmptyMap();
+    }
+    if (value.is_null()) {
+      node->map().erase(Variant(components.back()));
+      for (size_t i = parents.size(); i > 0; --i) {
+        if (!node->map().empty()) {
+          break;
+        }
+        parents[i - 1]->map().erase(Variant(components[i - 1]));
+        node = parents[i - 1];
+      }
+      if (root_.is_map() && root_.map().empty()) {
+        root_ = Variant();
+      }
+    } else {
+      node->map()[Variant(components.back())] = value;
+    }
+  }
+
+  void SetPriorityLocked(const std::string& path, const Variant& priority) {
+    if (priority.is_null()) {
+      priorities_.erase(path);
+    } else {
+      priorities_[path] = priority;
+    }
+  }
+
+  // Applies |mutation| and notifies the listeners whose data was changed by
+  // it. Listeners are called without holding the lock.
+  template <typename Mutation>
+  void Write(const std::string& path, Mutation mutation) {
+    std::vector<std::pair<ValueListener*, DataSnapshot>> value_events;
+    std::vector<std::tuple<ChildListener*, Variant, Variant>> child_events;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::vector<Variant> old_values;
+      for (const auto& [location, listener] : value_listeners_) {
+        old_values.push_back(GetValueLocked(location));
+      }
+      std::vector<Variant> old_children;
+      for (const auto& [location, listener] : child_listeners_) {
+        old_children.push_back(GetValueLocked(location));
+      }
+
+      mutation();
+
+      for (size_t i = 0; i < value_listeners_.size(); ++i) {
+        const auto& [location, listener] = value_listeners_[i];
+        if (IsRelated(location, path) &&
+            GetValueLocked(location) != old_values[i]) {
+          value_events.emplace_back(listener, SnapshotLocked(location));
+        }
+      }
+      for (size_t i = 0; i < child_listeners_.size(); ++i) {
+        const auto& [location, listener] = child_listeners_[i];
+        if (IsRelated(location, path)) {
+          child_events.emplace_back(listener, std::move(old_children[i]),
+                                    GetValueLocked(location));
+        }
+      }
+    }
+
+    for (const auto& [listener, snapshot] : value_events) {
+      listener->OnValueChanged(snapshot);
+    }
+    for (const auto& [listener, old_value, new_value] : child_events) {
+      NotifyChildListener(listener, old_value, new_value);
+    }
+  }
+
+  static void NotifyChildListener(ChildListener* listener,
+                                  const Variant& old_value,
+                                  const Variant& new_value) {
+    std::map<std::string, Variant> old_children;
+    for (auto& [key, child] : ChildrenOf(old_value)) {
+      old_children.emplace(key, std::move(child));
+    }
+    std::string previous_key;
+    for (const auto& [key, child] : ChildrenOf(new_value)) {
+      auto it = old_children.find(key);
+      if (it == old_children.end()) {
+        listener->OnChildAdded(DataSnapshot(key, child), previous_key.c_str());
+      } else {
+        if (it->second != child) {
+          listener->OnChildChanged(DataSnapshot(key, child),
+                                   previous_key.c_str());
+        }
+        old_children.erase(it);
+      }
+      previous_key = key;
+    }
+    for (const auto& [key, child] : old_children) {
+      listener->OnChildRemoved(DataSnapshot(key, child));
+    }
+  }
+
+  std::mutex mutex_;
+  Variant root_;
+  std::map<std::string, Variant> priorities_;
+  Listeners<ValueListener> value_listeners_;
+  Listeners<ChildListener> child_listeners_;
+  std::map<std::string, std::unique_ptr<DisconnectionHandler>>
+      disconnection_handlers_;
+  std::atomic<int64_t> push_count_{0};
+};
+
+}  // namespace internal
+
+const char* GetErrorMessage(Error error) {
+  switch (error) {
+    case kErrorNone:
+      return "";
+    case kErrorDisconnected:
+      return "The operation had to be aborted due to a network disconnect.";
+    case kErrorPermissionDenied:
+      return "This client does not have permission to perform this operation.";
+    case kErrorWriteCanceled:
+      return "The write was canceled by the user.";
+    case kErrorTransactionAbortedByUser:
+      return "The transaction was aborted.";
+    default:
+      return "An unknown error occurred.";
+  }
+}
+
+// DataSnapshot
+
+bool DataSnapshot::has_children() const { return children_count() > 0; }
+
+size_t DataSnapshot::children_count() const {
+  if (value_.is_map()) {
+    return value_.map().size();
+  }
+  if (value_.is_vector()) {
+    return value_.vector().size();
+  }
+  return 0;
+}
+
+std::vector<DataSnapshot> DataSnapshot::children() const {
+  std::vector<DataSnapshot> children;
+  for (const auto& [key, child] : ChildrenOf(value_)) {
+    children.emplace_back(key, child);
+  }
+  return children;
+}
+
+DataSnapshot DataSnapshot::Child(const std::string& path) const {
+  const Variant* node = &value_;
+  std::vector<std::string> components = SplitPath(path);
+  for (const auto& component : components) {
+    node = FindChild(*node, component);
+    if (!node) {
+      return DataSnapshot(LastComponent(path), Variant());
+    }
+  }
+  return DataSnapshot(components.empty() ? key_ : components.back(), *node);
+}
+
+bool DataSnapshot::HasChild(const std::string& path) const {
+  return Child(path).exists();
+}
+
+// MutableData
+
+std::vector<MutableData> MutableData::children() {
+  std::vector<MutableData> children;
+  for (const auto& [key, child] : ChildrenOf(value_)) {
+    children.emplace_back(key, child);
+  }
+  return children;
+}
+
+size_t MutableData::children_count() { return ChildrenOf(value_).size(); }
+
+// Query
+
+Future<DataSnapshot> Query::GetValue() {
+  return firebase::internal::CompletedFuture<DataSnapshot>(
+      kErrorNone, "", database_->GetSnapshot(path_));
+}
+
+void Query::AddValueListener(ValueListener* listener) {
+  database_->AddValueListener(path_, listener);
+}
+
+void Query::RemoveValueListener(ValueListener* listener) {
+  database_->RemoveValueListener(path_, listener);
+}
+
+void Query::RemoveAllValueListeners() {
+  database_->RemoveValueListener(path_, nullptr);
+}
+
+void Query::AddChildListener(ChildListener* listener) {
+  database_->AddChildListener(path_, listener);
+}
+
+void Query::RemoveChildListener(ChildListener* listener) {
+  database_->RemoveChildListener(path_, listener);
+}
+
+void Query::RemoveAllChildListeners() {
+  database_->RemoveChildListener(path_, nullptr);
+}
+
+// DatabaseReference
+
+const char* DatabaseReference::key() const {
+  static thread_local std::string key;
+  key = key_string();
+  return key.c_str();
+}
+
+std::string DatabaseReference::key_string() const {
+  return LastComponent(path_);
+}
+
+DatabaseReference DatabaseReference::GetParent() const {
+  std::vector<std::string> components = SplitPath(path_);
+  if (!components.empty()) {
+    components.pop_back();
+  }
+  return DatabaseReference(database_, JoinPath(components));
+}
+
+DatabaseReference DatabaseReference::GetRoot() const {
+  return DatabaseReference(database_, "");
+}
+
+DatabaseReference DatabaseReference::Child(const char* path) const {
+  return DatabaseReference(database_, ChildPath(path_, path));
+}
+
+DatabaseReference DatabaseReference::Child(const std::string& path) const {
+  return Child(path.c_str());
+}
+
+DatabaseReference DatabaseReference::PushChild() const {
+  return Child(database_->NextPushKey());
+}
+
+Future<void> DatabaseReference::RemoveValue() { return SetValue(Variant()); }
+
+Future<void> DatabaseReference::SetValue(Variant value) {
+  database_->SetValue(path_, value);
+  return CompletedVoidFuture();
+}
+
+Future<void> DatabaseReference::SetPriority(Variant priority) {
+  database_->SetPriority(path_, priority);
+  return CompletedVoidFuture();
+}
+
+Future<void> DatabaseReference::SetValueAndPriority(Variant value,
+                                                    Variant priority) {
+  database_->SetValueAndPriority(path_, value, priority);
+  return CompletedVoidFuture();
+}
+
+Future<void> DatabaseReference::UpdateChildren(Variant values) {
+  database_->UpdateChildren(path_, values);
+  return CompletedVoidFuture();
+}
+
+Future<DataSnapshot> DatabaseReference::RunTransaction(
+    DoTransactionFunction transaction_function, bool trigger_local_events) {
+  firebase::internal::Promise<DataSnapshot> promise;
+  internal::DatabaseInternal* database = database_;
+  std::string path = path_;
+  std::thread([promise, database, path,
+               transaction_function =
+                   std::move(transaction_function)]() mutable {
+    MutableData data(LastComponent(path), database->GetValue(path),
+                     database->GetPriority(path));
+    if (transaction_function(&data) == kTransactionResultSuccess) {
+      database->SetValue(path, data.value());
+      promise.Complete(kErrorNone, "", database->GetSnapshot(path));
+    } else {
+      promise.Complete(kErrorTransactionAbortedByUser,
+                       GetErrorMessage(kErrorTransactionAbortedByUser),
+                       database->GetSnapshot(path));
+    }
+  }).detach();
+  return promise.future();
+}
+
+DisconnectionHandler* DatabaseReference::OnDisconnect() {
+  return database_->GetDisconnectionHandler(path_);
+}
+
+std::string DatabaseReference::url() const { return path_; }
+
+// DisconnectionHandler
+
+Future<void> DisconnectionHandler::Cancel() { return CompletedVoidFuture(); }
+
+Future<void> DisconnectionHandler::RemoveValue() {
+  return CompletedVoidFuture();
+}
+
+Future<void> DisconnectionHandler::SetValue(Variant value) {
+  return CompletedVoidFuture();
+}
+
+Future<void> DisconnectionHandler::SetValueAndPriority(Variant value,
+                                                       Variant priority) {
+  return CompletedVoidFuture();
+}
+
+Future<void> DisconnectionHandler::UpdateChildren(Variant values) {
+  return CompletedVoidFuture();
+}
+
+// Database
+
+namespace {
+
+std::mutex databases_mutex;
+std::map<std::pair<App*, std::string>, Database*> databases;
+
+}  // namespace
+
+Database::Database(App* app, const char* url)
+    : app_(app),
+      url_(url),
+      internal_(std::make_unique<internal::DatabaseInternal>()) {}
+
+Database::~Database() = default;
+
+Database* Database::GetInstance(App* app, InitResult* init_result_out) {
+  return GetInstance(app, app ? app->options().database_url() : "",
+                     init_result_out);
+}
+
+Database* Database::GetInstance(App* app, const char* url,
+                                InitResult* init_result_out) {
+  if (init_result_out) {
+    *init_result_out = kInitResultSuccess;
+  }
+  if (!app) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(databases_mutex);
+  Database*& database = databases[{app, url ? url : ""}];
+  if (!database) {
+    database = new Database(app, url ? url : "");
+  }
+  return database;
+}
+
+DatabaseReference Database::GetReference() const {
+  return DatabaseReference(internal_.get(), "");
+}
+
+DatabaseReference Database::GetReference(const char* path) const {
+  return DatabaseReference(internal_.get(), NormalizePath(path ? path : ""));
+}
+
+DatabaseReference Database::GetReferenceFromUrl(const char* url) const {
+  std::string path = url ? url : "";
+  if (path.compare(0, url_.size(), url_) == 0) {
+    path = path.substr(url_.size());
+  }
+  return GetReference(path.c_str());
+}
+
+}  // namespace database
+}  // namespace firebase
@@ -0,0 +1,64 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "firebase/functions.h"
+
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace firebase {
+namespace functions {
+
+namespace {
+
+constexpr char kDefaultRegion[] = "us-central1";
+constexpr char kErrorFunctionName[] = "error";
+
+std::mutex functions_mutex;
+std::map<std::pair<App*, std::string>, Functions*> functions_instances;
+
+}  // namespace
+
+Functions* Functions::GetInstance(App* app, InitResult* init_result_out) {
+  return GetInstance(app, kDefaultRegion, init_result_out);
+}
+
+Functions* Functions::GetInstance(App* app, const char* region,
+                                  InitResult* init_result_out) {
+  if (init_result_out) {
+    *init_result_out = kInitResultSuccess;
+  }
+  if (!app) {
+    return nullptr;
+  }
+  std::string region_name = region ? region : kDefaultRegion;
+  std::lock_guard<std::mutex> lock(functions_mutex);
+  Functions*& functions = functions_instances[{app, region_name}];
+  if (!functions) {
+    functions = new Functions(app, region_name.c_str());
+  }
+  return functions;
+}
+
+HttpsCallableReference Functions::GetHttpsCallable(const char* name) const {
+  return HttpsCallableReference(const_cast<Functions*>(this),
+                                name ? name : "");
+}
+
+Future<HttpsCallableResult> HttpsCallableReference::Call() {
+  return Call(Variant());
+}
+
+Future<HttpsCallableResult> HttpsCallableReference::Call(const Variant& data) {
+  if (name_ == kErrorFunctionName) {
+    return firebase::internal::CompletedFuture<HttpsCallableResult>(
+        kErrorInternal, "INTERNAL");
+  }
+  return firebase::internal::CompletedFuture<HttpsCallableResult>(
+      kErrorNone, "", HttpsCallableResult(data));
+}
+
+}  // namespace functions
+}  // namespace firebase
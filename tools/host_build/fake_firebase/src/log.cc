@@ -0,0 +1,21 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "firebase/log.h"
+
+#include <atomic>
+
+namespace firebase {
+
+namespace {
+
+std::atomic<LogLevel> log_level{kLogLevelInfo};
+
+}  // namespace
+
+void SetLogLevel(LogLevel level) { log_level = level; }
+
+LogLevel GetLogLevel() { return log_level; }
+
+}  // namespace firebase
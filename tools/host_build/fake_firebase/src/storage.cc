@@ -0,0 +1,852 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "firebase/storage.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cctype>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+
+#include "fake_firebase/storage_control.h"
+#include "firebase/app/src/base64.h"
+
+namespace firebase {
+namespace storage {
+
+namespace {
+
+constexpr char kDownloadUrlPrefix[] =
+    "https://firebasestorage.googleapis.com/v0/b/";
+
+std::atomic<size_t> transfer_chunk_size{256 * 1024};
+std::atomic<int64_t> transfer_chunk_delay_us{0};
+
+std::string NormalizePath(const std::string& path) {
+  std::string normalized;
+  size_t start = 0;
+  while (start <= path.size()) {
+    size_t end = path.find('/', start);
+    if (end == std::string::npos) {
+      end = path.size();
+    }
+    if (end > start) {
+      if (!normalized.empty()) {
+        normalized += '/';
+      }
+      normalized.append(path, start, end - start);
+    }
+    start = end + 1;
+  }
+  return normalized;
+}
+
+std::string LastComponent(const std::string& path) {
+  size_t pos = path.rfind('/');
+  return pos == std::string::npos ? path : path.substr(pos + 1);
+}
+
+std::string BucketFromUrl(const std::string& url) {
+  constexpr char kScheme[] = "gs://";
+  std::string bucket = url;
+  if (bucket.compare(0, sizeof(kScheme) - 1, kScheme) == 0) {
+    bucket = bucket.substr(sizeof(kScheme) - 1);
+  }
+  return bucket.substr(0, bucket.find('/'));
+}
+
+std::string UrlEncode(const std::string& value) {
+  static constexpr char kHex[] = "0123456789ABCDEF";
+  std::string encoded;
+  for (unsigned char c : value) {
+    if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
+      encoded.push_back(static_cast<char>(c));
+    } else {
+      encoded.push_back('%');
+      encoded.push_back(kHex[c >> 4]);
+      encoded.push_back(kHex[c & 0xf]);
+    }
+  }
+  return encoded;
+}
+
+int64_t NowMillis() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+// A plain RFC 1321 MD5, used to fill Metadata::md5_hash() like the server.
+class Md5 {
+ public:
+  void Update(const uint8_t* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+      buffer_[buffer_size_++] = data[i];
+      if (buffer_size_ == 64) {
+        Transform(buffer_);
+        buffer_size_ = 0;
+      }
+    }
+    length_ += size;
+  }
+
+  std::string Finish() {
+    uint64_t bit_length = length_ * 8;
+    uint8_t padding = 0x80;
+    Update(&padding, 1);
+    uint8_t zero = 0;
+    while (buffer_size_ != 56) {
+      Update(&zero, 1);
+    }
+    uint8_t length_bytes[8];
+    for (int i = 0; i < 8; ++i) {
+      length_bytes[i] = static_cast<uint8_t>(bit_length >> (8 * i));
+    }
+    Update(length_bytes, 8);
+    std::string digest(16, '\0');
+    for (int i = 0; i < 4; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        digest[i * 4 + j] = static_cast<char>(state_[i] >> (8 * j));
+      }
+    }
+    return digest;
+  }
+
+ private:
+  static uint32_t Rotate(uint32_t x, int c) {
+    return (x << c) | (x >> (32 - c));
+  }
+
+  void Transform(const uint8_t* block) {
+    static constexpr uint32_t kK[64] = {
+        0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a,
+        0xa8304613, 0xfd469501, 0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
+        0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821, 0xf61e2562, 0xc040b340,
+        0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+        0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8,
+        0x676f02d9, 0x8d2a4c8a, 0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c,
+        0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70, 0x289b7ec6, 0xeaa127fa,
+        0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+        0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92,
+        0xffeff47d, 0x85845dd1, 0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1,
+        0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391};
+    static constexpr int kShift[64] = {
+        7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+        5, 9,  14, 20, 5, 9,  14, 20, 5, 9,  14, 20, 5, 9,  14, 20,
+        4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+        6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21};
+
+    uint32_t m[16];
+    for (int i = 0; i < 16; ++i) {
+      m[i] = block[i * 4] | (block[i * 4 + 1] << 8) |
+             (block[i * 4 + 2] << 16) |
+             (static_cast<uint32_t>(block[i * 4 + 3]) << 24);
+    }
+    uint32_t a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+    for (int i = 0; i < 64; ++i) {
+      uint32_t f;
+      int g;
+      if (i < 16) {
+        f = (b & c) | (~b & d);
+        g = i;
+      } else if (i < 32) {
+        f = (d & b) | (~d & c);
+        g = (5 * i + 1) % 16;
+      } else if (i < 48) {
+        f = b ^ c ^ d;
+        g = (3 * i + 5) % 16;
+      } else {
+        f = c ^ (b | ~d);
+        g = (7 * i) % 16;
+      }
+      uint32_t next = d;
+      d = c;
+      c = b;
+      b = b + Rotate(a + f + kK[i] + m[g], kShift[i]);
+      a = next;
+    }
+    state_[0] += a;
+    state_[1] += b;
+    state_[2] += c;
+    state_[3] += d;
+  }
+
+  uint32_t state_[4] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+  uint8_t buffer_[64];
+  size_t buffer_size_{0};
+  uint64_t length_{0};
+};
+
+std::string Md5Base64(const std::string& data) {
+  Md5 md5;
+  md5.Update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+  std::string encoded;
+  firebase::internal::Base64Encode(md5.Finish(), &encoded);
+  return encoded;
+}
+
+}  // namespace
+
+namespace internal {
+
+struct TransferState {
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool paused{false};
+  bool cancelled{false};
+  bool done{false};
+  std::atomic<int64_t> bytes_transferred{0};
+  std::atomic<int64_t> total_byte_count{-1};
+  StorageReference reference;
+};
+
+struct ObjectStore {
+  struct Object {
+    std::string data;
+    Metadata metadata;
+  };
+
+  static ObjectStore& GetInstance() {
+    static ObjectStore instance;
+    return instance;
+  }
+
+  // Stores |data| and returns its metadata as seen through |storage|.
+  Metadata Put(Storage* storage, const std::string& bucket,
+               const std::string& path, std::string data,
+               const Metadata* metadata) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Object& object = buckets[bucket][path];
+    int64_t now = NowMillis();
+    Metadata& out = object.metadata;
+    if (metadata) {
+      out = *metadata;
+    } else {
+      out = Metadata();
+    }
+    if (out.content_type_.empty()) {
+      out.content_type_ = "application/octet-stream";
+    }
+    out.bucket_ = bucket;
+    out.path_ = path;
+    out.md5_hash_ = Md5Base64(data);
+    out.size_bytes_ = static_cast<int64_t>(data.size());
+    out.creation_time_ = now;
+    out.updated_time_ = now;
+    out.generation_ = ++generation;
+    out.metadata_generation_ = 1;
+    object.data = std::move(data);
+    return WithStorage(out, storage);
+  }
+
+  bool Get(const std::string& bucket, const std::string& path,
+           std::string* data, Metadata* metadata, Storage* storage) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const Object* object = FindLocked(bucket, path);
+    if (!object) {
+      return false;
+    }
+    if (data) {
+      *data = object->data;
+    }
+    if (metadata) {
+      *metadata = WithStorage(object->metadata, storage);
+    }
+    return true;
+  }
+
+  bool Update(Storage* storage, const std::string& bucket,
+              const std::string& path, const Metadata& update,
+              Metadata* metadata) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Object* object = FindLocked(bucket, path);
+    if (!object) {
+      return false;
+    }
+    Metadata& out = object->metadata;
+    auto merge = [](std::string& field, const std::string& value) {
+      if (!value.empty()) {
+        field = value;
+      }
+    };
+    merge(out.cache_control_, update.cache_control_);
+    merge(out.content_disposition_, update.content_disposition_);
+    merge(out.content_encoding_, update.content_encoding_);
+    merge(out.content_language_, update.content_language_);
+    merge(out.content_type_, update.content_type_);
+    for (const auto& [key, value] : update.custom_metadata_) {
+      if (value.empty()) {
+        out.custom_metadata_.erase(key);
+      } else {
+        out.custom_metadata_[key] = value;
+      }
+    }
+    out.updated_time_ = NowMillis();
+    ++out.metadata_generation_;
+    *metadata = WithStorage(out, storage);
+    return true;
+  }
+
+  bool Delete(const std::string& bucket, const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return buckets[bucket].erase(path) > 0;
+  }
+
+  // Returns the sorted names of the objects and prefixes right under
+  // |prefix|. Prefixes end with a '/'.
+  std::vector<std::string> List(const std::string& bucket,
+                                const std::string& prefix) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::set<std::string> names;
+    for (const auto& [path, object] : buckets[bucket]) {
+      if (path.compare(0, prefix.size(), prefix) != 0) {
+        continue;
+      }
+      std::string rest = path.substr(prefix.size());
+      size_t slash = rest.find('/');
+      names.insert(slash == std::string::npos ? rest
+                                              : rest.substr(0, slash + 1));
+    }
+    return std::vector<std::string>(names.begin(), names.end());
+  }
+
+  void Reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    buckets.clear();
+  }
+
+  Object* FindLocked(const std::string& bucket, const std::string& path) {
+    auto bucket_it = buckets.find(bucket);
+    if (bucket_it == buckets.end()) {
+      return nullptr;
+    }
+    auto it = bucket_it->second.find(path);
+    return it == bucket_it->second.end() ? nullptr : &it->second;
+  }
+
+  static Metadata WithStorage(const Metadata& metadata, Storage* storage) {
+    Metadata out = metadata;
+    out.storage_ = storage;
+    return out;
+  }
+
+  std::mutex mutex;
+  std::map<std::string, std::map<std::string, Object>> buckets;
+  int64_t generation{0};
+};
+
+class TransferAccess {
+ public:
+  static const std::shared_ptr<TransferState>& state(
+      const Controller& controller) {
+    return controller.state_;
+  }
+};
+
+// Moves |total| bytes through |step| in chunks, reporting progress to
+// |listener| and waiting while the transfer is paused. Returns false if the
+// transfer was cancelled.
+bool RunTransfer(Controller* controller, TransferState* state,
+                 Listener* listener, int64_t total,
+                 const std::function<bool(int64_t offset, size_t size)>& step) {
+  state->total_byte_count = total;
+  int64_t offset = 0;
+  do {
+    {
+      std::unique_lock<std::mutex> lock(state->mutex);
+      if (state->paused && !state->cancelled) {
+        lock.unlock();
+        if (listener) {
+          listener->OnPaused(controller);
+        }
+        lock.lock();
+        state->cv.wait(lock,
+                       [state] { return !state->paused || state->cancelled; });
+      }
+      if (state->cancelled) {
+        return false;
+      }
+    }
+    size_t size = static_cast<size_t>(
+        std::min<int64_t>(total - offset, transfer_chunk_size.load()));
+    if (!step(offset, size)) {
+      return false;
+    }
+    offset += size;
+    state->bytes_transferred = offset;
+    if (listener) {
+      listener->OnProgress(controller);
+    }
+    int64_t delay = transfer_chunk_delay_us.load();
+    if (delay > 0) {
+      std::this_thread::sleep_for(std::chrono::microseconds(delay));
+    }
+  } while (offset < total);
+  return true;
+}
+
+}  // namespace internal
+
+namespace {
+
+using internal::ObjectStore;
+using internal::TransferAccess;
+using internal::TransferState;
+
+void MarkDone(TransferState* state) {
+  std::lock_guard<std::mutex> lock(state->mutex);
+  state->done = true;
+}
+
+// Runs |body| on a worker thread. The transfer is bound to |controller_out|,
+// or to a private controller if none was given.
+void StartTransfer(const StorageReference& reference,
+                   Controller* controller_out,
+                   std::function<void(Controller*, TransferState*)> body) {
+  auto controller = std::make_shared<Controller>();
+  std::shared_ptr<TransferState> state = TransferAccess::state(*controller);
+  state->reference = reference;
+  if (controller_out) {
+    *controller_out = *controller;
+  }
+  Controller* target = controller_out ? controller_out : controller.get();
+  std::thread([controller, state, target, body = std::move(body)]() {
+    body(target, state.get());
+  }).detach();
+}
+
+template <typename T>
+Future<T> Fail(Error error) {
+  return firebase::internal::CompletedFuture<T>(error, GetErrorMessage(error));
+}
+
+}  // namespace
+
+// Controller
+
+Controller::Controller() : state_(std::make_shared<TransferState>()) {}
+
+Controller::~Controller() = default;
+
+bool Controller::Pause() {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  if (state_->done || state_->cancelled) {
+    return false;
+  }
+  state_->paused = true;
+  return true;
+}
+
+bool Controller::Resume() {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  if (state_->done || state_->cancelled) {
+    return false;
+  }
+  state_->paused = false;
+  state_->cv.notify_all();
+  return true;
+}
+
+bool Controller::Cancel() {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  if (state_->done || state_->cancelled) {
+    return false;
+  }
+  state_->cancelled = true;
+  state_->cv.notify_all();
+  return true;
+}
+
+bool Controller::is_paused() const {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  return state_->paused;
+}
+
+int64_t Controller::bytes_transferred() const {
+  return state_->bytes_transferred;
+}
+
+int64_t Controller::total_byte_count() const {
+  return state_->total_byte_count;
+}
+
+StorageReference Controller::GetReference() const {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  return state_->reference;
+}
+
+// Metadata
+
+const char* Metadata::name() const {
+  size_t pos = path_.rfind('/');
+  return path_.c_str() + (pos == std::string::npos ? 0 : pos + 1);
+}
+
+StorageReference Metadata::GetReference() const {
+  return StorageReference(storage_, path_);
+}
+
+// StorageReference
+
+std::string StorageReference::bucket() const {
+  return storage_ ? storage_->bucket() : std::string();
+}
+
+std::string StorageReference::name() const { return LastComponent(path_); }
+
+StorageReference StorageReference::Child(const char* path) const {
+  return StorageReference(storage_, NormalizePath(path_ + "/" + path));
+}
+
+StorageReference StorageReference::GetParent() const {
+  size_t pos = path_.rfind('/');
+  return StorageReference(
+      storage_, pos == std::string::npos ? "" : path_.substr(0, pos));
+}
+
+Future<void> StorageReference::Delete() {
+  if (!ObjectStore::GetInstance().Delete(bucket(), path_)) {
+    return Fail<void>(kErrorObjectNotFound);
+  }
+  return firebase::internal::CompletedFuture<void>(kErrorNone, "");
+}
+
+Future<std::string> StorageReference::GetDownloadUrl() {
+  if (!ObjectStore::GetInstance().Get(bucket(), path_, nullptr, nullptr,
+                                      storage_)) {
+    return Fail<std::string>(kErrorObjectNotFound);
+  }
+  return firebase::internal::CompletedFuture<std::string>(
+      kErrorNone, "",
+      kDownloadUrlPrefix + bucket() + "/o/" + UrlEncode(path_) + "?alt=media");
+}
+
+Future<Metadata> StorageReference::GetMetadata() {
+  Metadata metadata;
+  if (!ObjectStore::GetInstance().Get(bucket(), path_, nullptr, &metadata,
+                                      storage_)) {
+    return Fail<Metadata>(kErrorObjectNotFound);
+  }
+  return firebase::internal::CompletedFuture<Metadata>(kErrorNone, "",
+                                                       std::move(metadata));
+}
+
+Future<Metadata> StorageReference::UpdateMetadata(const Metadata& metadata) {
+  Metadata updated;
+  if (!ObjectStore::GetInstance().Update(storage_, bucket(), path_, metadata,
+                                         &updated)) {
+    return Fail<Metadata>(kErrorObjectNotFound);
+  }
+  return firebase::internal::CompletedFuture<Metadata>(kErrorNone, "",
+                                                       std::move(updated));
+}
+
+Future<ListResult> StorageReference::List(int32_t max_results,
+                                          const std::string& page_token) {
+  std::string prefix = path_.empty() ? "" : path_ + "/";
+  std::vector<std::string> names =
+      ObjectStore::GetInstance().List(bucket(), prefix);
+
+  // The page token is the index of the first entry of the page.
+  size_t begin = page_token.empty() ? 0 : std::stoul(page_token);
+  size_t end = std::min(names.size(),
+                        begin + static_cast<size_t>(std::max(max_results, 1)));
+  ListResult result;
+  for (size_t i = begin; i < end; ++i) {
+    const std::string& name = names[i];
+    if (name.back() == '/') {
+      result.prefixes_.push_back(
+          StorageReference(storage_, prefix + name.substr(0, name.size() - 1)));
+    } else {
+      result.items_.push_back(StorageReference(storage_, prefix + name));
+    }
+  }
+  if (end < names.size()) {
+    result.page_token_ = std::to_string(end);
+  }
+  return firebase::internal::CompletedFuture<ListResult>(kErrorNone, "",
+                                                         std::move(result));
+}
+
+Future<size_t> StorageReference::GetBytes(void* buffer, size_t buffer_size,
+                                          Listener* listener,
+                                          Controller* controller_out) {
+  firebase::internal::Promise<size_t> promise;
+  std::string bucket = this->bucket();
+  std::string path = path_;
+  StartTransfer(*this, controller_out,
+                [promise, bucket, path, buffer, buffer_size, listener](
+                    Controller* controller, TransferState* state) mutable {
+                  std::string data;
+                  Error error = kErrorNone;
+                  if (!ObjectStore::GetInstance().Get(bucket, path, &data,
+                                                      nullptr, nullptr)) {
+                    error = kErrorObjectNotFound;
+                  } else if (data.size() > buffer_size) {
+                    error = kErrorDownloadSizeExceeded;
+                  } else if (!internal::RunTransfer(
+                                 controller, state, listener,
+                                 static_cast<int64_t>(data.size()),
+                                 [&](int64_t offset, size_t size) {
+                                   std::memcpy(
+                                       static_cast<char*>(buffer) + offset,
+                                       data.data() + offset, size);
+                                   return true;
+                                 })) {
+                    error = kErrorCancelled;
+                  }
+                  MarkDone(state);
+                  promise.Complete(error, GetErrorMessage(error),
+                                   error == kErrorNone ? data.size() : 0);
+                });
+  return promise.future();
+}
+
+Future<size_t> StorageReference::GetFile(const char* path, Listener* listener,
+                                         Controller* controller_out) {
+  firebase::internal::Promise<size_t> promise;
+  std::string bucket = this->bucket();
+  std::string object_path = path_;
+  std::string file_path = path ? path : "";
+  StartTransfer(
+      *this, controller_out,
+      [promise, bucket, object_path, file_path, listener](
+          Controller* controller, TransferState* state) mutable {
+        std::string data;
+        Error error = kErrorNone;
+        if (!ObjectStore::GetInstance().Get(bucket, object_path, &data,
+                                            nullptr, nullptr)) {
+          error = kErrorObjectNotFound;
+        } else {
+          std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+          if (!file) {
+            error = kErrorUnknown;
+          } else if (!internal::RunTransfer(
+                         controller, state, listener,
+                         static_cast<int64_t>(data.size()),
+                         [&](int64_t offset, size_t size) {
+                           return static_cast<bool>(
+                               file.write(data.data() + offset, size));
+                         })) {
+            error = file ? kErrorCancelled : kErrorUnknown;
+          }
+        }
+        MarkDone(state);
+        promise.Complete(error, GetErrorMessage(error),
+                         error == kErrorNone ? data.size() : 0);
+      });
+  return promise.future();
+}
+
+Future<Metadata> StorageReference::PutBytes(const void* buffer,
+                                            size_t buffer_size,
+                                            Listener* listener,
+                                            Controller* controller_out) {
+  return PutBytes(buffer, buffer_size, Metadata(), listener, controller_out);
+}
+
+Future<Metadata> StorageReference::PutBytes(const void* buffer,
+                                            size_t buffer_size,
+                                            const Metadata& metadata,
+                                            Listener* listener,
+                                            Controller* controller_out) {
+  firebase::internal::Promise<Metadata> promise;
+  Storage* storage = storage_;
+  std::string bucket = this->bucket();
+  std::string path = path_;
+  StartTransfer(
+      *this, controller_out,
+      [promise, storage, bucket, path, buffer, buffer_size, metadata,
+       listener](Controller* controller, TransferState* state) mutable {
+        std::string data;
+        data.reserve(buffer_size);
+        bool completed = internal::RunTransfer(
+            controller, state, listener, static_cast<int64_t>(buffer_size),
+            [&](int64_t offset, size_t size) {
+              data.append(static_cast<const char*>(buffer) + offset, size);
+              return true;
+            });
+        MarkDone(state);
+        if (!completed) {
+          promise.Complete(kErrorCancelled, GetErrorMessage(kErrorCancelled),
+                           Metadata());
+          return;
+        }
+        promise.Complete(kErrorNone, "",
+                         ObjectStore::GetInstance().Put(
+                             storage, bucket, path, std::move(data),
+                             &metadata));
+      });
+  return promise.future();
+}
+
+Future<Metadata> StorageReference::PutFile(const char* path, Listener* listener,
+                                           Controller* controller_out) {
+  return PutFile(path, Metadata(), listener, controller_out);
+}
+
+Future<Metadata> StorageReference::PutFile(const char* path,
+                                           const Metadata& metadata,
+                                           Listener* listener,
+                                           Controller* controller_out) {
+  firebase::internal::Promise<Metadata> promise;
+  Storage* storage = storage_;
+  std::string bucket = this->bucket();
+  std::string object_path = path_;
+  std::string file_path = path ? path : "";
+  StartTransfer(
+      *this, controller_out,
+      [promise, storage, bucket, object_path, file_path, metadata, listener](
+          Controller* controller, TransferState* state) mutable {
+        std::ifstream file(file_path, std::ios::binary | std::ios::ate);
+        if (!file) {
+          MarkDone(state);
+          promise.Complete(kErrorUnknown, "Could not open the file.",
+                           Metadata());
+          return;
+        }
+        int64_t size = static_cast<int64_t>(file.tellg());
+        file.seekg(0);
+        std::string data(static_cast<size_t>(size), '\0');
+        bool completed = internal::RunTransfer(
+            controller, state, listener, size,
+            [&](int64_t offset, size_t chunk) {
+              return static_cast<bool>(file.read(&data[offset], chunk));
+            });
+        MarkDone(state);
+        if (!completed) {
+          Error error = file ? kErrorCancelled : kErrorUnknown;
+          promise.Complete(error, GetErrorMessage(error), Metadata());
+          return;
+        }
+        promise.Complete(kErrorNone, "",
+                         ObjectStore::GetInstance().Put(
+                             storage, bucket, object_path, std::move(data),
+                             &metadata));
+      });
+  return promise.future();
+}
+
+// Storage
+
+namespace {
+
+std::mutex storages_mutex;
+std::map<std::pair<App*, std::string>, Storage*> storages;
+
+}  // namespace
+
+Storage* Storage::GetInstance(App* app, InitResult* init_result_out) {
+  return GetInstance(
+      app,
+      app ? (std::string("gs://") + app->options().storage_bucket()).c_str()
+          : "",
+      init_result_out);
+}
+
+Storage* Storage::GetInstance(App* app, const char* url,
+                              InitResult* init_result_out) {
+  if (init_result_out) {
+    *init_result_out = kInitResultSuccess;
+  }
+  if (!app) {
+    return nullptr;
+  }
+  std::string bucket = BucketFromUrl(url ? url : "");
+  std::lock_guard<std::mutex> lock(storages_mutex);
+  Storage*& storage = storages[{app, bucket}];
+  if (!storage) {
+    storage = new Storage(app, bucket);
+  }
+  return storage;
+}
+
+StorageReference Storage::GetReference() const {
+  return StorageReference(const_cast<Storage*>(this), "");
+}
+
+StorageReference Storage::GetReference(const char* path) const {
+  return StorageReference(const_cast<Storage*>(this),
+                          NormalizePath(path ? path : ""));
+}
+
+StorageReference Storage::GetReferenceFromUrl(const char* url) const {
+  std::string path = url ? url : "";
+  std::string prefix = "gs://" + bucket_;
+  if (path.compare(0, prefix.size(), prefix) == 0) {
+    path = path.substr(prefix.size());
+  }
+  return GetReference(path.c_str());
+}
+
+const char* GetErrorMessage(Error error) {
+  switch (error) {
+    case kErrorNone:
+      return "";
+    case kErrorObjectNotFound:
+      return "No object exists at the desired reference.";
+    case kErrorBucketNotFound:
+      return "No bucket is configured for Cloud Storage.";
+    case kErrorProjectNotFound:
+      return "No project is configured for Cloud Storage.";
+    case kErrorQuotaExceeded:
+      return "Quota on your Cloud Storage bucket has been exceeded.";
+    case kErrorUnauthenticated:
+      return "User is unauthenticated.";
+    case kErrorUnauthorized:
+      return "User is not authorized to perform the desired action.";
+    case kErrorRetryLimitExceeded:
+      return "The maximum time limit on an operation has been exceeded.";
+    case kErrorNonMatchingChecksum:
+      return "File on the client does not match the checksum of the file "
+             "received by the server.";
+    case kErrorDownloadSizeExceeded:
+      return "Size of the downloaded file exceeds the amount of memory "
+             "allocated for the download.";
+    case kErrorCancelled:
+      return "User cancelled the operation.";
+    case kErrorUnknown:
+    default:
+      return "An unknown error occurred.";
+  }
+}
+
+}  // namespace storage
+}  // namespace firebase
+
+namespace fake_firebase {
+
+using firebase::storage::internal::ObjectStore;
+
+void SetStorageTransferPacing(size_t chunk_size,
+                              std::chrono::microseconds chunk_delay) {
+  firebase::storage::transfer_chunk_size = std::max<size_t>(chunk_size, 1);
+  firebase::storage::transfer_chunk_delay_us = chunk_delay.count();
+}
+
+void PutStorageObject(const std::string& bucket, const std::string& path,
+                      const std::string& data,
+                      const std::string& content_type) {
+  firebase::storage::Metadata metadata;
+  metadata.set_content_type(content_type);
+  ObjectStore::GetInstance().Put(nullptr, bucket, path, data, &metadata);
+}
+
+bool GetStorageObject(const std::string& bucket, const std::string& path,
+                      std::string* data) {
+  return ObjectStore::GetInstance().Get(bucket, path, data, nullptr, nullptr);
+}
+
+void ResetStorage() { ObjectStore::GetInstance().Reset(); }
+
+}  // namespace fake_firebase
@@ -0,0 +1,128 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "firebase/variant.h"
+
+namespace firebase {
+
+namespace {
+
+const std::vector<Variant> kEmptyVector;
+const std::map<Variant, Variant> kEmptyMap;
+
+}  // namespace
+
+Variant& Variant::operator=(const Variant& other) {
+  if (this == &other) {
+    return *this;
+  }
+  type_ = other.type_;
+  int64_value_ = other.int64_value_;
+  double_value_ = other.double_value_;
+  bool_value_ = other.bool_value_;
+  string_value_ = other.string_value_;
+  vector_value_ = other.vector_value_;
+  map_value_ = other.map_value_
+                   ? std::make_unique<std::map<Variant, Variant>>(
+                         *other.map_value_)
+                   : nullptr;
+  return *this;
+}
+
+Variant Variant::FromMutableBlob(const void* blob, size_t size) {
+  Variant variant;
+  variant.type_ = kTypeMutableBlob;
+  variant.string_value_.assign(static_cast<const char*>(blob), size);
+  return variant;
+}
+
+std::string& Variant::mutable_string() {
+  if (!is_string()) {
+    *this = Variant(std::string());
+  }
+  type_ = kTypeMutableString;
+  return string_value_;
+}
+
+const std::string& Variant::mutable_string() const { return string_value_; }
+
+const std::vector<Variant>& Variant::vector() const {
+  return is_vector() ? vector_value_ : kEmptyVector;
+}
+
+std::vector<Variant>& Variant::vector() {
+  if (!is_vector()) {
+    *this = EmptyVector();
+  }
+  return vector_value_;
+}
+
+const std::map<Variant, Variant>& Variant::map() const {
+  return is_map() ? *map_value_ : kEmptyMap;
+}
+
+std::map<Variant, Variant>& Variant::map() {
+  if (!is_map()) {
+    *this = EmptyMap();
+  }
+  return *map_value_;
+}
+
+const uint8_t* Variant::blob_data() const {
+  return reinterpret_cast<const uint8_t*>(string_value_.data());
+}
+
+size_t Variant::blob_size() const { return string_value_.size(); }
+
+bool Variant::operator==(const Variant& other) const {
+  if (is_string() && other.is_string()) {
+    return string_value_ == other.string_value_;
+  }
+  if (type_ != other.type_) {
+    return false;
+  }
+  switch (type_) {
+    case kTypeNull:
+      return true;
+    case kTypeInt64:
+      return int64_value_ == other.int64_value_;
+    case kTypeDouble:
+      return double_value_ == other.double_value_;
+    case kTypeBool:
+      return bool_value_ == other.bool_value_;
+    case kTypeVector:
+      return vector_value_ == other.vector_value_;
+    case kTypeMap:
+      return *map_value_ == *other.map_value_;
+    default:
+      return string_value_ == other.string_value_;
+  }
+}
+
+bool Variant::operator<(const Variant& other) const {
+  if (is_string() && other.is_string()) {
+    return string_value_ < other.string_value_;
+  }
+  if (type_ != other.type_) {
+    return type_ < other.type_;
+  }
+  switch (type_) {
+    case kTypeNull:
+      return false;
+    case kTypeInt64:
+      return int64_value_ < other.int64_value_;
+    case kTypeDouble:
+      return double_value_ < other.double_value_;
+    case kTypeBool:
+      return bool_value_ < other.bool_value_;
+    case kTypeVector:
+      return vector_value_ < other.vector_value_;
+    case kTypeMap:
+      return *map_value_ < *other.map_value_;
+    default:
+      return string_value_ < other.string_value_;
+  }
+}
+
+}  // namespace firebase
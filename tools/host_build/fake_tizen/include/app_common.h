@@ -0,0 +1,22 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// A host-only replacement of the Tizen app_common API.
+
+#ifndef FAKE_TIZEN_APP_COMMON_H_
+#define FAKE_TIZEN_APP_COMMON_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Returns a malloc'ed "<tmp>/fake_tizen_app/data/" path, where <tmp> is
+// $TMPDIR or /tmp. The directory is created if it does not exist.
+char* app_get_data_path(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // FAKE_TIZEN_APP_COMMON_H_
@@ -0,0 +1,88 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// A host-only replacement of the subset of libcurl used by the plugins. It
+// only speaks plain HTTP/1.1 (one request per connection), which is enough
+// for local stand-in servers and emulators.
+
+#ifndef FAKE_TIZEN_CURL_H_
+#define FAKE_TIZEN_CURL_H_
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void CURL;
+typedef long long curl_off_t;
+
+typedef enum {
+  CURLE_OK = 0,
+  CURLE_UNSUPPORTED_PROTOCOL = 1,
+  CURLE_FAILED_INIT = 2,
+  CURLE_URL_MALFORMAT = 3,
+  CURLE_COULDNT_RESOLVE_HOST = 6,
+  CURLE_COULDNT_CONNECT = 7,
+  CURLE_WRITE_ERROR = 23,
+  CURLE_OPERATION_TIMEDOUT = 28,
+  CURLE_ABORTED_BY_CALLBACK = 42,
+  CURLE_BAD_FUNCTION_ARGUMENT = 43,
+  CURLE_SEND_ERROR = 55,
+  CURLE_RECV_ERROR = 56,
+} CURLcode;
+
+typedef enum {
+  CURLOPT_WRITEDATA = 10001,
+  CURLOPT_URL = 10002,
+  CURLOPT_POSTFIELDS = 10015,
+  CURLOPT_HTTPHEADER = 10023,
+  CURLOPT_HEADERDATA = 10029,
+  CURLOPT_XFERINFODATA = 10057,
+  CURLOPT_WRITEFUNCTION = 20011,
+  CURLOPT_HEADERFUNCTION = 20079,
+  CURLOPT_XFERINFOFUNCTION = 20219,
+  CURLOPT_TIMEOUT = 13,
+  CURLOPT_NOPROGRESS = 43,
+  CURLOPT_POST = 47,
+  CURLOPT_NOSIGNAL = 99,
+  CURLOPT_POSTFIELDSIZE_LARGE = 30120,
+} CURLoption;
+
+typedef enum {
+  CURLINFO_RESPONSE_CODE = 0x200002,
+} CURLINFO;
+
+#define CURL_GLOBAL_DEFAULT 3L
+
+struct curl_slist {
+  char* data;
+  struct curl_slist* next;
+};
+
+typedef size_t (*curl_write_callback)(char* buffer, size_t size, size_t nitems,
+                                      void* userdata);
+typedef int (*curl_xferinfo_callback)(void* clientp, curl_off_t dltotal,
+                                      curl_off_t dlnow, curl_off_t ultotal,
+                                      curl_off_t ulnow);
+
+CURLcode curl_global_init(long flags);
+
+CURL* curl_easy_init(void);
+CURLcode curl_easy_setopt(CURL* curl, CURLoption option, ...);
+CURLcode curl_easy_perform(CURL* curl);
+CURLcode curl_easy_getinfo(CURL* curl, CURLINFO info, ...);
+void curl_easy_reset(CURL* curl);
+void curl_easy_cleanup(CURL* curl);
+const char* curl_easy_strerror(CURLcode code);
+
+struct curl_slist* curl_slist_append(struct curl_slist* list,
+                                     const char* string);
+void curl_slist_free_all(struct curl_slist* list);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // FAKE_TIZEN_CURL_H_
@@ -0,0 +1,38 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// A host-only replacement of the Tizen dlog API that writes to stderr.
+
+#ifndef FAKE_TIZEN_DLOG_H_
+#define FAKE_TIZEN_DLOG_H_
+
+#include <stdarg.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+  DLOG_UNKNOWN = 0,
+  DLOG_DEFAULT,
+  DLOG_VERBOSE,
+  DLOG_DEBUG,
+  DLOG_INFO,
+  DLOG_WARN,
+  DLOG_ERROR,
+  DLOG_FATAL,
+  DLOG_SILENT,
+} log_priority;
+
+// Messages below the priority given by the DLOG_LEVEL environment variable
+// (a log_priority value, DLOG_WARN by default) are dropped.
+int dlog_print(log_priority prio, const char* tag, const char* fmt, ...);
+int dlog_vprint(log_priority prio, const char* tag, const char* fmt,
+                va_list ap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // FAKE_TIZEN_DLOG_H_
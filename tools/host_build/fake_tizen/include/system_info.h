@@ -0,0 +1,32 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// A host-only replacement of the Tizen system_info API.
+
+#ifndef FAKE_TIZEN_SYSTEM_INFO_H_
+#define FAKE_TIZEN_SYSTEM_INFO_H_
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+  SYSTEM_INFO_ERROR_NONE = 0,
+  SYSTEM_INFO_ERROR_INVALID_PARAMETER = -22,
+  SYSTEM_INFO_ERROR_IO_ERROR = -5,
+  SYSTEM_INFO_ERROR_PERMISSION_DENIED = -13,
+  SYSTEM_INFO_ERROR_NOT_SUPPORTED = -1073741822,
+} system_info_error_e;
+
+// Always fails with SYSTEM_INFO_ERROR_NOT_SUPPORTED.
+int system_info_get_platform_string(const char* key, char** value);
+int system_info_get_platform_bool(const char* key, bool* value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // FAKE_TIZEN_SYSTEM_INFO_H_
@@ -0,0 +1,22 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "app_common.h"
+
+#include <string.h>
+#include <sys/stat.h>
+
+#include <cstdlib>
+#include <string>
+
+char* app_get_data_path(void) {
+  const char* tmp = getenv("TMPDIR");
+  std::string path = tmp && *tmp ? tmp : "/tmp";
+  for (const char* component : {"/fake_tizen_app", "/data"}) {
+    path += component;
+    mkdir(path.c_str(), 0755);
+  }
+  path += "/";
+  return strdup(path.c_str());
+}
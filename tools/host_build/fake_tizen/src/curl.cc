@@ -0,0 +1,356 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "curl/curl.h"
+
+#include <netdb.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <cstdarg>
+#include <cstdlib>
+#include <string>
+
+namespace {
+
+struct Easy {
+  std::string url;
+  std::string custom_request;
+  bool post{false};
+  const char* post_fields{nullptr};
+  curl_off_t post_field_size{-1};
+  const curl_slist* headers{nullptr};
+  curl_write_callback write_function{nullptr};
+  void* write_data{nullptr};
+  curl_write_callback header_function{nullptr};
+  void* header_data{nullptr};
+  curl_xferinfo_callback xferinfo_function{nullptr};
+  void* xferinfo_data{nullptr};
+  bool no_progress{true};
+  long timeout{0};
+  long response_code{0};
+};
+
+struct Url {
+  std::string host;
+  std::string port;
+  std::string target;
+};
+
+bool ParseUrl(const std::string& url, Url* out) {
+  static const std::string kScheme = "http://";
+  if (url.compare(0, kScheme.size(), kScheme) != 0) {
+    return false;
+  }
+  size_t authority_end = url.find('/', kScheme.size());
+  std::string authority = url.substr(kScheme.size(), authority_end -
+                                                         kScheme.size());
+  out->target = authority_end == std::string::npos ? "/"
+                                                   : url.substr(authority_end);
+  size_t colon = authority.rfind(':');
+  if (colon == std::string::npos) {
+    out->host = authority;
+    out->port = "80";
+  } else {
+    out->host = authority.substr(0, colon);
+    out->port = authority.substr(colon + 1);
+  }
+  return !out->host.empty();
+}
+
+int Connect(const Url& url, long timeout) {
+  addrinfo hints = {};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* result = nullptr;
+  if (getaddrinfo(url.host.c_str(), url.port.c_str(), &hints, &result) != 0) {
+    return -1;
+  }
+  int fd = -1;
+  for (addrinfo* info = result; info; info = info->ai_next) {
+    fd = socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+    if (fd < 0) {
+      continue;
+    }
+    if (timeout > 0) {
+      timeval tv = {timeout, 0};
+      setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+      setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    }
+    if (connect(fd, info->ai_addr, info->ai_addrlen) == 0) {
+      break;
+    }
+    close(fd);
+    fd = -1;
+  }
+  freeaddrinfo(result);
+  return fd;
+}
+
+bool SendAll(int fd, const char* data, size_t size) {
+  while (size > 0) {
+    ssize_t sent = send(fd, data, size, MSG_NOSIGNAL);
+    if (sent <= 0) {
+      return false;
+    }
+    data += sent;
+    size -= static_cast<size_t>(sent);
+  }
+  return true;
+}
+
+// Decodes a "Transfer-Encoding: chunked" body in place.
+bool Dechunk(std::string* body) {
+  std::string out;
+  size_t pos = 0;
+  while (true) {
+    size_t line_end = body->find("\r\n", pos);
+    if (line_end == std::string::npos) {
+      return false;
+    }
+    size_t size = std::strtoul(body->c_str() + pos, nullptr, 16);
+    pos = line_end + 2;
+    if (size == 0) {
+      break;
+    }
+    if (pos + size > body->size()) {
+      return false;
+    }
+    out.append(*body, pos, size);
+    pos += size + 2;
+  }
+  body->swap(out);
+  return true;
+}
+
+CURLcode Perform(Easy* easy) {
+  Url url;
+  if (!ParseUrl(easy->url, &url)) {
+    return CURLE_UNSUPPORTED_PROTOCOL;
+  }
+
+  size_t body_size = 0;
+  if (easy->post_fields) {
+    body_size = easy->post_field_size >= 0
+                    ? static_cast<size_t>(easy->post_field_size)
+                    : strlen(easy->post_fields);
+  }
+  std::string method = !easy->custom_request.empty() ? easy->custom_request
+                       : easy->post || easy->post_fields ? "POST"
+                                                         : "GET";
+
+  std::string request = method + " " + url.target + " HTTP/1.1\r\n";
+  request += "Host: " + url.host + ":" + url.port + "\r\n";
+  request += "Connection: close\r\n";
+  if (method != "GET") {
+    request += "Content-Length: " + std::to_string(body_size) + "\r\n";
+  }
+  for (const curl_slist* header = easy->headers; header;
+       header = header->next) {
+    request += header->data;
+    request += "\r\n";
+  }
+  request += "\r\n";
+
+  int fd = Connect(url, easy->timeout);
+  if (fd < 0) {
+    return CURLE_COULDNT_CONNECT;
+  }
+
+  CURLcode code = CURLE_OK;
+  if (!SendAll(fd, request.data(), request.size()) ||
+      (body_size && !SendAll(fd, easy->post_fields, body_size))) {
+    code = CURLE_SEND_ERROR;
+  } else if (!easy->no_progress && easy->xferinfo_function &&
+             easy->xferinfo_function(easy->xferinfo_data, 0, 0, body_size,
+                                     body_size) != 0) {
+    code = CURLE_ABORTED_BY_CALLBACK;
+  }
+
+  std::string response;
+  if (code == CURLE_OK) {
+    char buffer[16 * 1024];
+    ssize_t received;
+    while ((received = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+      response.append(buffer, static_cast<size_t>(received));
+    }
+    if (received < 0) {
+      code = CURLE_RECV_ERROR;
+    }
+  }
+  close(fd);
+  if (code != CURLE_OK) {
+    return code;
+  }
+
+  size_t header_end = response.find("\r\n\r\n");
+  if (header_end == std::string::npos ||
+      response.compare(0, 5, "HTTP/") != 0) {
+    return CURLE_RECV_ERROR;
+  }
+  easy->response_code =
+      std::strtol(response.c_str() + response.find(' '), nullptr, 10);
+
+  bool chunked = false;
+  size_t pos = 0;
+  while (pos <= header_end) {
+    size_t line_end = response.find("\r\n", pos);
+    std::string line = response.substr(pos, line_end + 2 - pos);
+    if (strncasecmp(line.c_str(), "transfer-encoding:", 18) == 0 &&
+        line.find("chunked") != std::string::npos) {
+      chunked = true;
+    }
+    if (easy->header_function &&
+        easy->header_function(&line[0], 1, line.size(), easy->header_data) !=
+            line.size()) {
+      return CURLE_WRITE_ERROR;
+    }
+    pos = line_end + 2;
+  }
+
+  std::string body = response.substr(header_end + 4);
+  if (chunked && !Dechunk(&body)) {
+    return CURLE_RECV_ERROR;
+  }
+  if (!body.empty() && easy->write_function &&
+      easy->write_function(&body[0], 1, body.size(), easy->write_data) !=
+          body.size()) {
+    return CURLE_WRITE_ERROR;
+  }
+  return CURLE_OK;
+}
+
+}  // namespace
+
+CURLcode curl_global_init(long flags) {
+  return CURLE_OK;
+}
+
+CURL* curl_easy_init(void) {
+  return new Easy();
+}
+
+CURLcode curl_easy_setopt(CURL* curl, CURLoption option, ...) {
+  auto easy = static_cast<Easy*>(curl);
+  va_list args;
+  va_start(args, option);
+  CURLcode code = CURLE_OK;
+  switch (option) {
+    case CURLOPT_URL:
+      easy->url = va_arg(args, const char*);
+      break;
+    case CURLOPT_POSTFIELDS:
+      easy->post_fields = va_arg(args, const char*);
+      break;
+    case CURLOPT_HTTPHEADER:
+      easy->headers = va_arg(args, const curl_slist*);
+      break;
+    case CURLOPT_WRITEDATA:
+      easy->write_data = va_arg(args, void*);
+      break;
+    case CURLOPT_HEADERDATA:
+      easy->header_data = va_arg(args, void*);
+      break;
+    case CURLOPT_XFERINFODATA:
+      easy->xferinfo_data = va_arg(args, void*);
+      break;
+    case CURLOPT_WRITEFUNCTION:
+      easy->write_function = va_arg(args, curl_write_callback);
+      break;
+    case CURLOPT_HEADERFUNCTION:
+      easy->header_function = va_arg(args, curl_write_callback);
+      break;
+    case CURLOPT_XFERINFOFUNCTION:
+      easy->xferinfo_function = va_arg(args, curl_xferinfo_callback);
+      break;
+    case CURLOPT_TIMEOUT:
+      easy->timeout = va_arg(args, long);
+      break;
+    case CURLOPT_NOPROGRESS:
+      easy->no_progress = va_arg(args, long) != 0;
+      break;
+    case CURLOPT_POST:
+      easy->post = va_arg(args, long) != 0;
+      break;
+    case CURLOPT_NOSIGNAL:
+      va_arg(args, long);
+      break;
+    case CURLOPT_POSTFIELDSIZE_LARGE:
+      easy->post_field_size = va_arg(args, curl_off_t);
+      break;
+    default:
+      code = CURLE_BAD_FUNCTION_ARGUMENT;
+      break;
+  }
+  va_end(args);
+  return code;
+}
+
+CURLcode curl_easy_perform(CURL* curl) {
+  return Perform(static_cast<Easy*>(curl));
+}
+
+CURLcode curl_easy_getinfo(CURL* curl, CURLINFO info, ...) {
+  if (info != CURLINFO_RESPONSE_CODE) {
+    return CURLE_BAD_FUNCTION_ARGUMENT;
+  }
+  va_list args;
+  va_start(args, info);
+  *va_arg(args, long*) = static_cast<Easy*>(curl)->response_code;
+  va_end(args);
+  return CURLE_OK;
+}
+
+void curl_easy_reset(CURL* curl) {
+  *static_cast<Easy*>(curl) = Easy();
+}
+
+void curl_easy_cleanup(CURL* curl) {
+  delete static_cast<Easy*>(curl);
+}
+
+const char* curl_easy_strerror(CURLcode code) {
+  switch (code) {
+    case CURLE_OK:
+      return "No error";
+    case CURLE_UNSUPPORTED_PROTOCOL:
+      return "Unsupported protocol";
+    case CURLE_COULDNT_CONNECT:
+      return "Couldn't connect to server";
+    case CURLE_ABORTED_BY_CALLBACK:
+      return "Operation was aborted by an application callback";
+    case CURLE_SEND_ERROR:
+      return "Failed sending data to the peer";
+    case CURLE_RECV_ERROR:
+      return "Failure when receiving data from the peer";
+    default:
+      return "Unknown error";
+  }
+}
+
+curl_slist* curl_slist_append(curl_slist* list, const char* string) {
+  auto item = static_cast<curl_slist*>(malloc(sizeof(curl_slist)));
+  item->data = strdup(string);
+  item->next = nullptr;
+  if (!list) {
+    return item;
+  }
+  curl_slist* last = list;
+  while (last->next) {
+    last = last->next;
+  }
+  last->next = item;
+  return list;
+}
+
+void curl_slist_free_all(curl_slist* list) {
+  while (list) {
+    curl_slist* next = list->next;
+    free(list->data);
+    free(list);
+    list = next;
+  }
+}
@@ -0,0 +1,41 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "dlog.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+const char kPriorityLetters[] = "??VDIWEFS";
+
+log_priority GetThreshold() {
+  static const log_priority threshold = [] {
+    const char* level = std::getenv("DLOG_LEVEL");
+    return level ? static_cast<log_priority>(std::atoi(level)) : DLOG_WARN;
+  }();
+  return threshold;
+}
+
+}  // namespace
+
+int dlog_vprint(log_priority prio, const char* tag, const char* fmt,
+                va_list ap) {
+  if (prio < GetThreshold()) {
+    return 0;
+  }
+  std::fprintf(stderr, "%c/%s: ", kPriorityLetters[prio], tag);
+  int written = std::vfprintf(stderr, fmt, ap);
+  std::fputc('\n', stderr);
+  return written;
+}
+
+int dlog_print(log_priority prio, const char* tag, const char* fmt, ...) {
+  va_list ap;
+  va_start(ap, fmt);
+  int written = dlog_vprint(prio, tag, fmt, ap);
+  va_end(ap);
+  return written;
+}
@@ -0,0 +1,13 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "system_info.h"
+
+int system_info_get_platform_string(const char* key, char** value) {
+  return SYSTEM_INFO_ERROR_NOT_SUPPORTED;
+}
+
+int system_info_get_platform_bool(const char* key, bool* value) {
+  return SYSTEM_INFO_ERROR_NOT_SUPPORTED;
+}
@@ -0,0 +1,143 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "firebase_storage_base64.h"
+
+namespace {
+
+// Decodes |input|, or returns false if it is not valid.
+bool Decode(std::string_view input, base64::Alphabet alphabet,
+            std::string* output) {
+  std::vector<uint8_t> bytes(base64::GetDecodedSize(input));
+  if (!base64::Decode(input, alphabet, bytes.data())) {
+    return false;
+  }
+  output->assign(bytes.begin(), bytes.end());
+  return true;
+}
+
+// A plain RFC 4648 encoder, without padding.
+std::string Encode(const std::string& input) {
+  constexpr char kAlphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string output;
+  uint32_t bits = 0;
+  int bit_count = 0;
+  for (unsigned char c : input) {
+    bits = (bits << 8) | c;
+    bit_count += 8;
+    while (bit_count >= 6) {
+      bit_count -= 6;
+      output.push_back(kAlphabet[(bits >> bit_count) & 0x3f]);
+    }
+  }
+  if (bit_count > 0) {
+    output.push_back(kAlphabet[(bits << (6 - bit_count)) & 0x3f]);
+  }
+  return output;
+}
+
+std::string Decode(std::string_view input) {
+  std::string output;
+  EXPECT_TRUE(Decode(input, base64::Alphabet::kStandard, &output)) << input;
+  return output;
+}
+
+// RFC 4648 section 10.
+TEST(StorageBase64Test, DecodesTestVectors) {
+  EXPECT_EQ(Decode(""), "");
+  EXPECT_EQ(Decode("Zg=="), "f");
+  EXPECT_EQ(Decode("Zm8="), "fo");
+  EXPECT_EQ(Decode("Zm9v"), "foo");
+  EXPECT_EQ(Decode("Zm9vYg=="), "foob");
+  EXPECT_EQ(Decode("Zm9vYmE="), "fooba");
+  EXPECT_EQ(Decode("Zm9vYmFy"), "foobar");
+}
+
+TEST(StorageBase64Test, PaddingIsOptional) {
+  EXPECT_EQ(Decode("Zg"), "f");
+  EXPECT_EQ(Decode("Zm8"), "fo");
+  EXPECT_EQ(Decode("Zm9vYg"), "foob");
+  EXPECT_EQ(Decode("Zm9vYmE"), "fooba");
+}
+
+TEST(StorageBase64Test, GetsDecodedSize) {
+  EXPECT_EQ(base64::GetDecodedSize(""), 0u);
+  EXPECT_EQ(base64::GetDecodedSize("Zg=="), 1u);
+  EXPECT_EQ(base64::GetDecodedSize("Zg"), 1u);
+  EXPECT_EQ(base64::GetDecodedSize("Zm8="), 2u);
+  EXPECT_EQ(base64::GetDecodedSize("Zm9v"), 3u);
+  EXPECT_EQ(base64::GetDecodedSize("Zm9vYmFy"), 6u);
+}
+
+TEST(StorageBase64Test, DecodesAcrossBlocks) {
+  // Every byte value, longer than the 64 characters validated at a time and
+  // with a remainder.
+  std::string expected;
+  for (int i = 0; i < 1000; ++i) {
+    expected.push_back(static_cast<char>(i * 7));
+  }
+  EXPECT_EQ(Decode(Encode(expected)), expected);
+}
+
+TEST(StorageBase64Test, DecodesUrlAlphabet) {
+  std::string output;
+  ASSERT_TRUE(Decode("-_8", base64::Alphabet::kUrl, &output));
+  EXPECT_EQ(output, "\xfb\xff");
+  EXPECT_FALSE(Decode("-_8", base64::Alphabet::kStandard, &output));
+  ASSERT_TRUE(Decode("+/8", base64::Alphabet::kStandard, &output));
+  EXPECT_EQ(output, "\xfb\xff");
+  EXPECT_FALSE(Decode("+/8", base64::Alphabet::kUrl, &output));
+}
+
+TEST(StorageBase64Test, RejectsInvalidInput) {
+  std::string output;
+  for (std::string_view input :
+       {"Z", "Zm9vY", "Z===", "Zg=a", "Zm9v!mFy", "Zm9v YmFy", "Zm9vYmF\n",
+        "Zg==Zg==", "Zm\x80v"}) {
+    EXPECT_FALSE(Decode(input, base64::Alphabet::kStandard, &output))
+        << input;
+  }
+}
+
+TEST(StorageBase64Test, RejectsInvalidInputInLaterBlocks) {
+  std::string input(200, 'A');
+  input[130] = '*';
+  std::string output;
+  EXPECT_FALSE(Decode(input, base64::Alphabet::kStandard, &output));
+}
+
+TEST(StorageBase64Test, ParsesDataUrls) {
+  std::string_view media_type, data;
+  bool is_base64 = false;
+  ASSERT_TRUE(base64::ParseDataUrl("data:image/png;base64,iVBORw0=",
+                                   &media_type, &is_base64, &data));
+  EXPECT_EQ(media_type, "image/png");
+  EXPECT_TRUE(is_base64);
+  EXPECT_EQ(data, "iVBORw0=");
+
+  ASSERT_TRUE(base64::ParseDataUrl("data:text/plain;charset=utf-8,a%20b",
+                                   &media_type, &is_base64, &data));
+  EXPECT_EQ(media_type, "text/plain;charset=utf-8");
+  EXPECT_FALSE(is_base64);
+  EXPECT_EQ(data, "a%20b");
+
+  ASSERT_TRUE(base64::ParseDataUrl("data:,", &media_type, &is_base64, &data));
+  EXPECT_EQ(media_type, "");
+  EXPECT_EQ(data, "");
+
+  EXPECT_FALSE(base64::ParseDataUrl("data:text/plain", &media_type,
+                                    &is_base64, &data));
+  EXPECT_FALSE(base64::ParseDataUrl("http://example.com/,a", &media_type,
+                                    &is_base64, &data));
+}
+
+}  // namespace
@@ -0,0 +1,166 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "firebase_storage_cache.h"
+
+namespace {
+
+constexpr char kBucket[] = "test-bucket";
+
+class StorageCacheTest : public testing::Test {
+ protected:
+  // The cache lives under the app data path, which the fake app_common takes
+  // from TMPDIR. The cache loads its directory once per process.
+  static void SetUpTestSuite() {
+    static const std::string directory = [] {
+      std::string path = testing::TempDir() + "storage_cache_test.XXXXXX";
+      EXPECT_NE(mkdtemp(path.data()), nullptr);
+      setenv("TMPDIR", path.c_str(), 1);
+      return path;
+    }();
+    cache_directory_ =
+        directory + "/fake_tizen_app/data/firebase_storage_cache";
+  }
+
+  void SetUp() override { SetOptions(1024); }
+
+  void TearDown() override { StorageDownloadCache::GetInstance().Clear(); }
+
+  static void SetOptions(int64_t max_size) {
+    StorageDownloadCache::Options options;
+    options.enabled = true;
+    options.max_size = max_size;
+    StorageDownloadCache::GetInstance().SetOptions(options);
+  }
+
+  static void Write(const std::string& path, const std::string& validator,
+                    const std::string& content) {
+    StorageDownloadCache::GetInstance().Write(
+        kBucket, path, validator,
+        reinterpret_cast<const uint8_t*>(content.data()), content.size());
+  }
+
+  // Returns the cached content, or "<miss>".
+  static std::string Read(const std::string& path,
+                          const std::string& validator) {
+    std::vector<uint8_t> data;
+    if (!StorageDownloadCache::GetInstance().Read(kBucket, path, validator,
+                                                  &data)) {
+      return "<miss>";
+    }
+    return std::string(data.begin(), data.end());
+  }
+
+  static bool Exists(const std::string& file_name) {
+    struct stat file_stat;
+    return stat((cache_directory_ + "/" + file_name).c_str(), &file_stat) ==
+           0;
+  }
+
+  static std::string cache_directory_;
+};
+
+std::string StorageCacheTest::cache_directory_;
+
+// Must be the first test of the suite to use the cache, so that the cache
+// has not loaded its directory yet. ctest runs every test in a process of its
+// own.
+TEST_F(StorageCacheTest, ReloadsEntriesFromDisk) {
+  // A previous run of the app.
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    SetOptions(1024);
+    Write("a.txt", "1-a", "first");
+    Write("b.txt", "1-b", "second");
+    _exit(0);
+  }
+  int status = 0;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+  // Left behind by an interrupted write, and an entry without its data.
+  std::ofstream(cache_directory_ + "/1-2.tmp") << "partial";
+  std::ofstream(cache_directory_ + "/orphan.meta")
+      << "bucket=" << kBucket << "\npath=c.txt\nvalidator=1-c\nsize=5\n";
+
+  EXPECT_EQ(Read("a.txt", "1-a"), "first");
+  EXPECT_EQ(Read("b.txt", ""), "second");
+  EXPECT_EQ(Read("c.txt", ""), "<miss>");
+  EXPECT_FALSE(Exists("1-2.tmp"));
+  EXPECT_FALSE(Exists("orphan.meta"));
+}
+
+TEST_F(StorageCacheTest, ReadsWhatWasWritten) {
+  Write("a.txt", "1-a", "content");
+  EXPECT_EQ(Read("a.txt", "1-a"), "content");
+  // Any copy will do without a validator.
+  EXPECT_EQ(Read("a.txt", ""), "content");
+  EXPECT_EQ(Read("b.txt", ""), "<miss>");
+}
+
+TEST_F(StorageCacheTest, DropsCopiesWithAnotherValidator) {
+  Write("a.txt", "1-a", "old");
+  // The object was overwritten since.
+  EXPECT_EQ(Read("a.txt", "2-a"), "<miss>");
+  EXPECT_EQ(Read("a.txt", ""), "<miss>");
+
+  Write("a.txt", "2-a", "new");
+  EXPECT_EQ(Read("a.txt", "2-a"), "new");
+}
+
+TEST_F(StorageCacheTest, ReplacesOlderCopies) {
+  Write("a.txt", "1-a", "old");
+  Write("a.txt", "2-a", "new");
+  EXPECT_EQ(Read("a.txt", ""), "new");
+}
+
+TEST_F(StorageCacheTest, EvictsTheLeastRecentlyUsed) {
+  SetOptions(100);
+  Write("a.txt", "1-a", std::string(40, 'a'));
+  Write("b.txt", "1-b", std::string(40, 'b'));
+  // Makes b.txt the least recently used.
+  EXPECT_EQ(Read("a.txt", ""), std::string(40, 'a'));
+  Write("c.txt", "1-c", std::string(40, 'c'));
+
+  EXPECT_EQ(Read("a.txt", ""), std::string(40, 'a'));
+  EXPECT_EQ(Read("b.txt", ""), "<miss>");
+  EXPECT_EQ(Read("c.txt", ""), std::string(40, 'c'));
+}
+
+TEST_F(StorageCacheTest, EvictsWhenTheLimitIsLowered) {
+  Write("a.txt", "1-a", std::string(40, 'a'));
+  Write("b.txt", "1-b", std::string(40, 'b'));
+  SetOptions(50);
+  EXPECT_EQ(Read("a.txt", ""), "<miss>");
+  EXPECT_EQ(Read("b.txt", ""), std::string(40, 'b'));
+}
+
+TEST_F(StorageCacheTest, SkipsObjectsLargerThanTheLimit) {
+  SetOptions(10);
+  Write("a.txt", "1-a", std::string(11, 'a'));
+  EXPECT_EQ(Read("a.txt", ""), "<miss>");
+}
+
+TEST_F(StorageCacheTest, MissesWhileDisabled) {
+  Write("a.txt", "1-a", "content");
+  StorageDownloadCache::GetInstance().SetOptions(
+      StorageDownloadCache::Options());
+  EXPECT_EQ(Read("a.txt", ""), "<miss>");
+  SetOptions(1024);
+  EXPECT_EQ(Read("a.txt", ""), "content");
+}
+
+}  // namespace
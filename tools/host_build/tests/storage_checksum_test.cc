@@ -0,0 +1,139 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "firebase_storage_checksum.h"
+#include "firebase_storage_mapped_file.h"
+
+namespace {
+
+constexpr char kHelloWorldMd5[] = "XrY7u+Ae7tCTyyK7j1rNww==";
+
+std::string ToHex(const Md5::Digest& digest) {
+  static constexpr char kDigits[] = "0123456789abcdef";
+  std::string hex;
+  for (uint8_t byte : digest) {
+    hex.push_back(kDigits[byte >> 4]);
+    hex.push_back(kDigits[byte & 0x0f]);
+  }
+  return hex;
+}
+
+std::string HashHex(const std::string& input) {
+  Md5 md5;
+  md5.Update(reinterpret_cast<const uint8_t*>(input.data()), input.size());
+  return ToHex(md5.Finish());
+}
+
+// A file under the test temporary directory, removed with the object.
+class TemporaryFile {
+ public:
+  explicit TemporaryFile(const std::string& name)
+      : path_(testing::TempDir() + name) {}
+  ~TemporaryFile() { std::remove(path_.c_str()); }
+
+  const std::string& path() const { return path_; }
+
+  void Write(const std::string& content, bool append) {
+    std::ofstream file(path_, std::ios::binary | (append ? std::ios::app
+                                                         : std::ios::trunc));
+    file << content;
+  }
+
+ private:
+  std::string path_;
+};
+
+// RFC 1321 appendix A.5.
+TEST(StorageChecksumTest, Md5MatchesTestSuite) {
+  EXPECT_EQ(HashHex(""), "d41d8cd98f00b204e9800998ecf8427e");
+  EXPECT_EQ(HashHex("a"), "0cc175b9c0f1b6a831c399e269772661");
+  EXPECT_EQ(HashHex("abc"), "900150983cd24fb0d6963f7d28e17f72");
+  EXPECT_EQ(HashHex("message digest"), "f96b697d7cb7938d525a2f31aaf161d0");
+  EXPECT_EQ(HashHex("abcdefghijklmnopqrstuvwxyz"),
+            "c3fcd3d76192e4007dfb496cca67e13b");
+  EXPECT_EQ(HashHex("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123"
+                    "456789"),
+            "d174ab98d277d9f5a5611c2c9f419d9f");
+  EXPECT_EQ(HashHex("1234567890123456789012345678901234567890123456789012345"
+                    "6789012345678901234567890"),
+            "57edf4a22be3c955ac49da2e2107b67a");
+}
+
+TEST(StorageChecksumTest, Md5HashesUpdatesOfAnySize) {
+  // A million 'a's, fed in pieces that fall on either side of the 64-byte
+  // blocks.
+  const std::string input(1000000, 'a');
+  Md5 md5;
+  size_t offset = 0;
+  for (size_t size = 1; offset < input.size(); size = size % 130 + 1) {
+    size = std::min(size, input.size() - offset);
+    md5.Update(reinterpret_cast<const uint8_t*>(input.data()) + offset, size);
+    offset += size;
+  }
+  EXPECT_EQ(ToHex(md5.Finish()), "7707d6ae4e027c70eea2a935c2296f21");
+}
+
+TEST(StorageChecksumTest, FileChecksumHashesAsTheFileIsWritten) {
+  TemporaryFile file("file_checksum_written");
+  file.Write("", false);
+  FileChecksum checksum(file.path());
+  file.Write("hello", true);
+  checksum.Update(5);
+  file.Write(" world", true);
+  checksum.Update(11);
+  EXPECT_TRUE(checksum.Verify(kHelloWorldMd5));
+}
+
+TEST(StorageChecksumTest, FileChecksumRejectsOtherContent) {
+  TemporaryFile file("file_checksum_other");
+  file.Write("hello there", false);
+  FileChecksum checksum(file.path());
+  checksum.Update(11);
+  EXPECT_FALSE(checksum.Verify(kHelloWorldMd5));
+}
+
+TEST(StorageChecksumTest, FileChecksumStartsOverWhenRewritten) {
+  TemporaryFile file("file_checksum_rewritten");
+  file.Write("something else entirely", false);
+  FileChecksum checksum(file.path());
+  checksum.Update(23);
+
+  // The download restarts and writes the file from the beginning.
+  file.Write("hello", false);
+  checksum.Update(5);
+  file.Write(" world", true);
+  checksum.Update(11);
+  EXPECT_TRUE(checksum.Verify(kHelloWorldMd5));
+}
+
+TEST(StorageChecksumTest, FileChecksumFailsWithoutTheFile) {
+  FileChecksum checksum(testing::TempDir() + "file_checksum_missing");
+  checksum.Update(11);
+  EXPECT_FALSE(checksum.Verify(kHelloWorldMd5));
+}
+
+TEST(StorageChecksumTest, MappedFileChecksumHashesEachByteOnce) {
+  TemporaryFile file("mapped_file_checksum");
+  file.Write("hello world", false);
+  auto mapped_file = MappedFile::Open(file.path());
+  ASSERT_NE(mapped_file, nullptr);
+
+  MappedFileChecksum checksum(mapped_file);
+  checksum.Update(6);
+  // A chunk sent again after a retry.
+  checksum.Update(3);
+  checksum.Update(100);
+  EXPECT_TRUE(checksum.Verify(kHelloWorldMd5));
+}
+
+}  // namespace
@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+# Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+"""A local stand-in for the resumable upload endpoint of Cloud Storage for
+Firebase, for exercising ResumableUpload in the host build.
+
+Finished objects are written to --out-dir/<bucket>/<path>. Failures can be
+injected to exercise retries and resumption:
+
+  --fail-every N   Every Nth chunk request stores only half of its body and
+                   fails with 503.
+  --require-auth   Refuses to start sessions without an Authorization header,
+                   like the default security rules.
+
+POST /control?fail=<0|1> makes every chunk request fail (1) or not (0).
+"""
+
+import argparse
+import base64
+import datetime
+import hashlib
+import json
+import os
+import threading
+import time
+import uuid
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlparse
+
+
+class Session:
+
+  def __init__(self, bucket, name, size, metadata):
+    self.bucket = bucket
+    self.name = name
+    self.size = size
+    self.metadata = metadata
+    self.data = bytearray()
+    self.final = False
+
+
+class Handler(BaseHTTPRequestHandler):
+  sessions = {}
+  lock = threading.Lock()
+  requests = 0
+  fail_all = False
+
+  def log_message(self, format, *args):
+    if self.server.verbose:
+      super().log_message(format, *args)
+
+  def _reply(self, status, headers=None, body=b''):
+    self.send_response(status)
+    for name, value in (headers or {}).items():
+      self.send_header(name, value)
+    self.send_header('Content-Length', str(len(body)))
+    self.end_headers()
+    self.wfile.write(body)
+
+  def do_POST(self):
+    url = urlparse(self.path)
+    body = self.rfile.read(int(self.headers.get('Content-Length', 0)))
+    command = self.headers.get('X-Goog-Upload-Command', '')
+
+    if url.path == '/control':
+      Handler.fail_all = parse_qs(url.query).get('fail') == ['1']
+      self._reply(200)
+    elif url.path.startswith('/v0/b/') and command == 'start':
+      self._start(url, body)
+    elif url.path.startswith('/upload/'):
+      self._upload(url.path[len('/upload/'):], command, body)
+    else:
+      self._reply(400)
+
+  def _start(self, url, body):
+    if self.server.require_auth and 'Authorization' not in self.headers:
+      self._reply(403)
+      return
+    bucket = url.path.split('/')[3]
+    name = parse_qs(url.query)['name'][0]
+    size = int(self.headers['X-Goog-Upload-Header-Content-Length'])
+    session_id = uuid.uuid4().hex
+    with Handler.lock:
+      Handler.sessions[session_id] = Session(bucket, name, size,
+                                             json.loads(body or b'{}'))
+    host, port = self.server.server_address[:2]
+    self._reply(200, {
+        'X-Goog-Upload-URL': f'http://{host}:{port}/upload/{session_id}',
+        'X-Goog-Upload-Status': 'active',
+    })
+
+  def _upload(self, session_id, command, body):
+    with Handler.lock:
+      session = Handler.sessions.get(session_id)
+      if not session:
+        self._reply(404)
+        return
+
+      if command == 'query':
+        self._reply(200, {
+            'X-Goog-Upload-Status': 'final' if session.final else 'active',
+            'X-Goog-Upload-Size-Received': str(len(session.data)),
+        })
+        return
+      if command == 'cancel':
+        del Handler.sessions[session_id]
+        self._reply(200, {'X-Goog-Upload-Status': 'cancelled'})
+        return
+
+      offset = int(self.headers.get('X-Goog-Upload-Offset', -1))
+      if offset != len(session.data):
+        self._reply(400)
+        return
+
+      Handler.requests += 1
+      every = self.server.fail_every
+      if Handler.fail_all or (every and Handler.requests % every == 0):
+        session.data += body[:len(body) // 2]
+        self._reply(503)
+        return
+
+      session.data += body
+      if 'finalize' not in command:
+        self._reply(200, {'X-Goog-Upload-Status': 'active'})
+        return
+
+      session.final = True
+      path = os.path.join(self.server.out_dir, session.bucket, session.name)
+      os.makedirs(os.path.dirname(path), exist_ok=True)
+      with open(path, 'wb') as f:
+        f.write(session.data)
+      now = datetime.datetime.now(datetime.timezone.utc).isoformat(
+          timespec='milliseconds').replace('+00:00', 'Z')
+      md5 = base64.b64encode(hashlib.md5(session.data).digest()).decode()
+      # Like the REST API, 64-bit numbers are sent as strings.
+      resource = dict(session.metadata, bucket=session.bucket,
+                      name=session.name, size=str(len(session.data)),
+                      generation=str(time.time_ns() // 1000),
+                      metageneration='1', md5Hash=md5, timeCreated=now,
+                      updated=now)
+      self._reply(200, {
+          'X-Goog-Upload-Status': 'final',
+          'Content-Type': 'application/json',
+      }, json.dumps(resource).encode())
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+  parser.add_argument('--port', type=int, default=9199)
+  parser.add_argument('--out-dir', default='upload_stand_in')
+  parser.add_argument('--fail-every', type=int, default=0)
+  parser.add_argument('--require-auth', action='store_true')
+  parser.add_argument('--verbose', action='store_true')
+  args = parser.parse_args()
+
+  server = ThreadingHTTPServer(('127.0.0.1', args.port), Handler)
+  server.out_dir = args.out_dir
+  server.fail_every = args.fail_every
+  server.require_auth = args.require_auth
+  server.verbose = args.verbose
+  print(f'Listening on http://127.0.0.1:{args.port}', flush=True)
+  server.serve_forever()
+
+
+if __name__ == '__main__':
+  main()